@@ -32,14 +32,25 @@ extern "C" {
 #include <gdl90.h>
 }
 
-#define GDL90_RINGBUF_SIZE  sizeof(gdl_message_escaped_t)
+/*
+ * Frame buffer holds unescaped message ID, payload and FCS.
+ * Leading flag byte is kept in place so that gdl90 decoders
+ * can be fed with the buffer as is.
+ */
+#define GDL90_FRAME_SIZE    (1 /* id */ + sizeof(message.data))
+
+enum
+{
+  GDL90_PARSE_HUNT,   /* waiting for a flag byte */
+  GDL90_PARSE_FRAME,
+  GDL90_PARSE_ESCAPE
+};
 
 static unsigned long GDL90_Data_TimeMarker = 0;
 static unsigned long GDL90_HeartBeat_TimeMarker = 0;
 static unsigned long GDL90_OwnShip_TimeMarker = 0;
-static unsigned char gdl90_ringbuf[GDL90_RINGBUF_SIZE];
-static unsigned int gdl90buf_head = 0;
-static unsigned char prev_c = 0;
+static uint8_t  gdl90_parse_state = GDL90_PARSE_HUNT;
+static uint16_t gdl90_frame_len = 0;
 
 gdl_message_t message;
 
@@ -67,143 +78,161 @@ const uint8_t gdl90_to_aircraft_type[] PROGMEM = {
 	AIRCRAFT_TYPE_RESERVED
 };
 
-static void GDL90_Parse_Character(char c)
+static void GDL90_Parse_Message()
 {
-    unsigned int gdl90buf_tail;
-    size_t msg_size;
+    size_t payload_size = gdl90_frame_len - 1 /* id */ - 2 /* FCS */;
+    uint16_t fcs = (message.data[payload_size + 1] << 8) | message.data[payload_size];
 
-    if (c == GDL90_CONTROL_ESCAPE) {
-      prev_c = c;
+    if (gdl90_crcCompute(&message.messageId, payload_size + 1) != fcs) {
       return;
-    } else if (prev_c == GDL90_CONTROL_ESCAPE) {
-      prev_c = c;
-      c ^= GDL90_ESCAPE_BYTE;
-    } else {
-      prev_c = c;
     }
 
-    gdl90_ringbuf[gdl90buf_head % GDL90_RINGBUF_SIZE] = c;
-    gdl90buf_head++;
-
-    msg_size = 1 /* flag */ + 1 /* id */ + GDL90_MSG_LEN_HEARTBEAT + 2 /* FC */ + 1 /* flag */;
-    gdl90buf_tail = gdl90buf_head - msg_size;
-    if (c == GDL90_FLAG_BYTE && 
-        gdl90_ringbuf[ gdl90buf_tail    % GDL90_RINGBUF_SIZE] == GDL90_FLAG_BYTE &&
-        gdl90_ringbuf[(gdl90buf_tail+1) % GDL90_RINGBUF_SIZE] == MSG_ID_HEARTBEAT) {
-
-      unsigned char *buf = (unsigned char *) &message;
-      for (uint8_t i=0; i < msg_size; i++) {
-          buf[i] = gdl90_ringbuf[(gdl90buf_tail + i) % GDL90_RINGBUF_SIZE];
+    switch (message.messageId)
+    {
+    case MSG_ID_HEARTBEAT:
+      if (payload_size != GDL90_MSG_LEN_HEARTBEAT) {
+        break;
       }
 
-      if (decode_gdl90_heartbeat(&message, &heartbeat)) {
-
-//      print_gdl90_heartbeat(&heartbeat);
-
-        GDL90_HeartBeat_TimeMarker = millis();
-      }
-    }
+      decode_gdl90_heartbeat(&message, &heartbeat);
+//    print_gdl90_heartbeat(&heartbeat);
 
-    msg_size = 1 /* flag */ + 1 /* id */ + GDL90_MSG_LEN_OWNSHIP_GEOMETRIC + 2 /* FC */ + 1 /* flag */;
-    gdl90buf_tail = gdl90buf_head - msg_size;
-    if (c == GDL90_FLAG_BYTE && 
-        gdl90_ringbuf[ gdl90buf_tail    % GDL90_RINGBUF_SIZE] == GDL90_FLAG_BYTE &&
-        gdl90_ringbuf[(gdl90buf_tail+1) % GDL90_RINGBUF_SIZE] == MSG_ID_OWNSHIP_GEOMETRIC) {
+      GDL90_HeartBeat_TimeMarker = millis();
+      break;
 
-      unsigned char *buf = (unsigned char *) &message;
-      for (uint8_t i=0; i < msg_size; i++) {
-          buf[i] = gdl90_ringbuf[(gdl90buf_tail + i) % GDL90_RINGBUF_SIZE];
+    case MSG_ID_OWNSHIP_GEOMETRIC:
+      if (payload_size != GDL90_MSG_LEN_OWNSHIP_GEOMETRIC) {
+        break;
       }
 
       decode_gdl90_ownship_geo_altitude(&message, &geo_altitude);
 //    print_gdl90_ownship_geo_altitude(&geo_altitude);
-    }
-
-    msg_size = 1 /* flag */ + 1 /* id */ + GDL90_MSG_LEN_TRAFFIC_REPORT + 2 /* FC */ + 1 /* flag */;
-    gdl90buf_tail = gdl90buf_head - msg_size;
-    if (c == GDL90_FLAG_BYTE && 
-        gdl90_ringbuf[ gdl90buf_tail    % GDL90_RINGBUF_SIZE] == GDL90_FLAG_BYTE &&
-        gdl90_ringbuf[(gdl90buf_tail+1) % GDL90_RINGBUF_SIZE] == MSG_ID_TRAFFIC_REPORT) {
+      break;
 
-      unsigned char *buf = (unsigned char *) &message;
-      for (uint8_t i=0; i < msg_size; i++) {
-          buf[i] = gdl90_ringbuf[(gdl90buf_tail + i) % GDL90_RINGBUF_SIZE];
+    case MSG_ID_TRAFFIC_REPORT:
+      if (payload_size != GDL90_MSG_LEN_TRAFFIC_REPORT) {
+        break;
       }
 
-      if (decode_gdl90_traffic_report(&message, &gdl_traffic)) {
+      decode_gdl90_traffic_report(&message, &gdl_traffic);
+//    print_gdl90_traffic_report(&gdl_traffic);
 
-//      print_gdl90_traffic_report(&gdl_traffic);
+      fo = EmptyFO;
 
-        fo = EmptyFO;
+      fo.ID          = gdl_traffic.address;
+      fo.IDType      = gdl_traffic.addressType == ADS_B_WITH_ICAO_ADDRESS ?
+                                        ADDR_TYPE_ICAO : ADDR_TYPE_ANONYMOUS;
 
-        fo.ID          = gdl_traffic.address;
-        fo.IDType      = gdl_traffic.addressType == ADS_B_WITH_ICAO_ADDRESS ?
-                                          ADDR_TYPE_ICAO : ADDR_TYPE_ANONYMOUS;
+      fo.latitude    = gdl_traffic.latitude;
+      fo.longitude   = gdl_traffic.longitude;
+      fo.altitude    = gdl_traffic.altitude  / _GPS_FEET_PER_METER;
 
-        fo.latitude    = gdl_traffic.latitude;
-        fo.longitude   = gdl_traffic.longitude;
-        fo.altitude    = gdl_traffic.altitude  / _GPS_FEET_PER_METER;
+      fo.AlarmLevel  = gdl_traffic.trafficAlertStatus == TRAFFIC_ALERT ?
+                                          ALARM_LEVEL_LOW : ALARM_LEVEL_NONE;
+      fo.Track       = gdl_traffic.trackOrHeading;           // degrees
+      fo.ClimbRate   = gdl_traffic.verticalVelocity/ (_GPS_FEET_PER_METER * 60.0);
+      fo.TurnRate    = 0;
+      fo.GroundSpeed = gdl_traffic.horizontalVelocity * _GPS_MPS_PER_KNOT;
+      fo.AcftType    = GDL90_TO_AT(gdl_traffic.emitterCategory);
 
-        fo.AlarmLevel  = gdl_traffic.trafficAlertStatus == TRAFFIC_ALERT ?
-                                            ALARM_LEVEL_LOW : ALARM_LEVEL_NONE;
-        fo.Track       = gdl_traffic.trackOrHeading;           // degrees
-        fo.ClimbRate   = gdl_traffic.verticalVelocity/ (_GPS_FEET_PER_METER * 60.0);
-        fo.TurnRate    = 0;
-        fo.GroundSpeed = gdl_traffic.horizontalVelocity * _GPS_MPS_PER_KNOT;
-        fo.AcftType    = GDL90_TO_AT(gdl_traffic.emitterCategory);
+      memcpy(fo.callsign, gdl_traffic.callsign, sizeof(fo.callsign));
 
-        memcpy(fo.callsign, gdl_traffic.callsign, sizeof(fo.callsign));
+      fo.timestamp   = now();
 
-        fo.timestamp   = now();
+      Traffic_Update(&fo);
+      Traffic_Add();
+      break;
 
-        Traffic_Update(&fo);
-        Traffic_Add();
+    case MSG_ID_OWNSHIP_REPORT:
+      if (payload_size != GDL90_MSG_LEN_OWNSHIP_REPORT) {
+        break;
       }
-    }
 
-    msg_size = 1 /* flag */ + 1 /* id */ + GDL90_MSG_LEN_OWNSHIP_REPORT + 2 /* FC */ + 1 /* flag */;
-    gdl90buf_tail = gdl90buf_head - msg_size;
-    if (c == GDL90_FLAG_BYTE && 
-        gdl90_ringbuf[ gdl90buf_tail    % GDL90_RINGBUF_SIZE] == GDL90_FLAG_BYTE &&
-        gdl90_ringbuf[(gdl90buf_tail+1) % GDL90_RINGBUF_SIZE] == MSG_ID_OWNSHIP_REPORT) {
+      decode_gdl90_traffic_report(&message, &ownship);
+//    print_gdl90_traffic_report(&ownship);
+
+      ThisAircraft.ID          = ownship.address;
+      ThisAircraft.IDType      = ownship.addressType == ADS_B_WITH_ICAO_ADDRESS ?
+                                        ADDR_TYPE_ICAO : ADDR_TYPE_ANONYMOUS;
 
-      unsigned char *buf = (unsigned char *) &message;
-      for (uint8_t i=0; i < msg_size; i++) {
-          buf[i] = gdl90_ringbuf[(gdl90buf_tail + i) % GDL90_RINGBUF_SIZE];
+      ThisAircraft.latitude    = ownship.latitude;
+      ThisAircraft.longitude   = ownship.longitude;
+
+      if (ownship.altitude != 101375 /* 0xFFF */ ) {
+        ThisAircraft.altitude  = ownship.altitude / _GPS_FEET_PER_METER;
+      } else if (geo_altitude.ownshipGeoAltitude != 0) {
+        ThisAircraft.altitude  = geo_altitude.ownshipGeoAltitude / _GPS_FEET_PER_METER;
       }
 
-      if (decode_gdl90_traffic_report(&message, &ownship)) {
+      ThisAircraft.AlarmLevel  = ownship.trafficAlertStatus == TRAFFIC_ALERT ?
+                                          ALARM_LEVEL_LOW : ALARM_LEVEL_NONE;
+      ThisAircraft.Track       = ownship.trackOrHeading;           // degrees
+      ThisAircraft.ClimbRate   = ownship.verticalVelocity/ (_GPS_FEET_PER_METER * 60.0);
+      ThisAircraft.TurnRate    = 0;
+      ThisAircraft.GroundSpeed = ownship.horizontalVelocity * _GPS_MPS_PER_KNOT;
+      ThisAircraft.AcftType    = GDL90_TO_AT(ownship.emitterCategory);
 
-//      print_gdl90_traffic_report(&ownship);
+      memcpy(ThisAircraft.callsign, ownship.callsign, sizeof(ThisAircraft.callsign));
 
-        ThisAircraft.ID          = ownship.address;
-        ThisAircraft.IDType      = ownship.addressType == ADS_B_WITH_ICAO_ADDRESS ?
-                                          ADDR_TYPE_ICAO : ADDR_TYPE_ANONYMOUS;
+      ThisAircraft.timestamp   = now();
 
-        ThisAircraft.latitude    = ownship.latitude;
-        ThisAircraft.longitude   = ownship.longitude;
+      GDL90_OwnShip_TimeMarker = millis();
+      break;
 
-        if (ownship.altitude != 101375 /* 0xFFF */ ) {
-          ThisAircraft.altitude  = ownship.altitude / _GPS_FEET_PER_METER;
-        } else if (geo_altitude.ownshipGeoAltitude != 0) {
-          ThisAircraft.altitude  = geo_altitude.ownshipGeoAltitude / _GPS_FEET_PER_METER;
-        }
+    case MSG_ID_UPLINK_DATA:
+      /* FIS-B products are not rendered yet */
+      break;
 
-        ThisAircraft.AlarmLevel  = ownship.trafficAlertStatus == TRAFFIC_ALERT ?
-                                            ALARM_LEVEL_LOW : ALARM_LEVEL_NONE;
-        ThisAircraft.Track       = ownship.trackOrHeading;           // degrees
-        ThisAircraft.ClimbRate   = ownship.verticalVelocity/ (_GPS_FEET_PER_METER * 60.0);
-        ThisAircraft.TurnRate    = 0;
-        ThisAircraft.GroundSpeed = ownship.horizontalVelocity * _GPS_MPS_PER_KNOT;
-        ThisAircraft.AcftType    = GDL90_TO_AT(ownship.emitterCategory);
+    default:
+      break;
+    }
+}
 
-        memcpy(ThisAircraft.callsign, ownship.callsign, sizeof(ThisAircraft.callsign));
+/*
+ * One pass deframer: bytes between two flags are unescaped
+ * straight into the message buffer, FCS is checked once
+ * per frame on the closing flag.
+ */
+static void GDL90_Parse_Character(char c)
+{
+    uint8_t b = (uint8_t) c;
 
-        ThisAircraft.timestamp   = now();
+    if (b == GDL90_FLAG_BYTE) {
+      /* closing flag of a frame is also an opening flag of the next one */
+      if (gdl90_parse_state == GDL90_PARSE_FRAME &&
+          gdl90_frame_len >= 1 /* id */ + 2 /* FCS */) {
+        GDL90_Parse_Message();
+      }
+      message.flag0      = GDL90_FLAG_BYTE;
+      gdl90_frame_len    = 0;
+      gdl90_parse_state  = GDL90_PARSE_FRAME;
+      return;
+    }
 
-        GDL90_OwnShip_TimeMarker = millis();
+    switch (gdl90_parse_state)
+    {
+    case GDL90_PARSE_FRAME:
+      if (b == GDL90_CONTROL_ESCAPE) {
+        gdl90_parse_state = GDL90_PARSE_ESCAPE;
+        return;
       }
+      break;
+    case GDL90_PARSE_ESCAPE:
+      b ^= GDL90_ESCAPE_BYTE;
+      gdl90_parse_state = GDL90_PARSE_FRAME;
+      break;
+    case GDL90_PARSE_HUNT:
+    default:
+      return;
     }
+
+    if (gdl90_frame_len >= GDL90_FRAME_SIZE) {
+      /* runaway frame - drop it and wait for a next flag */
+      gdl90_parse_state = GDL90_PARSE_HUNT;
+      return;
+    }
+
+    (&message.messageId)[gdl90_frame_len++] = b;
 }
 
 void GDL90_setup()
@@ -32,6 +32,118 @@ traffic_by_dist_t traffic[MAX_TRACKING_OBJECTS];
 static unsigned long UpdateTrafficTimeMarker = 0;
 static unsigned long Traffic_Voice_TimeMarker = 0;
 
+/*
+ * Container[] slots that still await a voice alert, kept as a binary
+ * min-heap on Voice_Key[]: alarm level first, integer squared distance next.
+ * It is updated whenever a slot changes, so the next one to announce
+ * is always at the top.
+ */
+static uint8_t  Voice_Heap[MAX_TRACKING_OBJECTS];
+static uint8_t  Voice_Pos [MAX_TRACKING_OBJECTS]; /* heap position + 1, 0 - out */
+static uint32_t Voice_Key [MAX_TRACKING_OBJECTS];
+static uint8_t  Voice_Count = 0;
+
+static const char *Voice_Where[12] = {
+  "ahead",   "1oclock", "2oclock", "3oclock",  "4oclock",  "5oclock",
+  "6oclock", "7oclock", "8oclock", "9oclock", "10oclock", "11oclock"
+};
+
+static const char *Voice_Digit[10] = {
+  "0", "1", "2", "3", "4", "5", "6", "7", "8", "9"
+};
+
+static char *Voice_Append(char *p, const char *s)
+{
+  while (*s) { *p++ = *s++; }
+  *p = 0;
+
+  return p;
+}
+
+static uint64_t Voice_Distance_Sq(traffic_t *fop)
+{
+  int32_t n = (int32_t) fop->RelativeNorth;
+  int32_t e = (int32_t) fop->RelativeEast;
+
+  return (uint64_t) ((int64_t) n * n + (int64_t) e * e);
+}
+
+static void Voice_Swap(int a, int b)
+{
+  uint8_t t     = Voice_Heap[a];
+  Voice_Heap[a] = Voice_Heap[b];
+  Voice_Heap[b] = t;
+
+  Voice_Pos[Voice_Heap[a]] = a + 1;
+  Voice_Pos[Voice_Heap[b]] = b + 1;
+}
+
+static void Voice_Sift(int pos)
+{
+  while (pos > 0 &&
+         Voice_Key[Voice_Heap[pos]] < Voice_Key[Voice_Heap[(pos - 1) / 2]]) {
+    Voice_Swap(pos, (pos - 1) / 2);
+    pos = (pos - 1) / 2;
+  }
+
+  for (;;) {
+    int l = 2 * pos + 1;
+    int r = l + 1;
+    int m = pos;
+
+    if (l < Voice_Count && Voice_Key[Voice_Heap[l]] < Voice_Key[Voice_Heap[m]]) m = l;
+    if (r < Voice_Count && Voice_Key[Voice_Heap[r]] < Voice_Key[Voice_Heap[m]]) m = r;
+    if (m == pos) break;
+
+    Voice_Swap(pos, m);
+    pos = m;
+  }
+}
+
+static void Voice_Remove(int slot)
+{
+  int pos = Voice_Pos[slot] - 1;
+
+  if (pos < 0) { return; }
+
+  Voice_Count--;
+  if (pos != Voice_Count) {
+    Voice_Swap(pos, Voice_Count);
+    Voice_Pos[slot] = 0;
+    Voice_Sift(pos);
+  } else {
+    Voice_Pos[slot] = 0;
+  }
+}
+
+/* to be called after every change of a Container[] entry */
+static void Voice_Update(traffic_t *fop)
+{
+  if (fop < Container || fop >= Container + MAX_TRACKING_OBJECTS) { return; }
+
+  int slot = fop - Container;
+
+  if (fop->ID == 0 || (fop->alert & TRAFFIC_ALERT_VOICE)) {
+    Voice_Remove(slot);
+    return;
+  }
+
+  int8_t level = constrain(fop->AlarmLevel, ALARM_LEVEL_NONE, ALARM_LEVEL_URGENT);
+
+  uint64_t dist_sq = Voice_Distance_Sq(fop);
+
+  /* the heap key keeps 28 bits of distance, far ones tie with each other */
+  Voice_Key[slot] = ((uint32_t) (ALARM_LEVEL_URGENT - level) << 28) |
+                    (uint32_t) (dist_sq > VOICE_DISTANCE_SQ_MAX ?
+                                VOICE_DISTANCE_SQ_MAX : dist_sq);
+
+  if (Voice_Pos[slot] == 0) {
+    Voice_Heap[Voice_Count] = slot;
+    Voice_Pos[slot] = ++Voice_Count;
+  }
+  Voice_Sift(Voice_Pos[slot] - 1);
+}
+
 void Traffic_Add()
 {
     float fo_distance_sq = fo.RelativeNorth * fo.RelativeNorth +
@@ -52,6 +164,7 @@ void Traffic_Add()
           uint8_t alert_bak = Container[i].alert;
           Container[i] = fo;
           Container[i].alert = alert_bak;
+          Voice_Update(&Container[i]);
           return;
         }
       }
@@ -64,6 +177,7 @@ void Traffic_Add()
       for (i=0; i < MAX_TRACKING_OBJECTS; i++) {
         if (now() - Container[i].timestamp > ENTRY_EXPIRATION_TIME) {
           Container[i] = fo;
+          Voice_Update(&Container[i]);
           return;
         }
 
@@ -81,12 +195,14 @@ void Traffic_Add()
 
       if (fo.AlarmLevel > Container[min_level_ndx].AlarmLevel) {
         Container[min_level_ndx] = fo;
+        Voice_Update(&Container[min_level_ndx]);
         return;
       }
 
       if (fo_distance_sq <  max_distance_sq &&
           fo.AlarmLevel  >= Container[max_dist_ndx].AlarmLevel) {
         Container[max_dist_ndx] = fo;
+        Voice_Update(&Container[max_dist_ndx]);
         return;
       }
     }
@@ -107,161 +223,115 @@ void Traffic_Update(traffic_t *fop)
   fop->RelativeNorth     = distance * cos(radians(bearing));
   fop->RelativeEast      = distance * sin(radians(bearing));
   fop->RelativeVertical  = fop->altitude - ThisAircraft.altitude;
+
+  Voice_Update(fop);
 }
 
 static void Traffic_Voice()
 {
-  int i=0;
-  int j=0;
-  int bearing;
-  char message[80];
+  traffic_t *fop = NULL;
 
-  for (i=0; i < MAX_TRACKING_OBJECTS; i++) {
-    if (Container[i].ID && (now() - Container[i].timestamp) <= VOICE_EXPIRATION_TIME) {
+  /* entries that went silent are dropped lazily, a fresh report brings them back */
+  while (Voice_Count > 0) {
+    fop = &Container[Voice_Heap[0]];
 
-      traffic[j].fop = &Container[i];
-      traffic[j].distance = sqrtf(Container[i].RelativeNorth * Container[i].RelativeNorth +
-                                  Container[i].RelativeEast  * Container[i].RelativeEast);
-      j++;
+    if ((now() - fop->timestamp) <= VOICE_EXPIRATION_TIME) {
+      break;
     }
+
+    Voice_Remove(Voice_Heap[0]);
+    fop = NULL;
   }
 
-  if (j == 0) { return; }
+  if (fop == NULL) { return; }
 
   const char *u_dist, *u_alt;
-  float voc_dist;
-  int   voc_alt;
-  const char *where;
-  char how_far[32];
-  char elev[32];
-
-  qsort(traffic, j, sizeof(traffic_by_dist_t), traffic_cmp_by_distance);
-
-  /*
-   * Issue only one voice alert per each aircraft in the traffic table.
-   * Closest traffic is the first, outmost one is the last.
-   */
-  for (i=0; i < j; i++) {
-    if ((traffic[i].fop->alert & TRAFFIC_ALERT_VOICE) == 0) {
-
-      bearing = (int) (atan2f(traffic[i].fop->RelativeNorth,
-                              traffic[i].fop->RelativeEast) * 180.0 / PI);  /* -180 ... 180 */
-
-      /* convert from math angle into course relative to north */
-      bearing = (bearing <= 90 ? 90 - bearing :
-                                450 - bearing);
-
-      /* This bearing is always relative to current ground track */
-//    if (settings->orientation == DIRECTION_TRACK_UP) {
-          bearing -= ThisAircraft.Track;
-//    }
-
-      if (bearing < 0) {
-        bearing += 360;
-      }
+  uint32_t    unit_len;
+  int         voc_alt;
+  char message[80];
+  char *p = message;
 
-      int oclock = ((bearing + 15) % 360) / 30;
-
-      switch (oclock)
-      {
-      case 0:
-        where = "ahead";
-        break;
-      case 1:
-        where = "1oclock";
-        break;
-      case 2:
-        where = "2oclock";
-        break;
-      case 3:
-        where = "3oclock";
-        break;
-      case 4:
-        where = "4oclock";
-        break;
-      case 5:
-        where = "5oclock";
-        break;
-      case 6:
-        where = "6oclock";
-        break;
-      case 7:
-        where = "7oclock";
-        break;
-      case 8:
-        where = "8oclock";
-        break;
-      case 9:
-        where = "9oclock";
-        break;
-      case 10:
-        where = "10oclock";
-        break;
-      case 11:
-        where = "11oclock";
-        break;
-      }
+  int bearing = (int) (atan2f(fop->RelativeNorth,
+                              fop->RelativeEast) * 180.0 / PI);  /* -180 ... 180 */
 
-      switch (settings->units)
-      {
-      case UNITS_IMPERIAL:
-        u_dist = "nautical miles";
-        u_alt  = "feet";
-        voc_dist = (traffic[i].distance * _GPS_MILES_PER_METER) /
-                    _GPS_MPH_PER_KNOT;
-        voc_alt  = abs((int) (traffic[i].fop->RelativeVertical *
-                    _GPS_FEET_PER_METER));
-        break;
-      case UNITS_MIXED:
-        u_dist = "kms";
-        u_alt  = "feet";
-        voc_dist = traffic[i].distance / 1000.0;
-        voc_alt  = abs((int) (traffic[i].fop->RelativeVertical *
-                    _GPS_FEET_PER_METER));
-        break;
-      case UNITS_METRIC:
-      default:
-        u_dist = "kms";
-        u_alt  = "metres";
-        voc_dist = traffic[i].distance / 1000.0;
-        voc_alt  = abs((int) traffic[i].fop->RelativeVertical);
-        break;
-      }
+  /* convert from math angle into course relative to north */
+  bearing = (bearing <= 90 ? 90 - bearing :
+                            450 - bearing);
 
-      if (voc_dist < 1.0) {
-        strcpy(how_far, "near");
-      } else {
-        if (voc_dist > 9.0) {
-          voc_dist = 9.0;
-        }
-        snprintf(how_far, sizeof(how_far), "%u %s", (int) voc_dist, u_dist);
-      }
+  /* This bearing is always relative to current ground track */
+  bearing -= ThisAircraft.Track;
 
-      if (voc_alt < 100) {
-        strcpy(elev, "near");
-      } else {
-        if (voc_alt > 500) {
-          voc_alt = 500;
-        }
+  if (bearing < 0) {
+    bearing += 360;
+  }
 
-        snprintf(elev, sizeof(elev), "%u hundred %s %s",
-          (voc_alt / 100), u_alt,
-          traffic[i].fop->RelativeVertical > 0 ? "above" : "below");
-      }
+  int oclock = ((bearing + 15) % 360) / 30;
+
+  switch (settings->units)
+  {
+  case UNITS_IMPERIAL:
+    u_dist   = "nautical miles";
+    u_alt    = "feet";
+    unit_len = 1852; /* metres */
+    voc_alt  = abs((int) (fop->RelativeVertical * _GPS_FEET_PER_METER));
+    break;
+  case UNITS_MIXED:
+    u_dist   = "kms";
+    u_alt    = "feet";
+    unit_len = 1000;
+    voc_alt  = abs((int) (fop->RelativeVertical * _GPS_FEET_PER_METER));
+    break;
+  case UNITS_METRIC:
+  default:
+    u_dist   = "kms";
+    u_alt    = "metres";
+    unit_len = 1000;
+    voc_alt  = abs((int) fop->RelativeVertical);
+    break;
+  }
 
-      snprintf(message, sizeof(message),
-                  "traffic %s distance %s altitude %s",
-                  where, how_far, elev);
+  /* whole units of distance, 0 ... 9, without a square root */
+  uint64_t dist_sq = Voice_Distance_Sq(fop);
+  int      voc_dist;
 
-      traffic[i].fop->alert |= TRAFFIC_ALERT_VOICE;
-      traffic[i].fop->timestamp = now();
+  for (voc_dist = 0; voc_dist < 9; voc_dist++) {
+    uint64_t edge = (voc_dist + 1) * unit_len;
+    if (dist_sq < edge * edge) {
+      break;
+    }
+  }
 
-      SoC->TTS(message);
+  p = Voice_Append(p, "traffic ");
+  p = Voice_Append(p, Voice_Where[oclock]);
 
-      /* Speak up of one aircraft at a time */
-      break;
+  p = Voice_Append(p, " distance ");
+  if (voc_dist == 0) {
+    p = Voice_Append(p, "near");
+  } else {
+    p = Voice_Append(p, Voice_Digit[voc_dist]);
+    p = Voice_Append(p, " ");
+    p = Voice_Append(p, u_dist);
+  }
+
+  p = Voice_Append(p, " altitude ");
+  if (voc_alt < 100) {
+    p = Voice_Append(p, "near");
+  } else {
+    if (voc_alt > 500) {
+      voc_alt = 500;
     }
+    p = Voice_Append(p, Voice_Digit[voc_alt / 100]);
+    p = Voice_Append(p, " hundred ");
+    p = Voice_Append(p, u_alt);
+    p = Voice_Append(p, fop->RelativeVertical > 0 ? " above" : " below");
   }
+
+  fop->alert |= TRAFFIC_ALERT_VOICE;
+  fop->timestamp = now();
+  Voice_Remove(fop - Container);
+
+  /* Speak up of one aircraft at a time */
+  SoC->TTS(message);
 }
 
 void Traffic_setup()
@@ -282,6 +352,7 @@ void Traffic_loop()
             Traffic_Update(&Container[i]);
         } else {
           Container[i] = EmptyFO;
+          Voice_Update(&Container[i]);
         }
       }
 
@@ -303,6 +374,7 @@ void Traffic_ClearExpired()
   for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
     if (Container[i].ID && (now() - Container[i].timestamp) > ENTRY_EXPIRATION_TIME) {
       Container[i] = EmptyFO;
+      Voice_Update(&Container[i]);
     }
   }
 }
@@ -70,6 +70,7 @@ typedef struct traffic_by_dist_struct {
 
 #define isTimeToVoice()         (millis() - Traffic_Voice_TimeMarker > 2000)
 #define VOICE_EXPIRATION_TIME   5 /* seconds */
+#define VOICE_DISTANCE_SQ_MAX   0x0FFFFFFFUL /* m^2, ~16 km, heap key only */
 
 #define TRAFFIC_ALERT_VOICE     1
 
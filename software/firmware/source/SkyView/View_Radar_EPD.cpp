@@ -240,13 +240,20 @@ static void EPD_Draw_Radar()
   }
 
   {
+    /* own track rotation, once per frame */
+    float cos_trk = 1.0;
+    float sin_trk = 0.0;
+
+    if (settings->orientation == DIRECTION_TRACK_UP) {
+      cos_trk = cos(radians(ThisAircraft.Track));
+      sin_trk = sin(radians(ThisAircraft.Track));
+    }
+
     for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
       if (Container[i].ID && (now() - Container[i].timestamp) <= EPD_EXPIRATION_TIME) {
 
         float rel_x;
         float rel_y;
-        float distance;
-        float bearing;
 
         bool isTeam = (Container[i].ID == settings->team) ;
 
@@ -267,21 +274,10 @@ static void EPD_Draw_Radar()
           rel_y = Container[i].RelativeNorth;
           break;
         case DIRECTION_TRACK_UP:
-          distance = sqrtf(Container[i].RelativeNorth * Container[i].RelativeNorth +
-                           Container[i].RelativeEast  * Container[i].RelativeEast);
-
-          bearing = atan2f(Container[i].RelativeNorth,
-                           Container[i].RelativeEast) * 180.0 / PI;  /* -180 ... 180 */
-
-          /* convert from math angle into course relative to north */
-          bearing = (bearing <= 90.0 ? 90.0 - bearing :
-                                      450.0 - bearing);
-
-          bearing -= ThisAircraft.Track;
-
-          rel_x = distance * sin(radians(bearing));
-          rel_y = distance * cos(radians(bearing));
-
+          rel_x = Container[i].RelativeEast  * cos_trk -
+                  Container[i].RelativeNorth * sin_trk;
+          rel_y = Container[i].RelativeEast  * sin_trk +
+                  Container[i].RelativeNorth * cos_trk;
           break;
         default:
           /* TBD */
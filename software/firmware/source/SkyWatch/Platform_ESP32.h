@@ -186,6 +186,10 @@ extern volatile bool BMA_Irq;
 extern PCF8563_Class *rtc;
 
 #define NMEA_TCP_SERVICE
+
+#if !defined(CONFIG_IDF_TARGET_ESP32S2)
+#define USE_TFT_DMA
+#endif /* CONFIG_IDF_TARGET_ESP32S2 */
 //#define USE_DNS_SERVER
 
 #define POWER_SAVING_WIFI_TIMEOUT 300000UL /* 5 minutes */
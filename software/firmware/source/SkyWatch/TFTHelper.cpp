@@ -161,6 +161,8 @@ byte TFT_setup()
 
     sprite = new TFT_eSprite(tft);
     sprite->setColorDepth(1);
+    /* one full screen frame buffer, shared by all the views for a lifetime */
+    sprite->createSprite(tft->width(), tft->height());
 
     if (hw_info.model == SOFTRF_MODEL_SKYWATCH &&
         hw_info.baro  == BARO_MODULE_NONE) {
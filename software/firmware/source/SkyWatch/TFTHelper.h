@@ -33,6 +33,8 @@
 #define maxof2(a,b)             (a > b ? a : b)
 
 #define TFT_RADAR_V_THRESHOLD   50      /* metres */
+#define TFT_RADAR_MARK_HALF     6       /* pixels, marker's bounding box */
+#define TFT_RADAR_STRIP_LINES   8       /* pixels, height of a DMA transfer */
 
 #define TEXT_VIEW_LINE_LENGTH   13      /* characters */
 #define TEXT_VIEW_LINE_SPACING  8      /* pixels */
@@ -42,6 +42,80 @@ enum {
 static int view_state_curr = STATE_RVIEW_NONE;
 static int view_state_prev = STATE_RVIEW_NONE;
 
+/* 4 bpp palette of the radar frame */
+enum {
+   RADAR_COLOR_BG,
+   RADAR_COLOR_FG,
+   RADAR_COLOR_URGENT,
+   RADAR_COLOR_IMPORTANT,
+   RADAR_COLOR_TRAFFIC
+};
+
+static uint16_t radar_palette[16] = {
+  [RADAR_COLOR_BG]        = TFT_NAVY,
+  [RADAR_COLOR_FG]        = TFT_WHITE,
+  [RADAR_COLOR_URGENT]    = TFT_RED,
+  [RADAR_COLOR_IMPORTANT] = TFT_YELLOW,
+  [RADAR_COLOR_TRAFFIC]   = TFT_GREEN,
+};
+
+typedef struct tft_rect_struct {
+  int16_t  x;
+  int16_t  y;
+  uint16_t w;
+  uint16_t h;
+} tft_rect_t;
+
+static TFT_eSprite *radar = NULL;
+
+/* whole frame goes out when anything but the targets has changed */
+static bool     radar_full = true;
+static uint32_t radar_bg_signature = 0;
+
+static tft_rect_t radar_marks[MAX_TRACKING_OBJECTS];
+static int        radar_marks_count = 0;
+
+/* two strips - one is being converted while the other one is on the bus */
+static uint16_t radar_strip[2][maxof2(LV_HOR_RES, LV_VER_RES) * TFT_RADAR_STRIP_LINES];
+static uint8_t  radar_strip_ndx = 0;
+static bool     radar_dma = false;
+
+static void TFT_radar_flush(const tft_rect_t *r)
+{
+  int16_t x0 = r->x < 0 ? 0 : r->x;
+  int16_t y0 = r->y < 0 ? 0 : r->y;
+  int16_t x1 = r->x + r->w > radar->width()  ? radar->width()  : r->x + r->w;
+  int16_t y1 = r->y + r->h > radar->height() ? radar->height() : r->y + r->h;
+
+  if (x1 <= x0 || y1 <= y0) {
+    return;
+  }
+
+  for (int16_t y = y0; y < y1; y += TFT_RADAR_STRIP_LINES) {
+    uint16_t lines = y1 - y < TFT_RADAR_STRIP_LINES ? y1 - y : TFT_RADAR_STRIP_LINES;
+    uint16_t *buf  = radar_strip[radar_strip_ndx];
+    uint16_t *ptr  = buf;
+
+    for (int16_t ly = y; ly < y + lines; ly++) {
+      for (int16_t lx = x0; lx < x1; lx++) {
+        uint16_t color = radar->readPixel(lx, ly);
+        *ptr++ = (color >> 8) | (color << 8); /* panel byte order */
+      }
+    }
+
+#if defined(USE_TFT_DMA)
+    if (radar_dma) {
+      /* waits for the previous strip, then returns while this one is sent */
+      tft->pushImageDMA(x0, y, x1 - x0, lines, buf);
+      radar_strip_ndx ^= 1;
+    } else
+#endif /* USE_TFT_DMA */
+    {
+      tft->pushImage(x0, y, x1 - x0, lines, buf);
+    }
+  }
+}
+
 static void TFT_Draw_Radar()
 {
   int16_t  tbx, tby;
@@ -53,20 +127,18 @@ static void TFT_Draw_Radar()
   /* divider is a half of full scale */
   int32_t divider = 2000; 
 
-  sprite->createSprite(tft->width(), tft->height());
-
-  sprite->fillSprite(TFT_BLACK);
-  sprite->setTextColor(TFT_WHITE);
+  radar->fillSprite(RADAR_COLOR_BG);
+  radar->setTextColor(RADAR_COLOR_FG);
 
-  sprite->setTextFont(4);
-  sprite->setTextSize(1);
+  radar->setTextFont(4);
+  radar->setTextSize(1);
 
-  tbw = sprite->textWidth("N");
-  tbh = sprite->fontHeight();
+  tbw = radar->textWidth("N");
+  tbh = radar->fontHeight();
 
   uint16_t radar_x = 0;
   uint16_t radar_y = 0;
-  uint16_t radar_w = sprite->width();
+  uint16_t radar_w = radar->width();
 
   uint16_t radar_center_x = radar_w / 2;
   uint16_t radar_center_y = radar_y + radar_w / 2;
@@ -108,113 +180,108 @@ static void TFT_Draw_Radar()
     }
   }
 
-  sprite->drawCircle(  radar_center_x, radar_center_y,
-                        radius, TFT_WHITE);
-  sprite->drawCircle(  radar_center_x, radar_center_y,
-                        radius / 2, TFT_WHITE);
-
-#if 0
-  /* arrow tip */
-  sprite->fillTriangle(radar_center_x - 7, radar_center_y + 5,
-                        radar_center_x    , radar_center_y - 5,
-                        radar_center_x + 7, radar_center_y + 5,
-                        TFT_WHITE);
-  sprite->fillTriangle(radar_center_x - 7, radar_center_y + 5,
-                        radar_center_x    , radar_center_y + 2,
-                        radar_center_x + 7, radar_center_y + 5,
-                        TFT_NAVY);
-#else
+  radar->drawCircle(  radar_center_x, radar_center_y,
+                        radius, RADAR_COLOR_FG);
+  radar->drawCircle(  radar_center_x, radar_center_y,
+                        radius / 2, RADAR_COLOR_FG);
+
   /* little airplane */
-  sprite->drawFastVLine(radar_center_x,      radar_center_y - 4, 14, TFT_WHITE);
-  sprite->drawFastVLine(radar_center_x + 1,  radar_center_y - 4, 14, TFT_WHITE);
+  radar->drawFastVLine(radar_center_x,      radar_center_y - 4, 14, RADAR_COLOR_FG);
+  radar->drawFastVLine(radar_center_x + 1,  radar_center_y - 4, 14, RADAR_COLOR_FG);
 
-  sprite->drawFastHLine(radar_center_x - 8,  radar_center_y,     18, TFT_WHITE);
-  sprite->drawFastHLine(radar_center_x - 10, radar_center_y + 1, 22, TFT_WHITE);
+  radar->drawFastHLine(radar_center_x - 8,  radar_center_y,     18, RADAR_COLOR_FG);
+  radar->drawFastHLine(radar_center_x - 10, radar_center_y + 1, 22, RADAR_COLOR_FG);
 
-  sprite->drawFastHLine(radar_center_x - 3,  radar_center_y + 8,  8, TFT_WHITE);
-  sprite->drawFastHLine(radar_center_x - 2,  radar_center_y + 9,  6, TFT_WHITE);
-#endif
+  radar->drawFastHLine(radar_center_x - 3,  radar_center_y + 8,  8, RADAR_COLOR_FG);
+  radar->drawFastHLine(radar_center_x - 2,  radar_center_y + 9,  6, RADAR_COLOR_FG);
 
   switch (settings->m.orientation)
   {
   case DIRECTION_NORTH_UP:
     x = radar_x + radar_w / 2 - radius + tbw/2;
     y = radar_y + (radar_w - tbh) / 2;
-    sprite->setCursor(x , y);
-    sprite->print("W");
+    radar->setCursor(x , y);
+    radar->print("W");
     x = radar_x + radar_w / 2 + radius - (3 * tbw)/2;
     y = radar_y + (radar_w - tbh) / 2;
-    sprite->setCursor(x , y);
-    sprite->print("E");
+    radar->setCursor(x , y);
+    radar->print("E");
     x = radar_x + (radar_w - tbw) / 2;
     y = radar_y + radar_w/2 - radius + tbh/2;
-    sprite->setCursor(x , y);
-    sprite->print("N");
+    radar->setCursor(x , y);
+    radar->print("N");
     x = radar_x + (radar_w - tbw) / 2;
     y = radar_y + radar_w/2 + radius - tbh;
-    sprite->setCursor(x , y);
-    sprite->print("S");
+    radar->setCursor(x , y);
+    radar->print("S");
     break;
   case DIRECTION_TRACK_UP:
     x = radar_x + radar_w / 2 - radius + tbw/2;
     y = radar_y + (radar_w - tbh) / 2;
-    sprite->setCursor(x , y);
-    sprite->print("L");
+    radar->setCursor(x , y);
+    radar->print("L");
     x = radar_x + radar_w / 2 + radius - (3 * tbw)/2;
     y = radar_y + (radar_w - tbh) / 2;
-    sprite->setCursor(x , y);
-    sprite->print("R");
+    radar->setCursor(x , y);
+    radar->print("R");
     x = radar_x + (radar_w - tbw) / 2;
     y = radar_y + radar_w/2 + radius - tbh;
-    sprite->setCursor(x , y);
-    sprite->print("B");
+    radar->setCursor(x , y);
+    radar->print("B");
 
     snprintf(cog_text, sizeof(cog_text), "%03d", ThisAircraft.Track);
-    tbw = sprite->textWidth(cog_text);
-    tbh = sprite->fontHeight();
+    tbw = radar->textWidth(cog_text);
+    tbh = radar->fontHeight();
     x = radar_x + (radar_w - tbw) / 2;
     y = radar_y + radar_w/2 - radius + tbh/2;
-    sprite->setCursor(x , y);
-    sprite->print(cog_text);
-#if 0
-    sprite->drawRoundRect( x - 2, y - tbh - 2,
-                            tbw + 8, tbh + 6,
-                            4, TFT_WHITE);
-#endif
+    radar->setCursor(x , y);
+    radar->print(cog_text);
     break;
   default:
     /* TBD */
     break;
   }
 
-  sprite->setTextColor(TFT_WHITE, TFT_BLACK);
+  radar->setTextColor(RADAR_COLOR_FG, RADAR_COLOR_BG);
   x = radar_x;
   y = radar_y + radar_w - tbh;
-  sprite->setCursor(x, y);
+  radar->setCursor(x, y);
 
   if (settings->m.units == UNITS_METRIC || settings->m.units == UNITS_MIXED) {
-    sprite->print(TFT_zoom == ZOOM_LOWEST ? "20 KM" :
-                  TFT_zoom == ZOOM_LOW    ? "10 KM" :
-                  TFT_zoom == ZOOM_MEDIUM ? " 4 KM" :
-                  TFT_zoom == ZOOM_HIGH   ? " 2 KM" : "");
+    radar->print(TFT_zoom == ZOOM_LOWEST ? "20 KM" :
+                 TFT_zoom == ZOOM_LOW    ? "10 KM" :
+                 TFT_zoom == ZOOM_MEDIUM ? " 4 KM" :
+                 TFT_zoom == ZOOM_HIGH   ? " 2 KM" : "");
   } else {
-    sprite->print(TFT_zoom == ZOOM_LOWEST ? "10 NM" :
-                  TFT_zoom == ZOOM_LOW    ? " 5 NM" :
-                  TFT_zoom == ZOOM_MEDIUM ? " 2 NM" :
-                  TFT_zoom == ZOOM_HIGH   ? " 1 NM" : "");
+    radar->print(TFT_zoom == ZOOM_LOWEST ? "10 NM" :
+                 TFT_zoom == ZOOM_LOW    ? " 5 NM" :
+                 TFT_zoom == ZOOM_MEDIUM ? " 2 NM" :
+                 TFT_zoom == ZOOM_HIGH   ? " 1 NM" : "");
   }
 
-  tft->setBitmapColor(TFT_WHITE, TFT_NAVY);
-  sprite->pushSprite(0, 0);
-  sprite->deleteSprite();
+  /* own track rotation, once per frame */
+  float cos_trk = 1.0;
+  float sin_trk = 0.0;
+
+  if (settings->m.orientation == DIRECTION_TRACK_UP) {
+    cos_trk = cos(radians(ThisAircraft.Track));
+    sin_trk = sin(radians(ThisAircraft.Track));
+  }
+
+  tft_rect_t dirty[2 * MAX_TRACKING_OBJECTS];
+  int dirty_count = 0;
+
+  /* erase markers of the previous frame */
+  for (int i=0; i < radar_marks_count; i++) {
+    dirty[dirty_count++] = radar_marks[i];
+  }
+  radar_marks_count = 0;
 
   for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
     if (Container[i].ID && (now() - Container[i].timestamp) <= TFT_EXPIRATION_TIME) {
 
       int16_t rel_x;
       int16_t rel_y;
-      float distance;
-      float bearing;
 
       switch (settings->m.orientation)
       {
@@ -223,21 +290,11 @@ static void TFT_Draw_Radar()
         rel_y = Container[i].RelativeNorth;
         break;
       case DIRECTION_TRACK_UP:
-        distance = sqrtf(Container[i].RelativeNorth * Container[i].RelativeNorth +
-                         Container[i].RelativeEast  * Container[i].RelativeEast);
-
-        bearing = atan2f(Container[i].RelativeNorth,
-                         Container[i].RelativeEast) * 180.0 / PI;  /* -180 ... 180 */
-
-        /* convert from math angle into course relative to north */
-        bearing = (bearing <= 90.0 ? 90.0 - bearing :
-                                    450.0 - bearing);
-
-        bearing -= ThisAircraft.Track;
-
-        rel_x = constrain(distance * sin(radians(bearing)),
+        rel_x = constrain(Container[i].RelativeEast  * cos_trk -
+                          Container[i].RelativeNorth * sin_trk,
                                      -32768, 32767);
-        rel_y = constrain(distance * cos(radians(bearing)),
+        rel_y = constrain(Container[i].RelativeEast  * sin_trk +
+                          Container[i].RelativeNorth * cos_trk,
                                      -32768, 32767);
         break;
       default:
@@ -248,36 +305,77 @@ static void TFT_Draw_Radar()
       int16_t x = ((int32_t) rel_x * (int32_t) radius) / divider;
       int16_t y = ((int32_t) rel_y * (int32_t) radius) / divider;
 
-      uint32_t color = Container[i].AlarmLevel == ALARM_LEVEL_URGENT ? TFT_RED :
+      uint16_t color = Container[i].AlarmLevel == ALARM_LEVEL_URGENT ? RADAR_COLOR_URGENT :
                       (Container[i].AlarmLevel == ALARM_LEVEL_IMPORTANT ?
-                       TFT_YELLOW : TFT_GREEN);
+                       RADAR_COLOR_IMPORTANT : RADAR_COLOR_TRAFFIC);
 
       if        (Container[i].RelativeVertical >   TFT_RADAR_V_THRESHOLD) {
-        tft->fillTriangle(radar_center_x + x - 4, radar_center_y - y + 3,
-                          radar_center_x + x    , radar_center_y - y - 5,
-                          radar_center_x + x + 4, radar_center_y - y + 3,
-                          color);
+        radar->fillTriangle(radar_center_x + x - 4, radar_center_y - y + 3,
+                            radar_center_x + x    , radar_center_y - y - 5,
+                            radar_center_x + x + 4, radar_center_y - y + 3,
+                            color);
       } else if (Container[i].RelativeVertical < - TFT_RADAR_V_THRESHOLD) {
-        tft->fillTriangle(radar_center_x + x - 4, radar_center_y - y - 3,
-                          radar_center_x + x    , radar_center_y - y + 5,
-                          radar_center_x + x + 4, radar_center_y - y - 3,
-                          color);
+        radar->fillTriangle(radar_center_x + x - 4, radar_center_y - y - 3,
+                            radar_center_x + x    , radar_center_y - y + 5,
+                            radar_center_x + x + 4, radar_center_y - y - 3,
+                            color);
       } else {
-        tft->fillCircle(radar_center_x + x,
-                        radar_center_y - y,
-                        5, color);
+        radar->fillCircle(radar_center_x + x,
+                          radar_center_y - y,
+                          5, color);
       }
+
+      tft_rect_t *mark = &radar_marks[radar_marks_count++];
+
+      mark->x = radar_center_x + x - TFT_RADAR_MARK_HALF;
+      mark->y = radar_center_y - y - TFT_RADAR_MARK_HALF;
+      mark->w = 2 * TFT_RADAR_MARK_HALF + 1;
+      mark->h = 2 * TFT_RADAR_MARK_HALF + 1;
+
+      dirty[dirty_count++] = *mark;
     }
   }
+
+  uint32_t signature = (TFT_zoom << 24) | (settings->m.units << 20) |
+                       (settings->m.orientation << 16) |
+                       (settings->m.orientation == DIRECTION_TRACK_UP ?
+                        ThisAircraft.Track : 0);
+
+  tft->startWrite();
+
+  if (radar_full || signature != radar_bg_signature) {
+    tft_rect_t frame = { 0, 0, (uint16_t) radar->width(), (uint16_t) radar->height() };
+
+    TFT_radar_flush(&frame);
+
+    radar_bg_signature = signature;
+    radar_full         = false;
+  } else {
+    for (int i=0; i < dirty_count; i++) {
+      TFT_radar_flush(&dirty[i]);
+    }
+  }
+
+#if defined(USE_TFT_DMA)
+  if (radar_dma) {
+    tft->dmaWait();
+  }
+#endif /* USE_TFT_DMA */
+  tft->endWrite();
 }
 
 void TFT_radar_setup()
 {
   TFT_zoom = settings->m.zoom;
 
-  uint16_t radar_x = 0;
-  uint16_t radar_y = 0;
-  uint16_t radar_w = tft->width();
+  radar = new TFT_eSprite(tft);
+  radar->setColorDepth(4);
+  radar->createSprite(tft->width(), tft->height());
+  radar->createPalette(radar_palette);
+
+#if defined(USE_TFT_DMA)
+  radar_dma = tft->initDMA();
+#endif /* USE_TFT_DMA */
 }
 
 void TFT_radar_loop()
@@ -324,6 +422,7 @@ void TFT_radar_loop()
     if (view_state_curr != view_state_prev) {
        TFT_Clear_Screen();
        view_state_prev = view_state_curr;
+       radar_full = true;
     }
     TFT_Draw_Radar();
   }
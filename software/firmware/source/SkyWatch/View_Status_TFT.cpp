@@ -71,8 +71,6 @@ void TFT_status_loop()
     break;
   }
 
-  sprite->createSprite(tft->width(), tft->height());
-
   sprite->fillSprite(TFT_BLACK);
   sprite->setTextColor(TFT_WHITE);
 
@@ -230,7 +228,6 @@ void TFT_status_loop()
 
   tft->setBitmapColor(TFT_WHITE, TFT_NAVY);
   sprite->pushSprite(0, 0);
-  sprite->deleteSprite();
 }
 
 void TFT_status_next()
@@ -173,8 +173,6 @@ static void TFT_Draw_Text()
      Serial.println(micros()-start);
 #endif
 
-    sprite->createSprite(tft->width(), tft->height());
-
     sprite->fillSprite(TFT_BLACK);
     sprite->setTextColor(TFT_WHITE);
 
@@ -272,7 +270,6 @@ static void TFT_Draw_Text()
 
     tft->setBitmapColor(TFT_WHITE, TFT_NAVY);
     sprite->pushSprite(0, 0);
-    sprite->deleteSprite();
   }
 }
 
@@ -55,8 +55,6 @@ void TFT_time_loop()
              now.hour, now.minute, now.second);
   }
 
-  sprite->createSprite(tft->width(), tft->height());
-
   sprite->fillSprite(TFT_BLACK);
   sprite->setTextColor(TFT_WHITE);
 
@@ -79,7 +77,6 @@ void TFT_time_loop()
 
   tft->setBitmapColor(TFT_WHITE, TFT_NAVY);
   sprite->pushSprite(0, 0);
-  sprite->deleteSprite();
 }
 
 void TFT_time_next()
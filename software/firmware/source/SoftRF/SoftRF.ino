@@ -102,6 +102,8 @@
 #include "src/TTNHelper.h"
 #include "src/TrafficHelper.h"
 #include "src/system/Recorder.h"
+#include "src/system/Profiler.h"
+#include "src/system/RFTask.h"
 
 #if defined(ENABLE_AHRS)
 #include "src/driver/AHRS.h"
@@ -112,10 +114,10 @@
 #endif
 
 #define DEBUG 0
-#define DEBUG_TIMING 0
 
 #define isTimeToDisplay() (millis() - LEDTimeMarker     > 1000)
 #define isTimeToExport()  (millis() - ExportTimeMarker  > 1000)
+#define isTimeToExportTraffic() (millis() - ExportTimeMarker > EXPORT_INTERVAL_FAST_MS)
 
 ufo_t ThisAircraft;
 
@@ -163,6 +165,8 @@ void setup()
 
   SERIAL_FLUSH();
 
+  Profiler_setup();
+
   EEPROM_setup();
 
   SoC->Button_setup();
@@ -210,6 +214,7 @@ void setup()
 
   Battery_setup();
   Traffic_setup();
+  RF_Task_setup();
 
   SoC->swSer_enableRx(false);
 
@@ -268,7 +273,9 @@ void setup()
 void loop()
 {
   // Do common RF stuff first
-  RF_loop();
+  if (!RF_Task_Active()) {
+    RF_loop();
+  }
 
   switch (settings->mode)
   {
@@ -299,7 +306,9 @@ void loop()
   }
 
   // Show status info on tiny OLED display
+  PROFILE_BEGIN(PROBE_DISPLAY_LOOP);
   SoC->Display_loop();
+  PROFILE_END(PROBE_DISPLAY_LOOP);
 
   // battery status LED
   LED_loop();
@@ -413,16 +422,24 @@ void normal()
     }
 #endif /* EXCLUDE_EGM96 */
 
-    RF_Transmit(RF_Encode(&ThisAircraft), true);
+    if (!RF_Task_Active()) {
+      RF_Transmit(RF_Encode(&ThisAircraft), true);
+    }
   }
 
-  success = RF_Receive();
+  if (RF_Task_Active()) {
+    /* radio is served by a task on the other core */
+    RF_Task_Update(&ThisAircraft, isValidFix());
+    RF_Task_Receive();
+  } else {
+    success = RF_Receive();
 
 #if DEBUG
-  success = true;
+    success = true;
 #endif
 
-  if (success && isValidFix()) ParseData();
+    if (success && isValidFix()) ParseData();
+  }
 
 #if defined(ENABLE_TTN)
   TTN_loop();
@@ -443,10 +460,14 @@ void normal()
 
   Sound_loop();
 
-  if (isTimeToExport()) {
+  if (isTimeToExportTraffic()) {
+    bool full = Traffic_Schedule(millis());
+
     NMEA_Export();
     GDL90_Export();
-    D1090_Export();
+    if (full) {
+      D1090_Export();
+    }
 
     ExportTimeMarker = millis();
   }
@@ -498,11 +519,22 @@ void uav()
 void bridge()
 {
   bool success;
+  static size_t tx_size = 0;
+  static unsigned long tx_marker = 0;
 
-  size_t tx_size = Raw_Receive_UDP(&TxBuffer[0]);
+  /* a frame held for too long would put a stale position on air */
+  if (tx_size > 0 && millis() - tx_marker > RAW_UDP_MAX_AGE_MS) {
+    tx_size = 0;
+  }
+
+  /* hold a frame from the batch until a Tx slot becomes available */
+  if (tx_size == 0) {
+    tx_size = Raw_Receive_UDP(&TxBuffer[0], &tx_marker);
+  }
 
-  if (tx_size > 0) {
-    RF_Transmit(tx_size, true);
+  /* no radio - nothing to wait for */
+  if (tx_size > 0 && (RF_Transmit(tx_size, true) || rf_chip == NULL)) {
+    tx_size = 0;
   }
 
   success = RF_Receive();
@@ -525,6 +557,8 @@ void bridge()
     Raw_Transmit_UDP();
   }
 
+  Raw_Flush_UDP();
+
   if (isTimeToDisplay()) {
     LED_Clear();
     LEDTimeMarker = millis();
@@ -569,13 +603,6 @@ unsigned long TxPosUpdMarker = 0;
 void txrx_test()
 {
   bool success = false;
-#if DEBUG_TIMING
-  unsigned long baro_start_ms, baro_end_ms;
-  unsigned long tx_start_ms, tx_end_ms, rx_start_ms, rx_end_ms;
-  unsigned long parse_start_ms, parse_end_ms, led_start_ms, led_end_ms;
-  unsigned long export_start_ms, export_end_ms;
-  unsigned long oled_start_ms, oled_end_ms;
-#endif
   ThisAircraft.timestamp = now();
 
   if (TxPosUpdMarker == 0 || (millis() - TxPosUpdMarker) > 4000 ) {
@@ -589,38 +616,16 @@ void txrx_test()
   ThisAircraft.speed    = TXRX_TEST_SPEED;
   ThisAircraft.vs       = TXRX_TEST_VS;
 
-#if DEBUG_TIMING
-  baro_start_ms = millis();
-#endif
   Baro_loop();
-#if DEBUG_TIMING
-  baro_end_ms = millis();
-#endif
 
 #if defined(ENABLE_AHRS)
   AHRS_loop();
 #endif /* ENABLE_AHRS */
 
-#if DEBUG_TIMING
-  tx_start_ms = millis();
-#endif
   RF_Transmit(RF_Encode(&ThisAircraft), true);
-#if DEBUG_TIMING
-  tx_end_ms = millis();
-  rx_start_ms = millis();
-#endif
   success = RF_Receive();
-#if DEBUG_TIMING
-  rx_end_ms = millis();
-#endif
 
-#if DEBUG_TIMING
-  parse_start_ms = millis();
-#endif
   if (success) ParseData();
-#if DEBUG_TIMING
-  parse_end_ms = millis();
-#endif
 
 #if defined(ENABLE_TTN)
   TTN_loop();
@@ -628,87 +633,30 @@ void txrx_test()
 
   Traffic_loop();
 
-#if DEBUG_TIMING
-  led_start_ms = millis();
-#endif
   if (isTimeToDisplay()) {
     LED_DisplayTraffic();
     LEDTimeMarker = millis();
   }
-#if DEBUG_TIMING
-  led_end_ms = millis();
-#endif
 
   Sound_loop();
 
-#if DEBUG_TIMING
-  export_start_ms = millis();
-#endif
-  if (isTimeToExport()) {
+  if (isTimeToExportTraffic()) {
+    bool full = Traffic_Schedule(millis());
+
 #if defined(USE_NMEALIB)
-    NMEA_Position();
+    if (full) {
+      NMEA_Position();
+    }
 #endif
     NMEA_Export();
     GDL90_Export();
-    D1090_Export();
+    if (full) {
+      D1090_Export();
+    }
     ExportTimeMarker = millis();
   }
-#if DEBUG_TIMING
-  export_end_ms = millis();
-#endif
 
-#if DEBUG_TIMING
-  oled_start_ms = millis();
-#endif
 //  SoC->Display_loop();
-#if DEBUG_TIMING
-  oled_end_ms = millis();
-#endif
-
-#if DEBUG_TIMING
-  if (baro_start_ms - baro_end_ms) {
-    Serial.print(F("Baro start: "));
-    Serial.print(baro_start_ms);
-    Serial.print(F(" Baro stop: "));
-    Serial.println(baro_end_ms);
-  }
-  if (tx_end_ms - tx_start_ms) {
-    Serial.print(F("TX start: "));
-    Serial.print(tx_start_ms);
-    Serial.print(F(" TX stop: "));
-    Serial.println(tx_end_ms);
-  }
-  if (rx_end_ms - rx_start_ms) {
-    Serial.print(F("RX start: "));
-    Serial.print(rx_start_ms);
-    Serial.print(F(" RX stop: "));
-    Serial.println(rx_end_ms);
-  }
-  if (parse_end_ms - parse_start_ms) {
-    Serial.print(F("Parse start: "));
-    Serial.print(parse_start_ms);
-    Serial.print(F(" Parse stop: "));
-    Serial.println(parse_end_ms);
-  }
-  if (led_end_ms - led_start_ms) {
-    Serial.print(F("LED start: "));
-    Serial.print(led_start_ms);
-    Serial.print(F(" LED stop: "));
-    Serial.println(led_end_ms);
-  }
-  if (export_end_ms - export_start_ms) {
-    Serial.print(F("Export start: "));
-    Serial.print(export_start_ms);
-    Serial.print(F(" Export stop: "));
-    Serial.println(export_end_ms);
-  }
-  if (oled_end_ms - oled_start_ms) {
-    Serial.print(F("OLED start: "));
-    Serial.print(oled_start_ms);
-    Serial.print(F(" OLED stop: "));
-    Serial.println(oled_end_ms);
-  }
-#endif
 
   // Handle Air Connect
   NMEA_loop();
@@ -239,6 +239,7 @@ void rx_test_loop()
   }
 
   if (isTimeToExport()) {
+    Traffic_Schedule(millis());
     NMEA_Position();
     NMEA_Export();
     GDL90_Export();
@@ -22,13 +22,63 @@
 #include "driver/GNSS.h"
 #include "driver/Sound.h"
 #include "ui/Web.h"
+#include "system/Profiler.h"
+#include "system/RFTask.h"
 #include "protocol/radio/Legacy.h"
+#include "protocol/data/NMEA.h"
+#include "protocol/data/GDL90.h"
 
 unsigned long UpdateTrafficTimeMarker = 0;
 
 ufo_t fo, Container[MAX_TRACKING_OBJECTS], EmptyFO;
 traffic_by_dist_t traffic_by_dist[MAX_TRACKING_OBJECTS];
 
+/* targets due for export in current cycle, most threatening first */
+traffic_by_dist_t traffic_by_prio[MAX_TRACKING_OBJECTS];
+int  Traffic_Scheduled   = 0;
+bool Traffic_Export_Full = true;
+
+static unsigned long Export_Clock       = 0;
+static unsigned long Export_Full_Marker = 0;
+static unsigned long Export_Marker[EXPORT_SINK_COUNT][MAX_TRACKING_OBJECTS];
+static uint32_t      Export_Addr[MAX_TRACKING_OBJECTS];
+
+typedef struct export_budget_struct {
+  int32_t       tokens;
+  unsigned long marker;
+} export_budget_t;
+
+/* indexed by NMEA_xxx or GDL90_xxx output, both enums share the same order */
+static export_budget_t Export_Budget[EXPORT_CLASS_COUNT][NMEA_BLUETOOTH + 1];
+
+#if !defined(EXCLUDE_TRAFFIC_EXTRAPOLATION)
+#define TRAFFIC_METERS_PER_DEGREE   111319.5
+#define TRAFFIC_PROFILE_SAMPLES     4     /* NS/EW of a Legacy frame */
+#define TRAFFIC_PROFILE_STEP        1.0   /* seconds per sample */
+
+/*
+ * Kinematic state of a target, slot-aligned with Container[].
+ * Container[] keeps the received fix, predictions live here only.
+ */
+typedef struct traffic_track_struct {
+  uint32_t      addr;
+  unsigned long marker;     /* ms, time of the last filter update */
+  float         latitude;   /* filtered position at 'marker' */
+  float         longitude;
+  float         altitude;   /* metres */
+  float         vn;         /* m/s, north */
+  float         ve;         /* m/s, east */
+  float         vz;         /* m/s, up */
+  float         dvn[TRAFFIC_PROFILE_SAMPLES]; /* m/s, turn profile */
+  float         dve[TRAFFIC_PROFILE_SAMPLES];
+  float         p_latitude; /* extrapolated for the last export tick */
+  float         p_longitude;
+  float         p_altitude;
+} traffic_track_t;
+
+static traffic_track_t Traffic_Track[MAX_TRACKING_OBJECTS];
+#endif /* EXCLUDE_TRAFFIC_EXTRAPOLATION */
+
 static int8_t (*Alarm_Level)(ufo_t *, ufo_t *);
 
 /*
@@ -136,15 +186,215 @@ void Traffic_Update(ufo_t *fop)
   }
 }
 
+#if !defined(EXCLUDE_TRAFFIC_EXTRAPOLATION)
+/* horizontal displacement of a track over 'dt' seconds, metres */
+static void Traffic_Track_Move(traffic_track_t *t, float dt, float *dn, float *de)
+{
+  *dn = 0;
+  *de = 0;
+
+  for (int j=0; dt > 0; j++) {
+    int   k   = j < TRAFFIC_PROFILE_SAMPLES ? j : TRAFFIC_PROFILE_SAMPLES - 1;
+    float seg = dt < TRAFFIC_PROFILE_STEP ? dt : TRAFFIC_PROFILE_STEP;
+
+    *dn += (t->vn + t->dvn[k]) * seg;
+    *de += (t->ve + t->dve[k]) * seg;
+    dt  -= seg;
+  }
+}
+
+/*
+ * Legacy frames carry four NS/EW velocity samples over the next seconds.
+ * Course and speed are decoded from their mean, so the decoded ground
+ * speed recovers the scale factor (smult) of the raw samples. The first
+ * sample is the velocity measurement, the rest make the turn profile.
+ */
+static bool Traffic_Track_Profile(ufo_t *fop, traffic_track_t *t,
+                                  float *vn, float *ve)
+{
+  float mn = 0, me = 0;
+
+  for (int j=0; j < TRAFFIC_PROFILE_SAMPLES; j++) {
+    t->dvn[j] = 0;
+    t->dve[j] = 0;
+    mn += fop->ns[j];
+    me += fop->ew[j];
+  }
+
+  if (fop->protocol != RF_PROTOCOL_LEGACY) {
+    return false;
+  }
+
+  float m = sqrtf(mn * mn + me * me) / TRAFFIC_PROFILE_SAMPLES;
+  if (m < 1.0) {
+    return false;
+  }
+
+  float k = fop->speed * _GPS_MPS_PER_KNOT / m;
+
+  *vn = fop->ns[0] * k;
+  *ve = fop->ew[0] * k;
+
+  for (int j=1; j < TRAFFIC_PROFILE_SAMPLES; j++) {
+    t->dvn[j] = fop->ns[j] * k - *vn;
+    t->dve[j] = fop->ew[j] * k - *ve;
+  }
+
+  return true;
+}
+
+/*
+ * Feed fresh reception of Container[i] into the alpha-beta filter.
+ * Reported velocity is blended in as a direct measurement.
+ */
+static void Traffic_Track_Update(int i)
+{
+  ufo_t *fop = &Container[i];
+  traffic_track_t *t = &Traffic_Track[i];
+  unsigned long ms = millis();
+
+  float cos_lat = cosf(radians(fop->latitude));
+  float speed   = fop->speed * _GPS_MPS_PER_KNOT;
+  float vn      = speed * cosf(radians(fop->course));
+  float ve      = speed * sinf(radians(fop->course));
+  float vz      = fop->vs / (_GPS_FEET_PER_METER * 60.0);
+  float dt      = (ms - t->marker) / 1000.0;
+
+  if (t->addr != fop->addr || dt > ENTRY_EXPIRATION_TIME || cos_lat < 0.01) {
+    /* new track */
+    Traffic_Track_Profile(fop, t, &vn, &ve);
+    t->addr        = fop->addr;
+    t->latitude    = t->p_latitude  = fop->latitude;
+    t->longitude   = t->p_longitude = fop->longitude;
+    t->altitude    = t->p_altitude  = fop->altitude;
+    t->vn          = vn;
+    t->ve          = ve;
+    t->vz          = vz;
+    t->marker      = ms;
+    return;
+  }
+
+  float dlon = fop->longitude - t->longitude;
+  dlon += (dlon < -180 ? 360 : (dlon > 180 ? -360 : 0));
+
+  float mn, me;
+  Traffic_Track_Move(t, dt, &mn, &me);
+
+  /* residuals of the prediction, metres */
+  float rn = (fop->latitude - t->latitude) * TRAFFIC_METERS_PER_DEGREE - mn;
+  float re = dlon * TRAFFIC_METERS_PER_DEGREE * cos_lat                - me;
+  float rz = (fop->altitude - t->altitude)                             - t->vz * dt;
+
+  t->latitude  += (mn + TRAFFIC_FILTER_ALPHA * rn) / TRAFFIC_METERS_PER_DEGREE;
+  t->longitude += (me + TRAFFIC_FILTER_ALPHA * re) /
+                  (TRAFFIC_METERS_PER_DEGREE * cos_lat);
+  t->altitude  +=  t->vz * dt + TRAFFIC_FILTER_ALPHA * rz;
+
+  if (t->longitude >  180) { t->longitude -= 360; }
+  if (t->longitude < -180) { t->longitude += 360; }
+
+  /* a burst of receptions carries no information about velocity */
+  if (dt >= TRAFFIC_FILTER_MIN_DT) {
+    t->vn += TRAFFIC_FILTER_BETA * rn / dt;
+    t->ve += TRAFFIC_FILTER_BETA * re / dt;
+    t->vz += TRAFFIC_FILTER_BETA * rz / dt;
+  }
+
+  if (Traffic_Track_Profile(fop, t, &vn, &ve)) {
+    /* first NS/EW sample is the velocity right now */
+    t->vn = vn;
+    t->ve = ve;
+  } else {
+    t->vn += TRAFFIC_FILTER_GAMMA * (vn - t->vn);
+    t->ve += TRAFFIC_FILTER_GAMMA * (ve - t->ve);
+  }
+  t->vz += TRAFFIC_FILTER_GAMMA * (vz - t->vz);
+
+  t->marker = ms;
+}
+
+/*
+ * Distance, bearing and alarm level of Container[i] are taken at the
+ * extrapolated position. The received fix itself is left intact for
+ * the relay, MAVLink and the exporters.
+ */
+static void Traffic_Track_Refresh(int i)
+{
+  ufo_t *fop = &Container[i];
+  traffic_track_t *t = &Traffic_Track[i];
+
+  if (t->addr != fop->addr) {
+    Traffic_Update(fop);
+    return;
+  }
+
+  ufo_t p = *fop;
+
+  p.latitude  = t->p_latitude;
+  p.longitude = t->p_longitude;
+  p.altitude  = t->p_altitude;
+
+  Traffic_Update(&p);
+
+  fop->distance    = p.distance;
+  fop->bearing     = p.bearing;
+  fop->alarm_level = p.alarm_level;
+}
+#else
+#define Traffic_Track_Update(i)  {}
+#define Traffic_Track_Refresh(i) Traffic_Update(&Container[i])
+#endif /* EXCLUDE_TRAFFIC_EXTRAPOLATION */
+
+/*
+ * Extrapolate every tracked target for 'now',
+ * then refresh its distance, bearing and alarm level
+ */
+void Traffic_Predict()
+{
+#if !defined(EXCLUDE_TRAFFIC_EXTRAPOLATION)
+  unsigned long ms = millis();
+
+  for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
+    ufo_t *fop = &Container[i];
+    traffic_track_t *t = &Traffic_Track[i];
+
+    if (fop->addr == 0 || t->addr != fop->addr) {
+      continue;
+    }
+
+    unsigned long elapsed = ms - t->marker;
+    if (elapsed > TRAFFIC_PREDICT_LIMIT_MS) {
+      elapsed = TRAFFIC_PREDICT_LIMIT_MS;
+    }
+
+    float dt      = elapsed / 1000.0;
+    float cos_lat = cosf(radians(t->latitude));
+    float dn, de;
+
+    Traffic_Track_Move(t, dt, &dn, &de);
+
+    t->p_latitude  = t->latitude  + dn / TRAFFIC_METERS_PER_DEGREE;
+    t->p_longitude = t->longitude + de / (TRAFFIC_METERS_PER_DEGREE * cos_lat);
+    t->p_altitude  = t->altitude  + t->vz * dt;
+
+    if (t->p_longitude >  180) { t->p_longitude -= 360; }
+    if (t->p_longitude < -180) { t->p_longitude += 360; }
+
+    Traffic_Track_Refresh(i);
+  }
+#endif /* EXCLUDE_TRAFFIC_EXTRAPOLATION */
+}
+
 bool Traffic_Add(ufo_t *fop)
 {
   int i;
 
   for (i=0; i < MAX_TRACKING_OBJECTS; i++) {
-    if (Container[i].addr == fo.addr) {
+    if (Container[i].addr == fop->addr) {
       uint8_t alert_bak = Container[i].alert;
-      Container[i] = fo;
+      Container[i] = *fop;
       Container[i].alert = alert_bak;
+      Traffic_Track_Update(i);
       return true;
     }
   }
@@ -154,7 +404,8 @@ bool Traffic_Add(ufo_t *fop)
 
   for (i=0; i < MAX_TRACKING_OBJECTS; i++) {
     if (now() - Container[i].timestamp > ENTRY_EXPIRATION_TIME) {
-      Container[i] = fo;
+      Container[i] = *fop;
+      Traffic_Track_Update(i);
       return true;
     }
 #if !defined(EXCLUDE_TRAFFIC_FILTER_EXTENSION)
@@ -168,14 +419,16 @@ bool Traffic_Add(ufo_t *fop)
   }
 
 #if !defined(EXCLUDE_TRAFFIC_FILTER_EXTENSION)
-  if (fo.alarm_level > Container[min_level_ndx].alarm_level) {
-    Container[min_level_ndx] = fo;
+  if (fop->alarm_level > Container[min_level_ndx].alarm_level) {
+    Container[min_level_ndx] = *fop;
+    Traffic_Track_Update(min_level_ndx);
     return true;
   }
 
-  if (fo.distance    <  Container[max_dist_ndx].distance &&
-      fo.alarm_level >= Container[max_dist_ndx].alarm_level) {
-    Container[max_dist_ndx] = fo;
+  if (fop->distance    <  Container[max_dist_ndx].distance &&
+      fop->alarm_level >= Container[max_dist_ndx].alarm_level) {
+    Container[max_dist_ndx] = *fop;
+    Traffic_Track_Update(max_dist_ndx);
     return true;
   }
 #endif /* EXCLUDE_TRAFFIC_FILTER_EXTENSION */
@@ -183,39 +436,59 @@ bool Traffic_Add(ufo_t *fop)
   return false;
 }
 
-void ParseData()
+/* RxBuffer into a report, relative to this_aircraft. Traffic table is not touched */
+bool Traffic_Decode(ufo_t *this_aircraft, ufo_t *fop)
 {
     size_t rx_size = RF_Payload_Size(settings->rf_protocol);
-    rx_size = rx_size > sizeof(fo.raw) ? sizeof(fo.raw) : rx_size;
+    rx_size = rx_size > sizeof(fop->raw) ? sizeof(fop->raw) : rx_size;
 
 #if DEBUG
     Hex2Bin(TxDataTemplate, RxBuffer);
 #endif
 
-    memset(fo.raw, 0, sizeof(fo.raw));
-    memcpy(fo.raw, RxBuffer, rx_size);
+    memset(fop->raw, 0, sizeof(fop->raw));
+    memcpy(fop->raw, RxBuffer, rx_size);
 
     if (settings->nmea_p) {
-      StdOut.print(F("$PSRFI,"));
-      StdOut.print((unsigned long) now()); StdOut.print(F(","));
-      StdOut.print(Bin2Hex(fo.raw, rx_size)); StdOut.print(F(","));
-      StdOut.println(RF_last_rssi);
+      RFOut.print(F("$PSRFI,"));
+      RFOut.print((unsigned long) this_aircraft->timestamp); RFOut.print(F(","));
+      RFOut.print(Bin2Hex(fop->raw, rx_size)); RFOut.print(F(","));
+      RFOut.println(RF_last_rssi);
     }
 
     if (memcmp(RxBuffer, TxBuffer, rx_size) == 0) {
       if (settings->nmea_p) {
-        StdOut.println(F("$PSRFE,RF loopback is detected on Rx"));
+        RFOut.println(F("$PSRFE,RF loopback is detected on Rx"));
       }
 
       rx_packets_counter--;
-      return;
+      return false;
     }
 
-    if (protocol_decode && (*protocol_decode)((void *) RxBuffer, &ThisAircraft, &fo)) {
-      fo.rssi = RF_last_rssi;
+    PROFILE_BEGIN(PROBE_PROTOCOL_DECODE);
+    bool decoded = protocol_decode &&
+                   (*protocol_decode)((void *) RxBuffer, this_aircraft, fop);
+    PROFILE_END(PROBE_PROTOCOL_DECODE);
+
+    if (decoded) {
+      fop->rssi = RF_last_rssi;
+    }
+
+    return decoded;
+}
+
+bool ParseData()
+{
+    PROFILE_SCOPE(PROBE_PARSE_DATA);
+
+    bool decoded = Traffic_Decode(&ThisAircraft, &fo);
+
+    if (decoded) {
       Traffic_Update(&fo);
       Traffic_Add(&fo);
     }
+
+    return decoded;
 }
 
 void Traffic_setup()
@@ -240,13 +513,15 @@ void Traffic_setup()
 
 void Traffic_loop()
 {
+  PROFILE_SCOPE(PROBE_TRAFFIC_LOOP);
+
   if (isTimeToUpdateTraffic()) {
     for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
 
       if (Container[i].addr &&
           (ThisAircraft.timestamp - Container[i].timestamp) <= ENTRY_EXPIRATION_TIME) {
         if ((ThisAircraft.timestamp - Container[i].timestamp) >= TRAFFIC_VECTOR_UPDATE_INTERVAL) {
-          Traffic_Update(&Container[i]);
+          Traffic_Track_Refresh(i);
         }
         if ((Container[i].alert & TRAFFIC_ALERT_SOUND) == 0) {
           Sound_Notify();
@@ -283,6 +558,197 @@ int Traffic_Count()
   return count;
 }
 
+static unsigned long Traffic_Export_Interval(ufo_t *fop)
+{
+  if (fop->alarm_level >= ALARM_LEVEL_IMPORTANT) {
+    return EXPORT_INTERVAL_FAST_MS;
+  }
+
+  if (fop->alarm_level == ALARM_LEVEL_NONE      &&
+      fop->distance    >  EXPORT_DISTANT_RANGE  &&
+      (ThisAircraft.latitude != 0 || ThisAircraft.longitude != 0)) {
+    return EXPORT_DISTANT_INTERVAL_MS;
+  }
+
+  return EXPORT_INTERVAL_MS;
+}
+
+static bool Traffic_Export_Sink_On(uint8_t sink)
+{
+  switch (sink)
+  {
+  case EXPORT_SINK_NMEA:  return settings->nmea_out != NMEA_OFF && settings->nmea_l;
+  case EXPORT_SINK_GDL90: return settings->gdl90 != GDL90_OFF;
+  default:                return false;
+  }
+}
+
+/* is the target due through 'sink' in current export cycle? */
+bool Traffic_Export_Due(uint8_t sink, ufo_t *fop)
+{
+  int i = fop - Container;
+
+  return (Export_Clock - Export_Marker[sink][i]) + EXPORT_INTERVAL_FAST_MS / 2 >=
+         Traffic_Export_Interval(fop);
+}
+
+/*
+ * Report of the target went out through 'sink' or was filtered out.
+ * One which did not fit into the link budget stays due, so that
+ * it goes first in the next cycle.
+ */
+void Traffic_Export_Done(uint8_t sink, ufo_t *fop)
+{
+  Export_Marker[sink][fop - Container] = Export_Clock;
+}
+
+/*
+ * Fills traffic_by_prio[] with targets that are due for export.
+ * Returns true when this is a full (1 Hz) export cycle.
+ */
+bool Traffic_Schedule(unsigned long ms)
+{
+  time_t this_moment = now();
+
+  Export_Clock = ms;
+
+  /* alarms and relative positions work with predicted positions */
+  Traffic_Predict();
+
+  /* tolerate jitter of the caller's export tick */
+  Traffic_Export_Full = (ms - Export_Full_Marker) >=
+                        (EXPORT_INTERVAL_MS - EXPORT_INTERVAL_FAST_MS / 2);
+  if (Traffic_Export_Full) {
+    Export_Full_Marker = ms;
+  }
+
+  Traffic_Scheduled = 0;
+
+  for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
+    ufo_t *fop = &Container[i];
+
+    if (fop->addr == 0 ||
+        (this_moment - fop->timestamp) > EXPORT_EXPIRATION_TIME) {
+      continue;
+    }
+
+    if (Export_Addr[i] != fop->addr) {
+      /* new target in the slot - report it right away */
+      Export_Addr[i] = fop->addr;
+      for (int sink=0; sink < EXPORT_SINK_COUNT; sink++) {
+        Export_Marker[sink][i] = ms - EXPORT_DISTANT_INTERVAL_MS;
+      }
+    }
+
+    bool due = false;
+
+    for (int sink=0; sink < EXPORT_SINK_COUNT; sink++) {
+      if (!Traffic_Export_Sink_On(sink)) {
+        /* keeps the slot from piling up while the output is off */
+        Export_Marker[sink][i] = ms;
+      } else if (Traffic_Export_Due(sink, fop)) {
+        due = true;
+      }
+    }
+
+    if (!due) {
+      continue;
+    }
+
+    traffic_by_prio[Traffic_Scheduled].fop      = fop;
+    traffic_by_prio[Traffic_Scheduled].distance = fop->distance;
+    Traffic_Scheduled++;
+  }
+
+  if (Traffic_Scheduled > 1) {
+    qsort(traffic_by_prio, Traffic_Scheduled, sizeof(traffic_by_dist_t),
+          traffic_cmp_by_alarm);
+  }
+
+  return Traffic_Export_Full;
+}
+
+static uint32_t Traffic_Export_Rate(uint8_t cls, uint8_t dest)
+{
+  uint32_t rate;
+
+  switch (dest)
+  {
+  case NMEA_UART:       rate = SERIAL_OUT_BR / 10; /* 8N1 */  break;
+  case NMEA_BLUETOOTH:  rate = EXPORT_BUDGET_BLUETOOTH;      break;
+  case NMEA_UDP:
+  case NMEA_TCP:
+  case NMEA_USB:
+  default:              return 0; /* unlimited */
+  }
+
+  /* a talkative GNSS receiver must not crowd traffic out of the link */
+  uint32_t gnss = rate * EXPORT_GNSS_SHARE / 100;
+
+  return cls == EXPORT_CLASS_GNSS ? gnss : rate - gnss;
+}
+
+static export_budget_t *Traffic_Export_Budget(uint8_t cls, uint8_t dest)
+{
+  uint32_t rate = Traffic_Export_Rate(cls, dest);
+
+  if (rate == 0 || cls >= EXPORT_CLASS_COUNT ||
+      dest >= sizeof(Export_Budget[0]) / sizeof(Export_Budget[0][0])) {
+    return NULL;
+  }
+
+  export_budget_t *b = &Export_Budget[cls][dest];
+  /* passthrough is not tied to the export tick */
+  unsigned long clock = cls == EXPORT_CLASS_GNSS ? millis() : Export_Clock;
+  unsigned long elapsed = clock - b->marker;
+
+  if (elapsed > 1000) {
+    elapsed = 1000;
+  }
+
+  /* token bucket, up to one second of burst */
+  b->tokens += (int32_t) (rate * elapsed / 1000);
+  if (b->tokens > (int32_t) rate) {
+    b->tokens = rate;
+  }
+  b->marker = clock;
+
+  return b;
+}
+
+/* may 'size' more bytes of class 'cls' go out through 'dest' in this second? */
+bool Traffic_Export_Allow(uint8_t cls, uint8_t dest, size_t size)
+{
+  export_budget_t *b = Traffic_Export_Budget(cls, dest);
+
+  return b == NULL || b->tokens >= (int32_t) size;
+}
+
+void Traffic_Export_Sent(uint8_t cls, uint8_t dest, size_t size)
+{
+  export_budget_t *b = Traffic_Export_Budget(cls, dest);
+
+  if (b) {
+    int32_t floor = -((int32_t) Traffic_Export_Rate(cls, dest));
+
+    b->tokens -= (int32_t) size;
+    if (b->tokens < floor) {
+      b->tokens = floor;
+    }
+  }
+}
+
+int traffic_cmp_by_alarm(const void *a, const void *b)
+{
+  traffic_by_dist_t *ta = (traffic_by_dist_t *)a;
+  traffic_by_dist_t *tb = (traffic_by_dist_t *)b;
+
+  if (ta->fop->alarm_level > tb->fop->alarm_level) return -1;
+  if (ta->fop->alarm_level < tb->fop->alarm_level) return  1;
+
+  return traffic_cmp_by_distance(a, b);
+}
+
 int traffic_cmp_by_distance(const void *a, const void *b)
 {
   traffic_by_dist_t *ta = (traffic_by_dist_t *)a;
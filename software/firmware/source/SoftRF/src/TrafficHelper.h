@@ -35,6 +35,45 @@
 #define isTimeToUpdateTraffic() (millis() - UpdateTrafficTimeMarker > \
                                   TRAFFIC_UPDATE_INTERVAL_MS)
 
+/*
+ * Alpha-beta tracking filter gains. Position and velocity of a target
+ * are extrapolated in between receptions for up to TRAFFIC_PREDICT_LIMIT_MS.
+ */
+#define TRAFFIC_FILTER_ALPHA        0.5
+#define TRAFFIC_FILTER_BETA         0.2
+#define TRAFFIC_FILTER_GAMMA        0.5 /* weight of reported course/speed/vs */
+#define TRAFFIC_FILTER_MIN_DT       0.2 /* seconds */
+#define TRAFFIC_PREDICT_LIMIT_MS    4000
+
+/*
+ * Export scheduler: alarmed targets are reported at up to 4 Hz,
+ * distant quiet ones at a decimated rate. Own position, heartbeats
+ * and status sentences keep going out once per second.
+ */
+#define EXPORT_INTERVAL_MS          1000
+#define EXPORT_INTERVAL_FAST_MS     250
+#define EXPORT_DISTANT_RANGE        10000 /* metres */
+#define EXPORT_DISTANT_INTERVAL_MS  4000
+
+/* bytes per second. BLE UART with default 20 bytes MTU is the bottleneck */
+#define EXPORT_BUDGET_BLUETOOTH     1024
+/* percent of a rate limited link which is left for GNSS passthrough */
+#define EXPORT_GNSS_SHARE           50
+
+enum
+{
+  EXPORT_CLASS_TRAFFIC,
+  EXPORT_CLASS_GNSS,
+  EXPORT_CLASS_COUNT
+};
+
+enum
+{
+  EXPORT_SINK_NMEA,
+  EXPORT_SINK_GDL90,
+  EXPORT_SINK_COUNT
+};
+
 typedef struct traffic_by_dist_struct {
   ufo_t *fop;
   float distance;
@@ -50,7 +89,8 @@ enum
 
 #define TRAFFIC_ALERT_SOUND   1
 
-void ParseData(void);
+bool Traffic_Decode(ufo_t *, ufo_t *);
+bool ParseData(void);
 void Traffic_setup(void);
 void Traffic_loop(void);
 void ClearExpired(void);
@@ -59,8 +99,20 @@ bool Traffic_Add(ufo_t *);
 int  Traffic_Count(void);
 
 int  traffic_cmp_by_distance(const void *, const void *);
+int  traffic_cmp_by_alarm(const void *, const void *);
+
+void Traffic_Predict(void);
+bool Traffic_Schedule(unsigned long);
+bool Traffic_Export_Due(uint8_t, ufo_t *);
+void Traffic_Export_Done(uint8_t, ufo_t *);
+bool Traffic_Export_Allow(uint8_t, uint8_t, size_t);
+void Traffic_Export_Sent(uint8_t, uint8_t, size_t);
 
+extern unsigned long UpdateTrafficTimeMarker;
 extern ufo_t fo, Container[MAX_TRACKING_OBJECTS], EmptyFO;
 extern traffic_by_dist_t traffic_by_dist[MAX_TRACKING_OBJECTS];
+extern traffic_by_dist_t traffic_by_prio[MAX_TRACKING_OBJECTS];
+extern int  Traffic_Scheduled;
+extern bool Traffic_Export_Full;
 
 #endif /* TRAFFICHELPER_H */
@@ -28,6 +28,7 @@ void  Baro_fini()         {}
 float Baro_altitude()     {return 0;}
 float Baro_pressure()     {return 0;}
 float Baro_temperature()  {return 0;}
+float Baro_VS_variance()  {return 0;}
 #else
 
 #if !defined(EXCLUDE_BMP180)
@@ -45,6 +46,8 @@ float Baro_temperature()  {return 0;}
 
 #include <TinyGPS++.h>
 
+#include "GNSS.h"
+
 barochip_ops_t *baro_chip = NULL;
 
 #if !defined(EXCLUDE_BMP180)
@@ -66,10 +69,93 @@ static float Baro_temperature_cache         = 0;
 
 static unsigned long BaroAltitudeTimeMarker = 0;
 static unsigned long BaroPresTempTimeMarker = 0;
-static float prev_pressure_altitude         = 0;
+static unsigned long Baro_Interval          = BARO_ALTITUDE_INTERVAL;
+
+static baro_kf_t Baro_KF;
+
+static unsigned long GNSSAltitudeTimeMarker = 0;
+static float prev_gnss_altitude             = 0;
+
+static void Baro_KF_init(float alt)
+{
+  Baro_KF.alt  = alt;
+  Baro_KF.vs   = 0;
+  Baro_KF.p_aa = BARO_KF_ALT_NOISE * BARO_KF_ALT_NOISE;
+  Baro_KF.p_av = 0;
+  Baro_KF.p_vv = 1.0;
+}
+
+/* constant climb rate model, acceleration is a white noise */
+static void Baro_KF_predict(float dt)
+{
+  float q    = BARO_KF_ACCEL_NOISE * BARO_KF_ACCEL_NOISE;
+  float dt2  = dt * dt;
+
+  Baro_KF.alt  += Baro_KF.vs * dt;
+
+  Baro_KF.p_aa += dt * (2 * Baro_KF.p_av + dt * Baro_KF.p_vv) + q * dt2 * dt2 / 4;
+  Baro_KF.p_av += dt * Baro_KF.p_vv                          + q * dt2 * dt  / 2;
+  Baro_KF.p_vv +=                                              q * dt2;
+}
+
+static void Baro_KF_update_altitude(float alt)
+{
+  float s    = Baro_KF.p_aa + BARO_KF_ALT_NOISE * BARO_KF_ALT_NOISE;
+  float k_a  = Baro_KF.p_aa / s;
+  float k_v  = Baro_KF.p_av / s;
+  float y    = alt - Baro_KF.alt;
+
+  Baro_KF.alt  += k_a * y;
+  Baro_KF.vs   += k_v * y;
+
+  Baro_KF.p_vv -= k_v * Baro_KF.p_av;
+  Baro_KF.p_aa -= k_a * Baro_KF.p_aa;
+  Baro_KF.p_av -= k_a * Baro_KF.p_av;
+}
 
-static float Baro_VS[VS_AVERAGING_FACTOR];
-static int avg_ndx = 0;
+static void Baro_KF_update_climb(float vs)
+{
+  float s    = Baro_KF.p_vv + BARO_KF_GNSS_VS_NOISE * BARO_KF_GNSS_VS_NOISE;
+  float k_a  = Baro_KF.p_av / s;
+  float k_v  = Baro_KF.p_vv / s;
+  float y    = vs - Baro_KF.vs;
+
+  Baro_KF.alt  += k_a * y;
+  Baro_KF.vs   += k_v * y;
+
+  Baro_KF.p_aa -= k_a * Baro_KF.p_av;
+  Baro_KF.p_av -= k_a * Baro_KF.p_vv;
+  Baro_KF.p_vv -= k_v * Baro_KF.p_vv;
+}
+
+/* climb rate out of two successive GNSS fixes */
+static void Baro_GNSS_climb()
+{
+  if (!isValidFix() || !gnss.altitude.isValid()) {
+    GNSSAltitudeTimeMarker = 0;
+    return;
+  }
+
+  /*
+   * updated flag of gnss.altitude is consumed by the main loop before
+   * we get here. Commit time it is - it reads back with a 1 ms jitter
+   */
+  unsigned long fix_time = millis() - gnss.altitude.age();
+  unsigned long dt       = fix_time - GNSSAltitudeTimeMarker;
+
+  if (GNSSAltitudeTimeMarker != 0 && dt < BARO_KF_GNSS_DT_MIN) {
+    return;
+  }
+
+  float gnss_altitude = gnss.altitude.meters();
+
+  if (GNSSAltitudeTimeMarker != 0 && dt < BARO_KF_GNSS_DT_MAX) {
+    Baro_KF_update_climb((gnss_altitude - prev_gnss_altitude) * 1000 / dt);
+  }
+
+  prev_gnss_altitude     = gnss_altitude;
+  GNSSAltitudeTimeMarker = fix_time;
+}
 
 #if !defined(EXCLUDE_BMP180)
 static bool bmp180_probe()
@@ -120,6 +206,7 @@ static float bmp180_temperature()
 barochip_ops_t bmp180_ops = {
   BARO_MODULE_BMP180,
   "BMP180",
+  BARO_ALTITUDE_INTERVAL_SLOW,
   bmp180_probe,
   bmp180_setup,
   bmp180_fini,
@@ -181,6 +268,7 @@ static float bmp280_temperature()
 barochip_ops_t bmp280_ops = {
   BARO_MODULE_BMP280,
   "BMx280",
+  BARO_ALTITUDE_INTERVAL,
   bmp280_probe,
   bmp280_setup,
   bmp280_fini,
@@ -198,6 +286,9 @@ static bool bme680_probe()
 
 static void bme680_setup()
 {
+    /* gas resistance is of no use here, the heater adds 150 ms per reading */
+    bme680.setGasHeater(0, 0);
+
     Serial.print(F("Temperature = "));
     Serial.print(bme680.readTemperature());
     Serial.println(F(" *C"));
@@ -219,24 +310,34 @@ static void bme680_fini()
   /* TBD */
 }
 
+/*
+ * Forced mode conversion runs in between two calls. Collect the one
+ * started last time and kick off the next: loop() never waits for it
+ */
 static float bme680_altitude(float sealevelPressure)
 {
-    return bme680.readAltitude(sealevelPressure);
+    if (bme680.remainingReadingMillis() != Adafruit_BME680::reading_not_started) {
+      bme680.endReading();
+    }
+    bme680.beginReading();
+
+    return 44330.0 * (1.0 - pow((bme680.pressure / 100.0F) / sealevelPressure, 0.1903));
 }
 
 static float bme680_pressure()
 {
-    return bme680.readPressure();
+    return (float) bme680.pressure;
 }
 
 static float bme680_temperature()
 {
-    return bme680.readTemperature();
+    return bme680.temperature;
 }
 
 barochip_ops_t bme680_ops = {
   BARO_MODULE_BME680,
   "BME68x",
+  BARO_ALTITUDE_INTERVAL,
   bme680_probe,
   bme680_setup,
   bme680_fini,
@@ -247,6 +348,18 @@ barochip_ops_t bme680_ops = {
 #endif /* EXCLUDE_BME680 */
 
 #if !defined(EXCLUDE_MPL3115A2)
+/*
+ * The library waits for every conversion, 512 ms each. Here a one-shot
+ * conversion is started and collected on the next call instead.
+ * Altitude mode does not report pressure - it is derived back with
+ * the chip's own barometric formula.
+ */
+static bool          mpl3115a2_pending    = false;
+static unsigned long mpl3115a2_start_ms   = 0;
+static float         mpl3115a2_alt_cache  = 0;
+static float         mpl3115a2_temp_cache = 0;
+static float         mpl3115a2_slp        = 1013.25; /* hPa */
+
 static bool mpl3115a2_probe()
 {
   return mpl3115a2.begin();
@@ -265,6 +378,9 @@ static void mpl3115a2_setup()
   float tempC = mpl3115a2.getTemperature();
   Serial.print(tempC); Serial.println(F("*C"));
 
+  mpl3115a2_alt_cache  = altm;
+  mpl3115a2_temp_cache = tempC;
+
   delay(250);
 }
 
@@ -273,25 +389,74 @@ static void mpl3115a2_fini()
   /* TBD */
 }
 
+static uint8_t mpl3115a2_read8(uint8_t reg)
+{
+  Wire.beginTransmission(MPL3115A2_ADDRESS);
+  Wire.write(reg);
+  Wire.endTransmission(false);
+  Wire.requestFrom((uint8_t) MPL3115A2_ADDRESS, (uint8_t) 1);
+  return Wire.read();
+}
+
 static float mpl3115a2_altitude(float sealevelPressure)
 {
-  mpl3115a2.setSeaPressure(sealevelPressure * 100);
-  return mpl3115a2.getAltitude();
+  if (mpl3115a2_pending &&
+      (mpl3115a2_read8(MPL3115A2_REGISTER_STATUS) & MPL3115A2_REGISTER_STATUS_PDR)) {
+    Wire.beginTransmission(MPL3115A2_ADDRESS);
+    Wire.write(MPL3115A2_REGISTER_PRESSURE_MSB);
+    Wire.endTransmission(false);
+    Wire.requestFrom((uint8_t) MPL3115A2_ADDRESS, (uint8_t) 5);
+
+    int32_t alt;
+    alt  = ((uint32_t) Wire.read()) << 24;
+    alt |= ((uint32_t) Wire.read()) << 16;
+    alt |= ((uint32_t) Wire.read()) << 8;
+    int16_t t;
+    t  = ((uint16_t) Wire.read()) << 8;
+    t |= Wire.read();
+
+    mpl3115a2_alt_cache  = (float) alt / 65536.0;
+    mpl3115a2_temp_cache = (float) t   / 256.0;
+    mpl3115a2_pending    = false;
+  }
+
+  /* lost conversion - start over */
+  if (mpl3115a2_pending && (millis() - mpl3115a2_start_ms) > 2 * BARO_ALTITUDE_INTERVAL_MPL) {
+    mpl3115a2_pending = false;
+  }
+
+  if (!mpl3115a2_pending) {
+    mpl3115a2_slp = sealevelPressure;
+    mpl3115a2.setSeaPressure(sealevelPressure * 100);
+
+    Wire.beginTransmission(MPL3115A2_ADDRESS);
+    Wire.write(MPL3115A2_CTRL_REG1);
+    Wire.write((uint8_t) (MPL3115A2_CTRL_REG1_OS128 | MPL3115A2_CTRL_REG1_ALT |
+                          MPL3115A2_CTRL_REG1_OST));
+    Wire.endTransmission();
+
+    mpl3115a2_start_ms = millis();
+    mpl3115a2_pending  = true;
+  }
+
+  return mpl3115a2_alt_cache;
 }
 
 static float mpl3115a2_pressure()
 {
-  return mpl3115a2.getPressure();
+  return mpl3115a2_slp * 100 *
+         pow(1.0 - mpl3115a2_alt_cache / 44330.77, 1.0 / 0.1902632);
 }
 
 static float mpl3115a2_temperature()
 {
-  return mpl3115a2.getTemperature();
+  return mpl3115a2_temp_cache;
 }
 
 barochip_ops_t mpl3115a2_ops = {
   BARO_MODULE_MPL3115A2,
   "MPL3115A2",
+  BARO_ALTITUDE_INTERVAL_MPL,
   mpl3115a2_probe,
   mpl3115a2_setup,
   mpl3115a2_fini,
@@ -344,12 +509,11 @@ byte Baro_setup()
     BaroPresTempTimeMarker = millis();
 
     Baro_altitude_cache    = baro_chip->altitude(1013.25);
-    ThisAircraft.pressure_altitude = prev_pressure_altitude = Baro_altitude_cache;
+    ThisAircraft.pressure_altitude = Baro_altitude_cache;
     BaroAltitudeTimeMarker = millis();
 
-    for (int i=0; i<VS_AVERAGING_FACTOR; i++) {
-      Baro_VS[i] = 0;
-    }
+    Baro_Interval = baro_chip->interval;
+    Baro_KF_init(Baro_altitude_cache);
 
     return baro_chip->type;
 
@@ -367,33 +531,29 @@ void Baro_loop()
 
   if (isTimeToBaroAltitude()) {
 
-    /* Draft of pressure altitude and vertical speed calculation */
     Baro_altitude_cache = baro_chip->altitude(1013.25);
 
     ThisAircraft.pressure_altitude = Baro_altitude_cache;
 
-    Baro_VS[avg_ndx] = (Baro_altitude_cache - prev_pressure_altitude) /
-                       (millis() - BaroAltitudeTimeMarker) * 1000;  /* in m/s */
+    float dt = (millis() - BaroAltitudeTimeMarker) / 1000.0; /* in seconds */
+    BaroAltitudeTimeMarker = millis();
 
-    ThisAircraft.vs = 0;
-    for (int i=0; i<VS_AVERAGING_FACTOR; i++) {
-      ThisAircraft.vs += Baro_VS[i];
-    }
-    ThisAircraft.vs /= VS_AVERAGING_FACTOR;
+    Baro_KF_predict(dt);
+    Baro_KF_update_altitude(Baro_altitude_cache);
+    Baro_GNSS_climb();
 
-    if (ThisAircraft.vs > -0.1 && ThisAircraft.vs < 0.1) {
-      ThisAircraft.vs = 0;
-    }
+    float vs = Baro_KF.vs; /* in m/s */
 
-    ThisAircraft.vs *= (_GPS_FEET_PER_METER * 60.0) ; /* feet per minute */
+    if (vs > -0.1 && vs < 0.1) {
+      vs = 0;
+    }
 
-    prev_pressure_altitude = Baro_altitude_cache;
-    BaroAltitudeTimeMarker = millis();
-    avg_ndx = (avg_ndx + 1) % VS_AVERAGING_FACTOR;
+    ThisAircraft.vs = vs * (_GPS_FEET_PER_METER * 60.0) ; /* feet per minute */
 
 #if 0
     Serial.print(F("P.Alt. = ")); Serial.print(ThisAircraft.pressure_altitude);
-    Serial.print(F(" , VS avg. = ")); Serial.println(ThisAircraft.vs);
+    Serial.print(F(" , VS = ")); Serial.print(ThisAircraft.vs);
+    Serial.print(F(" , var. = ")); Serial.println(Baro_KF.p_vv);
 #endif
   }
 
@@ -424,4 +584,10 @@ float Baro_temperature()
   return Baro_temperature_cache;
 }
 
+/* (m/s)^2 */
+float Baro_VS_variance()
+{
+  return Baro_KF.p_vv;
+}
+
 #endif /* EXCLUDE_BMP180 && EXCLUDE_BMP280 EXCLUDE_BME680 EXCLUDE_MPL3115A2 */
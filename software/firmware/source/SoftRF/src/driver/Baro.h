@@ -21,10 +21,14 @@
 
 #define BMP280_ADDRESS_ALT    0x76 /* GY-91, SA0 is NC */
 
-#define VS_AVERAGING_FACTOR   3
+/* baro sensor altitude readings interval, ms */
+#define BARO_ALTITUDE_INTERVAL      100
+/* BMP180 blocks for ~30 ms per reading in ultra high resolution mode */
+#define BARO_ALTITUDE_INTERVAL_SLOW 333
+/* MPL3115A2 one-shot conversion with 128x oversampling takes 512 ms */
+#define BARO_ALTITUDE_INTERVAL_MPL  600
 
-/* 3 baro sensor altitude readings per second */
-#define isTimeToBaroAltitude() ((millis() - BaroAltitudeTimeMarker) > (1000 / VS_AVERAGING_FACTOR))
+#define isTimeToBaroAltitude() ((millis() - BaroAltitudeTimeMarker) >= Baro_Interval)
 /* read pressure and temperature every 3 seconds */
 #define isTimeToBaroPresTemp() ((millis() - BaroPresTempTimeMarker) > 3000)
 
@@ -40,6 +44,7 @@ enum
 typedef struct barochip_ops_struct {
   byte type;
   const char name[10];
+  uint16_t interval;  /* ms, altitude readings. Not shorter than a conversion */
   bool (*probe)();
   void (*setup)();
   void (*fini)();
@@ -48,6 +53,25 @@ typedef struct barochip_ops_struct {
   float (*temperature)();
 } barochip_ops_t;
 
+/*
+ * Vertical speed estimator: two state (altitude, climb rate) Kalman filter.
+ * Pressure altitude is fed at the sensor rate, climb rate derived
+ * from two successive GNSS altitudes - at the fix rate.
+ */
+#define BARO_KF_ACCEL_NOISE   0.5  /* m/s^2, vertical acceleration */
+#define BARO_KF_ALT_NOISE     0.5  /* m,     pressure altitude */
+#define BARO_KF_GNSS_VS_NOISE 1.5  /* m/s,   GNSS climb rate */
+#define BARO_KF_GNSS_DT_MAX   3000 /* ms,    beyond that GNSS climb is stale */
+#define BARO_KF_GNSS_DT_MIN   50   /* ms,    closer fixes are the same one */
+
+typedef struct baro_kf_struct {
+  float alt;        /* m */
+  float vs;         /* m/s */
+  float p_aa;       /* covariance: altitude */
+  float p_av;       /*             altitude x climb */
+  float p_vv;       /*             climb */
+} baro_kf_t;
+
 extern barochip_ops_t *baro_chip;
 
 bool  Baro_probe(void);
@@ -57,5 +81,6 @@ void  Baro_fini(void);
 float Baro_altitude(void);
 float Baro_pressure(void);
 float Baro_temperature(void);
+float Baro_VS_variance(void);
 
 #endif /* BAROHELPER_H */
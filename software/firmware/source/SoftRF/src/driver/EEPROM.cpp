@@ -146,13 +146,22 @@ void EEPROM_defaults()
 
 void EEPROM_store()
 {
+  bool changed = false;
+
+  /* touch only bytes that differ - some cores persist every write() at once */
   for (int i=0; i<sizeof(eeprom_t); i++) {
-    EEPROM.write(i, eeprom_block.raw[i]);
+    if (EEPROM.read(i) != eeprom_block.raw[i]) {
+      EEPROM.write(i, eeprom_block.raw[i]);
+      changed = true;
+    }
   }
 
   SoC->EEPROM_extension(EEPROM_EXT_STORE);
 
-  EEPROM_commit();
+  /* re-sent identical settings cost no flash erase */
+  if (changed) {
+    EEPROM_commit();
+  }
 }
 
 #endif /* EXCLUDE_EEPROM */
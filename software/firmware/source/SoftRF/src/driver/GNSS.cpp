@@ -1670,7 +1670,7 @@ void PickGNSSFix()
           else
 #endif
           {
-            NMEA_Out(settings->nmea_out, &GNSSbuf[ndx], write_size, true);
+            NMEA_Passthrough(settings->nmea_out, &GNSSbuf[ndx], write_size, true);
           }
 
           break;
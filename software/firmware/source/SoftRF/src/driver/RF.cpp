@@ -18,6 +18,8 @@
 
 #include "RF.h"
 #include "EEPROM.h"
+#include "../system/Profiler.h"
+#include "../system/RFTask.h"
 #if !defined(EXCLUDE_MAVLINK)
 #include "../protocol/data/MAVLink.h"
 #endif /* EXCLUDE_MAVLINK */
@@ -35,6 +37,7 @@ int8_t RF_last_rssi = 0;
 FreqPlan RF_FreqPlan;
 
 size_t RF_tx_size = 0;
+size_t RF_rx_size = 0; /* of the last frame received, when the driver knows it */
 
 const rfchip_ops_t *rf_chip = NULL;
 bool RF_SX12XX_RST_is_connected = true;
@@ -48,6 +51,7 @@ const char *Protocol_ID[] = {
   [RF_PROTOCOL_FANET]     = "FAN",
   [RF_PROTOCOL_APRS]      = "HAM",
   [RF_PROTOCOL_ADSL_860]  = "ADL",
+  [RF_PROTOCOL_EID]       = "RID",
 };
 
 size_t (*protocol_encode)(void *, ufo_t *);
@@ -55,6 +59,8 @@ bool   (*protocol_decode)(void *, ufo_t *, ufo_t *);
 
 static Slots_descr_t Time_Slots, *ts;
 static uint8_t       RF_timing = RF_TIMING_INTERVAL;
+time_t               RF_Slot_Time = 0; /* UTC second the slots run on */
+uint8_t              RF_Slot_CSec = 0; /* of the fix the sample was taken on */
 
 extern const gnss_chip_ops_t *gnss_chip;
 
@@ -189,31 +195,39 @@ byte RF_setup(void)
   }
 }
 
-void RF_SetChannel(void)
+/*
+ * Sample GNSS/PPS time for the slot logic. Reads gnss and TimeLib,
+ * so this is a loop() context call. The result stays usable for
+ * a while: RF_SetChannel_Time() advances it by millis()
+ */
+void RF_Time_Sample(rf_time_t *t)
 {
   tmElements_t  tm;
-  time_t        Time;
-  unsigned long pps_btime_ms, ref_time_ms;
+  unsigned long ms_since_boot = millis();
+
+  t->marker = ms_since_boot;
+  t->pps    = 0;
+  t->ref    = 0;
+  t->csec   = gnss.time.centisecond();
 
   switch (settings->mode)
   {
   case SOFTRF_MODE_TXRX_TEST:
-    Time = now();
+    t->utc = now();
     RF_timing = RF_timing == RF_TIMING_2SLOTS_PPS_SYNC ?
                 RF_TIMING_INTERVAL : RF_timing;
     break;
 #if !defined(EXCLUDE_MAVLINK)
   case SOFTRF_MODE_UAV:
-    Time = the_aircraft.location.gps_time_stamp / 1000000;
+    t->utc = the_aircraft.location.gps_time_stamp / 1000000;
     RF_timing = RF_timing == RF_TIMING_2SLOTS_PPS_SYNC ?
                 RF_TIMING_INTERVAL : RF_timing;
     break;
 #endif /* EXCLUDE_MAVLINK */
   case SOFTRF_MODE_NORMAL:
   default:
-    pps_btime_ms = SoC->get_PPS_TimeMarker();
+    unsigned long pps_btime_ms = SoC->get_PPS_TimeMarker();
     unsigned long time_corr_neg;
-    unsigned long ms_since_boot = millis();
 
     if (pps_btime_ms) {
       unsigned long last_Commit_Time = ms_since_boot - gnss.time.age();
@@ -222,13 +236,11 @@ void RF_SetChannel(void)
       } else {
         time_corr_neg = 1000 - ((pps_btime_ms - last_Commit_Time) % 1000);
       }
-      ref_time_ms = (ms_since_boot - pps_btime_ms) <= 1010 ?
-                    pps_btime_ms :
-                    ms_since_boot-(ms_since_boot % 1000)+(pps_btime_ms % 1000);
+      t->pps = pps_btime_ms;
     } else {
       unsigned long last_RMC_Commit = ms_since_boot - gnss.date.age();
       time_corr_neg = gnss_chip ? gnss_chip->rmc_ms : 100;
-      ref_time_ms = last_RMC_Commit - time_corr_neg;
+      t->ref = last_RMC_Commit - time_corr_neg;
     }
 
     int yr    = gnss.date.year();
@@ -243,9 +255,28 @@ void RF_SetChannel(void)
     tm.Minute = gnss.time.minute();
     tm.Second = gnss.time.second();
 
-    Time = makeTime(tm) + (gnss.time.age() - time_corr_neg) / 1000;
+    /* the second of 'utc' has begun at 'marker' */
+    t->utc    = makeTime(tm);
+    t->marker = ms_since_boot - gnss.time.age() + time_corr_neg;
     break;
   }
+}
+
+/* slot and channel switch on a time sample. Safe to call off loop() */
+void RF_SetChannel_Time(rf_time_t *t)
+{
+  unsigned long ms_since_boot = millis();
+  time_t        Time          = t->utc + (ms_since_boot - t->marker) / 1000;
+  unsigned long ref_time_ms   = t->ref;
+
+  if (t->pps) {
+    ref_time_ms = (ms_since_boot - t->pps) <= 1010 ?
+                  t->pps :
+                  ms_since_boot-(ms_since_boot % 1000)+(t->pps % 1000);
+  }
+
+  RF_Slot_Time = Time;
+  RF_Slot_CSec = t->csec;
 
   uint8_t OGN  = (settings->rf_protocol == RF_PROTOCOL_OGNTP    ? 1 : 0);
   uint8_t ADSL = (settings->rf_protocol == RF_PROTOCOL_ADSL_860 ? 1 : 0);
@@ -286,9 +317,18 @@ void RF_SetChannel(void)
   }
 }
 
+void RF_SetChannel(void)
+{
+  rf_time_t t;
+
+  RF_Time_Sample(&t);
+  RF_SetChannel_Time(&t);
+}
+
 void RF_loop()
 {
   RF_SetChannel();
+  RF_Forward();
 }
 
 size_t RF_Encode(ufo_t *fop)
@@ -318,16 +358,18 @@ bool RF_Transmit(size_t size, bool wait)
 
     if (!wait || millis() > TxTimeMarker) {
 
-      time_t timestamp = now();
+      PROFILE_BEGIN(PROBE_RF_TRANSMIT);
+
+      time_t timestamp = RF_Slot_Time;
 
       if (memcmp(TxBuffer, RxBuffer, RF_tx_size) != 0) {
 
         if (rf_chip->transmit()) {
           if (settings->nmea_p) {
-            StdOut.print(F("$PSRFO,"));
-            StdOut.print((unsigned long) timestamp);
-            StdOut.print(F(","));
-            StdOut.println(Bin2Hex((byte *) &TxBuffer[0],
+            RFOut.print(F("$PSRFO,"));
+            RFOut.print((unsigned long) timestamp);
+            RFOut.print(F(","));
+            RFOut.println(Bin2Hex((byte *) &TxBuffer[0],
                                    RF_Payload_Size(settings->rf_protocol)));
           }
           tx_packets_counter++;
@@ -335,7 +377,7 @@ bool RF_Transmit(size_t size, bool wait)
       } else {
 
         if (settings->nmea_p) {
-          StdOut.println(F("$PSRFE,RF loopback is detected on Tx"));
+          RFOut.println(F("$PSRFE,RF loopback is detected on Tx"));
         }
       }
 
@@ -360,18 +402,59 @@ bool RF_Transmit(size_t size, bool wait)
         break;
       }
 
+      PROFILE_END(PROBE_RF_TRANSMIT);
+
       return true;
     }
   }
   return false;
 }
 
+/*
+ * Relayed frames go out in between own time slots and
+ * do not move the own position Tx time marker
+ */
+bool RF_Forward(void)
+{
+  size_t size = 0;
+
+  if (rf_chip == NULL || settings->txpower == RF_TX_POWER_OFF) {
+    return false;
+  }
+
+  long room = (long) (TxTimeMarker - millis());
+  if (room >= 0 && room < (long) ts->air_time) {
+    return false;
+  }
+
+  switch (settings->rf_protocol)
+  {
+  case RF_PROTOCOL_FANET:
+    size = fanet_forward((void *) &TxBuffer[0]);
+    break;
+  default:
+    break;
+  }
+
+  if (size == 0) {
+    return false;
+  }
+
+  unsigned long own_marker = TxTimeMarker;
+  bool rval = RF_Transmit(size, false);
+  TxTimeMarker = own_marker;
+
+  return rval;
+}
+
 bool RF_Receive(void)
 {
   bool rval = false;
 
   if (rf_chip) {
+    PROFILE_BEGIN(PROBE_RF_RECEIVE);
     rval = rf_chip->receive();
+    PROFILE_END(PROBE_RF_RECEIVE);
   }
   
   return rval;
@@ -379,11 +462,20 @@ bool RF_Receive(void)
 
 void RF_Shutdown(void)
 {
+  /* the radio must not be torn down under a running RF task */
+  RF_Task_fini();
+
   if (rf_chip) {
     rf_chip->shutdown();
   }
 }
 
+/* duration of one frame of current protocol on air, ms */
+uint16_t RF_Air_Time()
+{
+  return ts ? ts->air_time : 0;
+}
+
 uint8_t RF_Payload_Size(uint8_t protocol)
 {
   switch (protocol)
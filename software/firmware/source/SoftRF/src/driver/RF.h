@@ -117,17 +117,30 @@ typedef struct Slots_descr_struct {
   uint8_t       current;
 } Slots_descr_t;
 
+/* time reference of the slot logic, see RF_Time_Sample() */
+typedef struct rf_time_struct {
+  time_t        utc;      /* UTC second which has begun at 'marker' */
+  unsigned long marker;   /* ms since boot */
+  unsigned long pps;      /* ms since boot, last PPS edge or 0 */
+  unsigned long ref;      /* ms since boot, slot reference w/o PPS */
+  uint8_t       csec;     /* centiseconds of the last GNSS fix time */
+} rf_time_t;
+
 String Bin2Hex(byte *, size_t);
 uint8_t parity(uint32_t);
 
 byte    RF_setup(void);
+void    RF_Time_Sample(rf_time_t *);
+void    RF_SetChannel_Time(rf_time_t *);
 void    RF_SetChannel(void);
 void    RF_loop(void);
 size_t  RF_Encode(ufo_t *);
 bool    RF_Transmit(size_t, bool);
+bool    RF_Forward(void);
 bool    RF_Receive(void);
 void    RF_Shutdown(void);
 uint8_t RF_Payload_Size(uint8_t);
+uint16_t RF_Air_Time(void);
 
 extern byte TxBuffer[MAX_PKT_SIZE], RxBuffer[MAX_PKT_SIZE];
 extern unsigned long TxTimeMarker;
@@ -139,6 +152,8 @@ extern size_t (*protocol_encode)(void *, ufo_t *);
 extern bool (*protocol_decode)(void *, ufo_t *, ufo_t *);
 
 extern FreqPlan RF_FreqPlan;
+extern time_t  RF_Slot_Time;
+extern uint8_t RF_Slot_CSec;
 
 extern int8_t RF_last_rssi;
 extern const char *Protocol_ID[];
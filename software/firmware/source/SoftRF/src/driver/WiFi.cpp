@@ -66,7 +66,7 @@ WiFiUDP *Uni_Udp = NULL;
 
 unsigned int RFlocalPort = RELAY_SRC_PORT;      // local port to listen for UDP packets
 
-char UDPpacketBuffer[256]; // buffer to hold incoming and outgoing packets
+char UDPpacketBuffer[UDP_PACKET_BUFSIZE]; // buffer to hold incoming and outgoing packets
 
 #if defined(POWER_SAVING_WIFI_TIMEOUT)
 static unsigned long WiFi_No_Clients_Time_ms = 0;
@@ -75,23 +75,137 @@ static unsigned long WiFi_No_Clients_Time_ms = 0;
 #if defined(ENABLE_REMOTE_ID)
 #include "../protocol/radio/RemoteID.h"
 static unsigned long RID_Time_Marker = 0;
+
+#if defined(ESP32) && !defined(USE_ARDUINO_WIFI)
+#include <esp_wifi.h>
+
+/*
+ * OpenDroneID Wi-Fi beacons on the current channel. Vendor Specific IE:
+ * ASTM OUI FA-0B-BC, OUI type, message counter, message pack
+ */
+static void RID_WiFi_sniffer(void *buf, wifi_promiscuous_pkt_type_t type)
+{
+  const wifi_promiscuous_pkt_t *pkt = (const wifi_promiscuous_pkt_t *) buf;
+  const uint8_t *frame = pkt->payload;
+  int len = (int) pkt->rx_ctrl.sig_len - 4; /* FCS */
+
+  /* 24 bytes of MAC header and 12 bytes of fixed fields precede the IEs */
+  if (type != WIFI_PKT_MGMT || len < 36 || frame[0] != 0x80 /* beacon */) {
+    return;
+  }
+
+  for (int i = 36; i + 2 <= len && i + 2 + frame[i + 1] <= len; i += 2 + frame[i + 1]) {
+    const uint8_t *ie = frame + i;
+
+    if (ie[0] == 221 && ie[1] > 5 &&
+        ie[2] == 0xFA && ie[3] == 0x0B && ie[4] == 0xBC &&
+        ie[5] == RID_ODID_APP_CODE) {
+      rid_receive(frame + 10 /* TA */, ie + 7, ie[1] - 5, pkt->rx_ctrl.rssi);
+      return;
+    }
+  }
+}
+#endif /* ESP32 */
 #endif /* ENABLE_REMOTE_ID */
 
-size_t Raw_Receive_UDP(uint8_t *buf)
+static uint8_t  Raw_Rx_Batch[UDP_PACKET_BUFSIZE];
+static size_t   Raw_Rx_Size   = 0;
+static size_t   Raw_Rx_Offset = 0;
+static uint8_t  Raw_Rx_Count  = 0;
+static unsigned long Raw_Rx_Marker = 0;
+
+static uint8_t  Raw_Tx_Batch[UDP_PACKET_BUFSIZE];
+static size_t   Raw_Tx_Size   = 0;
+static unsigned long Raw_Tx_Marker = 0;
+
+/* 'marker' is set to the time the frame has arrived, ms since boot */
+size_t Raw_Receive_UDP(uint8_t *buf, unsigned long *marker)
 {
-  int noBytes;
-  if (Uni_Udp && (noBytes = Uni_Udp->parsePacket())) {
+  if (Raw_Rx_Count == 0) {
+    int noBytes;
+
+    if (!Uni_Udp || (noBytes = Uni_Udp->parsePacket()) <= 0) {
+      return 0;
+    }
 
-    if (noBytes > MAX_PKT_SIZE) {
-      noBytes = MAX_PKT_SIZE;
+    if (noBytes > (int) sizeof(Raw_Rx_Batch)) {
+      noBytes = sizeof(Raw_Rx_Batch);
     }
 
     // We've received a packet, read the data from it
-    Uni_Udp->read(buf,noBytes); // read the packet into the buffer
+    noBytes = Uni_Udp->read(Raw_Rx_Batch, noBytes);
+    Raw_Rx_Marker = *marker = millis();
+
+    if (noBytes < RAW_UDP_HDR_SIZE                ||
+        Raw_Rx_Batch[0] != RAW_UDP_MAGIC0         ||
+        Raw_Rx_Batch[1] != RAW_UDP_MAGIC1         ||
+        Raw_Rx_Batch[2] != RAW_UDP_VERSION) {
+      /* not a batch - take the whole datagram as a single raw frame */
+      if (noBytes > MAX_PKT_SIZE) {
+        noBytes = MAX_PKT_SIZE;
+      }
+      memcpy(buf, Raw_Rx_Batch, noBytes > 0 ? noBytes : 0);
+
+      return noBytes > 0 ? (size_t) noBytes : 0;
+    }
+
+    Raw_Rx_Size   = noBytes;
+    Raw_Rx_Offset = RAW_UDP_HDR_SIZE;
+    Raw_Rx_Count  = Raw_Rx_Batch[3];
+  }
 
-    return (size_t) noBytes;
-  } else {
-    return 0;
+  /* the rest of a batch that waited behind a held frame is history */
+  if (millis() - Raw_Rx_Marker > RAW_UDP_MAX_AGE_MS) {
+    Raw_Rx_Count = 0;
+  }
+
+  while (Raw_Rx_Count > 0) {
+    Raw_Rx_Count--;
+
+    if (Raw_Rx_Offset + RAW_UDP_REC_SIZE > Raw_Rx_Size) {
+      break;
+    }
+
+    uint8_t *rec   = &Raw_Rx_Batch[Raw_Rx_Offset];
+    uint8_t length = rec[RAW_UDP_REC_SIZE - 1];
+
+    if (Raw_Rx_Offset + RAW_UDP_REC_SIZE + length > Raw_Rx_Size) {
+      break;
+    }
+
+    Raw_Rx_Offset += RAW_UDP_REC_SIZE + length;
+
+    /* frames of other protocols can not be transmitted by our radio */
+    if (rec[0] != settings->rf_protocol || length == 0) {
+      continue;
+    }
+
+    if (length > MAX_PKT_SIZE) {
+      length = MAX_PKT_SIZE;
+    }
+    memcpy(buf, rec + RAW_UDP_REC_SIZE, length);
+    *marker = Raw_Rx_Marker;
+
+    return length;
+  }
+
+  Raw_Rx_Count = 0;
+
+  return 0;
+}
+
+static void Raw_Send_UDP()
+{
+  if (Raw_Tx_Size > RAW_UDP_HDR_SIZE) {
+    SoC->WiFi_transmit_UDP(RELAY_DST_PORT, Raw_Tx_Batch, Raw_Tx_Size);
+  }
+  Raw_Tx_Size = 0;
+}
+
+void Raw_Flush_UDP()
+{
+  if (Raw_Tx_Size > 0 && millis() - Raw_Tx_Marker > RAW_UDP_BATCH_MS) {
+    Raw_Send_UDP();
   }
 }
 
@@ -99,12 +213,38 @@ void Raw_Transmit_UDP()
 {
     size_t rx_size = RF_Payload_Size(settings->rf_protocol);
     rx_size = rx_size > sizeof(fo.raw) ? sizeof(fo.raw) : rx_size;
-    String str = Bin2Hex(fo.raw, rx_size);
-    size_t len = str.length();
-    // ASSERT(sizeof(UDPpacketBuffer) > 2 * PKT_SIZE + 1)
-    str.toCharArray(UDPpacketBuffer, sizeof(UDPpacketBuffer));
-    UDPpacketBuffer[len] = '\n';
-    SoC->WiFi_transmit_UDP(RELAY_DST_PORT, (byte *)UDPpacketBuffer, len + 1);
+
+    if (Raw_Tx_Size > 0 &&
+        (Raw_Tx_Size + RAW_UDP_REC_SIZE + rx_size > sizeof(Raw_Tx_Batch) ||
+         Raw_Tx_Batch[3] == UINT8_MAX)) {
+      Raw_Send_UDP();
+    }
+
+    if (Raw_Tx_Size == 0) {
+      Raw_Tx_Batch[0] = RAW_UDP_MAGIC0;
+      Raw_Tx_Batch[1] = RAW_UDP_MAGIC1;
+      Raw_Tx_Batch[2] = RAW_UDP_VERSION;
+      Raw_Tx_Batch[3] = 0;
+      Raw_Tx_Size   = RAW_UDP_HDR_SIZE;
+      Raw_Tx_Marker = millis();
+    }
+
+    uint8_t *rec = &Raw_Tx_Batch[Raw_Tx_Size];
+    uint32_t timestamp = (uint32_t) now();
+
+    rec[0] = settings->rf_protocol;
+    rec[1] = (uint8_t) RF_last_rssi;
+    rec[2] = timestamp;
+    rec[3] = timestamp >> 8;
+    rec[4] = timestamp >> 16;
+    rec[5] = timestamp >> 24;
+    rec[6] = rx_size;
+    memcpy(rec + RAW_UDP_REC_SIZE, fo.raw, rx_size);
+
+    Raw_Tx_Size += RAW_UDP_REC_SIZE + rx_size;
+    Raw_Tx_Batch[3]++;
+
+    Raw_Flush_UDP();
 }
 
 #if defined(USE_ARDUINO_WIFI)
@@ -310,6 +450,16 @@ void WiFi_setup()
 #if defined(ENABLE_REMOTE_ID)
   rid_init();
   RID_Time_Marker = millis();
+
+#if defined(ESP32)
+  /* the sniffer costs CPU and AP throughput - only with Remote ID on */
+  if (rid_enabled()) {
+    wifi_promiscuous_filter_t RID_filter = { .filter_mask = WIFI_PROMIS_FILTER_MASK_MGMT };
+    esp_wifi_set_promiscuous_filter(&RID_filter);
+    esp_wifi_set_promiscuous_rx_cb(&RID_WiFi_sniffer);
+    esp_wifi_set_promiscuous(true);
+  }
+#endif /* ESP32 */
 #endif /* ENABLE_REMOTE_ID */
 }
 #endif /* USE_ARDUINO_WIFI */
@@ -349,6 +499,8 @@ void WiFi_loop()
       RID_Time_Marker = millis();
     }
   }
+
+  rid_loop();
 #endif /* ENABLE_REMOTE_ID */
 }
 
@@ -363,6 +515,11 @@ void WiFi_fini()
   WiFi.endAP();
 #endif /* _WIFI_ESP_AT_H_ */
 #else
+#if defined(ENABLE_REMOTE_ID) && defined(ESP32)
+  if (rid_enabled()) {
+    esp_wifi_set_promiscuous(false);
+  }
+#endif /* ENABLE_REMOTE_ID */
   WiFi.mode(WIFI_OFF);
 #endif /* USE_ARDUINO_WIFI */
 }
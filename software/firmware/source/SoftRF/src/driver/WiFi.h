@@ -34,6 +34,19 @@
 #endif
 #define WIFI_DHCP_LEASE_HRS 8
 
+/*
+ * Bridge mode UDP datagram:
+ *   'S' 'R' <version> <count>, then <count> records of
+ *   <protocol> <rssi> <timestamp, 4 bytes LE> <length> <length raw bytes>
+ */
+#define RAW_UDP_MAGIC0      'S'
+#define RAW_UDP_MAGIC1      'R'
+#define RAW_UDP_VERSION     1
+#define RAW_UDP_HDR_SIZE    4
+#define RAW_UDP_REC_SIZE    7
+#define RAW_UDP_BATCH_MS    50 /* max. delay of a frame in a batch */
+#define RAW_UDP_MAX_AGE_MS  1500 /* older frames carry a stale position */
+
 enum
 {
     WIFI_PARAM_TX_POWER,
@@ -49,8 +62,9 @@ enum
 
 void WiFi_setup(void);
 void WiFi_loop(void);
-size_t Raw_Receive_UDP(uint8_t *);
+size_t Raw_Receive_UDP(uint8_t *, unsigned long *);
 void Raw_Transmit_UDP(void);
+void Raw_Flush_UDP(void);
 void WiFi_fini(void);
 
 extern String host_name;
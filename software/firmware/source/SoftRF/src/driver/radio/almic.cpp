@@ -31,6 +31,7 @@
 #include "../Battery.h"
 
 extern size_t RF_tx_size;
+extern size_t RF_rx_size;
 
 static bool sx1276_probe(void);
 static bool sx1262_probe(void);
@@ -442,6 +443,7 @@ static bool sx12xx_receive()
         RxBuffer[i] = LMIC.frame[i + LMIC.protocol->payload_offset];
     }
 
+    RF_rx_size   = size;
     RF_last_rssi = LMIC.rssi;
     rx_packets_counter++;
     success = true;
@@ -623,7 +625,8 @@ static void sx12xx_rx_func (osjob_t* job) {
     break;
   case RF_CHECKSUM_TYPE_CRC_MODES:
 #if defined(ENABLE_ADSL)
-    if (ADSL_Packet::checkPI((uint8_t  *) &LMIC.frame[0], LMIC.dataLen)) {
+    /* repairs up to 2 bit errors in place */
+    if (ADSL_Packet::Repair((uint8_t  *) &LMIC.frame[0], LMIC.dataLen) < 0) {
       sx12xx_receive_complete = false;
     } else
 #endif /* ENABLE_ADSL */
@@ -192,7 +192,8 @@ void cc13xx_Receive_callback(EasyLink_RxPacket *rxPacket_ptr, EasyLink_Status st
           break;
         case RF_CHECKSUM_TYPE_CRC_MODES:
 #if defined(ENABLE_ADSL)
-          if (ADSL_Packet::checkPI((uint8_t  *) &RxBuffer[0], size) == 0) {
+          /* repairs up to 2 bit errors in place */
+          if (ADSL_Packet::Repair((uint8_t  *) &RxBuffer[0], size) >= 0) {
             success = true;
           }
 #endif /* ENABLE_ADSL */
@@ -26,6 +26,7 @@
 #include <manchester.h>
 
 extern size_t RF_tx_size;
+extern size_t RF_rx_size;
 
 static bool lr112x_probe(void);
 static void lr112x_setup(void);
@@ -553,14 +554,15 @@ static bool lr112x_receive()
           break;
         case RF_PROTOCOL_FANET:
           offset = rl_protocol->payload_offset;
-          size   = rl_protocol->payload_size + rl_protocol->crc_size;
+          /* variable length frames - explicit LoRa header knows the size */
+          size   = rxPacket_ptr->len > offset ? rxPacket_ptr->len - offset : 0;
+          size   = size > sizeof(RxBuffer) ? sizeof(RxBuffer) : size;
           for (i = 0; i < size; i++)
           {
-            if (i < sizeof(RxBuffer)) {
-              RxBuffer[i] = rxPacket_ptr->payload[i + offset];
-            }
+            RxBuffer[i] = rxPacket_ptr->payload[i + offset];
           }
-          success = true;
+          RF_rx_size = size;
+          success = (size > 0);
           break;
         case RF_PROTOCOL_OGNTP:
         case RF_PROTOCOL_ADSL_860:
@@ -609,7 +611,8 @@ static bool lr112x_receive()
               break;
             case RF_CHECKSUM_TYPE_CRC_MODES:
 #if defined(ENABLE_ADSL)
-              if (ADSL_Packet::checkPI((uint8_t  *) &RxBuffer[0], size) == 0) {
+              /* repairs up to 2 bit errors in place */
+              if (ADSL_Packet::Repair((uint8_t  *) &RxBuffer[0], size) >= 0) {
                 success = true;
               }
 #endif /* ENABLE_ADSL */
@@ -327,7 +327,9 @@ static void ASR66_EEPROM_extension(int cmd)
       ASR66_flash_buf[i] = EEPROM.read(i);
     }
 
-    if (flash_erase_page(_EEPROM_BASE) == ERRNO_OK) {
+    /* flash is memory mapped, erase the page only for a real change */
+    if (memcmp((const void *) (_EEPROM_BASE), ASR66_flash_buf, sizeof(eeprom_t)) &&
+        flash_erase_page(_EEPROM_BASE) == ERRNO_OK) {
       flash_program_bytes(_EEPROM_BASE, ASR66_flash_buf, sizeof(eeprom_t));
     }
   }
@@ -130,6 +130,7 @@ struct rst_info {
 #define EXCLUDE_TEST_MODE
 #define EXCLUDE_WATCHOUT_MODE
 #define EXCLUDE_TRAFFIC_FILTER_EXTENSION
+#define EXCLUDE_TRAFFIC_EXTRAPOLATION
 #define EXCLUDE_LK8EX1
 
 //#define EXCLUDE_GNSS_UBLOX
@@ -193,6 +193,7 @@ struct rst_info {
 #define EXCLUDE_LK8EX1
 #define EXCLUDE_WATCHOUT_MODE
 #define EXCLUDE_TRAFFIC_FILTER_EXTENSION
+#define EXCLUDE_TRAFFIC_EXTRAPOLATION
 #define EXCLUDE_LOG_GNSS_VERSION
 #define EXCLUDE_IMU
 #define EXCLUDE_AIR6
@@ -344,6 +344,10 @@ struct rst_info {
 #define USE_OGN_ENCRYPTION
 #define ENABLE_PROL
 #define ENABLE_ADSL
+#define ENABLE_PROFILER
+#if !defined(CONFIG_FREERTOS_UNICORE)
+#define ENABLE_RF_TASK
+#endif /* CONFIG_FREERTOS_UNICORE */
 
 //#define EXCLUDE_GNSS_UBLOX    /* Neo-6/7/8, M10 */
 //#define ENABLE_UBLOX_RFS        /* revert factory settings (when necessary)  */
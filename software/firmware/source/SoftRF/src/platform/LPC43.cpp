@@ -730,6 +730,8 @@ void once_per_second_task_CPP(void)
     }
   }
 
+  Traffic_Schedule(millis());
+
   NMEA_Export();
   GDL90_Export();
 
@@ -64,6 +64,9 @@
 #include "../driver/Battery.h"
 #include "../driver/Bluetooth.h"
 #include "../system/Time.h"
+#include "../system/Profiler.h"
+#include "../system/Relay.h"
+#include "../protocol/data/FISB.h"
 
 #include "TCPServer.h"
 
@@ -71,6 +74,7 @@
 #include <sys/select.h>
 
 #include <iostream>
+#include <fstream>
 
 #include <ArduinoJson.h>
 
@@ -143,13 +147,18 @@ hardware_info_t hw_info = {
   .pmu      = PMU_NONE,
 };
 
-#define isTimeToExport() (millis() - ExportTimeMarker > 1000)
+#define isTimeToExport() (millis() - ExportTimeMarker > EXPORT_INTERVAL_FAST_MS)
 unsigned long ExportTimeMarker = 0;
 
 std::string input_line;
 
 TCPServer Traffic_TCP_Server;
 
+/* offline replay of a recorded session, see RPi_Replay() */
+static const char *RPi_ReplayFile   = NULL;
+static int         RPi_ReplayPasses = 1;
+static bool        RPi_ReplayQuiet  = false;
+
 #if defined(USE_EPAPER)
 GxEPD2_BW<GxEPD2_270, GxEPD2_270::HEIGHT> __attribute__ ((common)) epd_waveshare_W3(GxEPD2_270(/*CS=5*/ 8,
                                        /*DC=*/ 25, /*RST=*/ 17, /*BUSY=*/ 24));
@@ -299,7 +308,10 @@ static void RPi_setup()
 
   ui = &ui_settings;
 
-  RPi_SerialNumber();
+  /* off-target replay host has no VideoCore mailbox */
+  if (RPi_ReplayFile == NULL) {
+    RPi_SerialNumber();
+  }
 }
 
 static void RPi_post_init()
@@ -603,6 +615,29 @@ static bool inputAvailable()
   return (FD_ISSET(0, &fds));
 }
 
+static void RPi_ApplyGNSSFix()
+{
+  ThisAircraft.latitude = gnss.location.lat();
+  ThisAircraft.longitude = gnss.location.lng();
+  ThisAircraft.altitude = gnss.altitude.meters();
+  ThisAircraft.course = gnss.course.deg();
+  ThisAircraft.speed = gnss.speed.knots();
+  ThisAircraft.hdop = (uint16_t) gnss.hdop.value();
+  ThisAircraft.geoid_separation = gnss.separation.meters();
+
+  /*
+   * When geoidal separation is zero or not available - use approx. EGM96 value
+   */
+  if (ThisAircraft.geoid_separation == 0.0) {
+    ThisAircraft.geoid_separation = (float) LookupSeparation(
+                                              ThisAircraft.latitude,
+                                              ThisAircraft.longitude
+                                            );
+    /* we can assume the GPS unit is giving ellipsoid height */
+    ThisAircraft.altitude -= ThisAircraft.geoid_separation;
+  }
+}
+
 static void parseNMEA(const char *str, int len)
 {
   // NMEA input
@@ -610,31 +645,13 @@ static void parseNMEA(const char *str, int len)
     gnss.encode(str[i]);
   }
   if (settings->nmea_g) {
-    NMEA_Out(settings->nmea_out, (byte *) str, len, true);
+    NMEA_Passthrough(settings->nmea_out, (byte *) str, len, true);
   }
 
   GNSSTimeSync();
 
   if (isValidGNSSFix()) {
-    ThisAircraft.latitude = gnss.location.lat();
-    ThisAircraft.longitude = gnss.location.lng();
-    ThisAircraft.altitude = gnss.altitude.meters();
-    ThisAircraft.course = gnss.course.deg();
-    ThisAircraft.speed = gnss.speed.knots();
-    ThisAircraft.hdop = (uint16_t) gnss.hdop.value();
-    ThisAircraft.geoid_separation = gnss.separation.meters();
-
-    /*
-     * When geoidal separation is zero or not available - use approx. EGM96 value
-     */
-    if (ThisAircraft.geoid_separation == 0.0) {
-      ThisAircraft.geoid_separation = (float) LookupSeparation(
-                                                ThisAircraft.latitude,
-                                                ThisAircraft.longitude
-                                              );
-      /* we can assume the GPS unit is giving ellipsoid height */
-      ThisAircraft.altitude -= ThisAircraft.geoid_separation;
-    }
+    RPi_ApplyGNSSFix();
   }
 }
 
@@ -649,6 +666,10 @@ static void RPi_PickGNSSFix()
       // NMEA input
       parseNMEA(str, len);
 
+    } else if (str[0] == '+') {
+      // UAT ground uplink, 'dump978' raw output format
+      FISB_Uplink_Hex(str + 1);
+
     } else if (str[0] == '{') {
       // JSON input
 
@@ -666,6 +687,7 @@ static void RPi_PickGNSSFix()
 
           RF_setup();
           Traffic_setup();
+          Relay_setup();
         }
       }
 
@@ -712,6 +734,7 @@ static void RPi_ReadTraffic()
 
           RF_setup();
           Traffic_setup();
+          Relay_setup();
         }
       }
 
@@ -735,12 +758,24 @@ static void RPi_ReadTraffic()
       }
 
       jsonBuffer.clear();
+    } else if (str[0] == '+') {
+      // UAT ground uplink, 'dump978' raw output format
+      FISB_Uplink_Hex(str + 1);
     } else if (str[0] == 'q') {
       if (len >= 4 && str[1] == 'u' && str[2] == 'i' && str[3] == 't') {
         Traffic_TCP_Server.detach();
         fprintf( stderr, "Program termination.\n" );
         exit(EXIT_SUCCESS);
       }
+#if defined(ENABLE_PROFILER)
+    } else if (str[0] == 'p') {
+      if (len >= 4 && str[1] == 'e' && str[2] == 'r' && str[3] == 'f') {
+        char buffer[PROFILER_JSON_SIZE];
+
+        Profiler_JSON(buffer, sizeof(buffer));
+        Serial.println(buffer);
+      }
+#endif /* ENABLE_PROFILER */
     }
 
     Traffic_TCP_Server.clean();
@@ -774,13 +809,17 @@ void normal_loop()
     }
 
     if (isTimeToExport()) {
+      bool full = Traffic_Schedule(millis());
 
       NMEA_Export();
       GDL90_Export();
-      D1090_Export();
 
-      if (isValidFix()) {
-        JSON_Export();
+      if (full) {
+        D1090_Export();
+
+        if (isValidFix()) {
+          JSON_Export();
+        }
       }
       ExportTimeMarker = millis();
     }
@@ -788,7 +827,9 @@ void normal_loop()
     // Handle Air Connect
     NMEA_loop();
 
+    PROFILE_BEGIN(PROBE_DISPLAY_LOOP);
     SoC->Display_loop();
+    PROFILE_END(PROBE_DISPLAY_LOOP);
 
     ClearExpired();
 }
@@ -805,51 +846,11 @@ void relay_loop()
 
     RF_loop();
 
-    for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
-      size_t size = RF_Payload_Size(settings->rf_protocol);
-      size = size > sizeof(Container[i].raw) ? sizeof(Container[i].raw) : size;
-
-      if (memcmp (Container[i].raw, EmptyFO.raw, size) != 0) {
-        // Raw data
-        size_t tx_size = sizeof(TxBuffer) > size ? size : sizeof(TxBuffer);
-        memcpy(TxBuffer, Container[i].raw, tx_size);
-
-        if (tx_size > 0) {
-          /* Follow duty cycle rule */
-          if (RF_Transmit(tx_size, true /* false */)) {
-#if 0
-            String str = Bin2Hex(TxBuffer, tx_size);
-            printf("%s\n", str.c_str());
-#endif
-            Container[i] = EmptyFO;
-          }
-        }
-      } else if (isValidFix() &&
-                 Container[i].addr &&
-                 Container[i].latitude  != 0.0 &&
-                 Container[i].longitude != 0.0 &&
-                 Container[i].altitude  != 0.0 &&
-                 Container[i].distance < (ALARM_ZONE_NONE * 2) ) {
-
-        fo = Container[i];
-        fo.timestamp = now(); /* GNSS date&time */
-
-        /* Follow duty cycle rule */
-        if (RF_Transmit(RF_Encode(&fo), true /* false */)) {
-#if 0
-          printf("%06X %f %f %f %d %d %d\n",
-              fo.addr,
-              fo.latitude,
-              fo.longitude,
-              fo.altitude,
-              fo.addr_type,
-              (int) fo.vs,
-              fo.aircraft_type);
-#endif
-          Container[i] = EmptyFO;
-        }
-      }
+    if (RF_Receive()) {
+      Relay_Heard(RxBuffer, RF_Payload_Size(settings->rf_protocol));
     }
+
+    Relay_loop();
 }
 
 unsigned int pos_ndx = 0;
@@ -858,13 +859,6 @@ unsigned long TxPosUpdMarker = 0;
 void txrx_test_loop()
 {
   bool success = false;
-#if DEBUG_TIMING
-  unsigned long baro_start_ms, baro_end_ms;
-  unsigned long tx_start_ms, tx_end_ms, rx_start_ms, rx_end_ms;
-  unsigned long parse_start_ms, parse_end_ms, led_start_ms, led_end_ms;
-  unsigned long export_start_ms, export_end_ms;
-  unsigned long oled_start_ms, oled_end_ms;
-#endif
 
   setTime(time(NULL));
 
@@ -886,72 +880,27 @@ void txrx_test_loop()
   ThisAircraft.speed = TXRX_TEST_SPEED;
   ThisAircraft.vs = TXRX_TEST_VS;
 
-#if DEBUG_TIMING
-  tx_start_ms = millis();
-#endif
-
   RF_Transmit(RF_Encode(&ThisAircraft), true);
 
-#if DEBUG_TIMING
-  tx_end_ms = millis();
-  rx_start_ms = millis();
-#endif
   success = RF_Receive();
-#if DEBUG_TIMING
-  rx_end_ms = millis();
-#endif
 
-#if DEBUG_TIMING
-  parse_start_ms = millis();
-#endif
   if (success) ParseData();
-#if DEBUG_TIMING
-  parse_end_ms = millis();
-#endif
 
   Traffic_loop();
 
-#if DEBUG_TIMING
-  export_start_ms = millis();
-#endif
   if (isTimeToExport()) {
-    NMEA_Position();
+    bool full = Traffic_Schedule(millis());
+
+    if (full) {
+      NMEA_Position();
+    }
     NMEA_Export();
     GDL90_Export();
-    D1090_Export();
+    if (full) {
+      D1090_Export();
+    }
     ExportTimeMarker = millis();
   }
-#if DEBUG_TIMING
-  export_end_ms = millis();
-#endif
-
-#if DEBUG_TIMING
-  if (tx_end_ms - tx_start_ms) {
-    Serial.print(F("TX start: "));
-    Serial.print(tx_start_ms);
-    Serial.print(F(" TX stop: "));
-    Serial.println(tx_end_ms);
-  }
-  if (rx_end_ms - rx_start_ms) {
-    Serial.print(F("RX start: "));
-    Serial.print(rx_start_ms);
-    Serial.print(F(" RX stop: "));
-    Serial.println(rx_end_ms);
-  }
-  if (parse_end_ms - parse_start_ms) {
-    Serial.print(F("Parse start: "));
-    Serial.print(parse_start_ms);
-    Serial.print(F(" Parse stop: "));
-    Serial.println(parse_end_ms);
-  }
-
-  if (export_end_ms - export_start_ms) {
-    Serial.print(F("Export start: "));
-    Serial.print(export_start_ms);
-    Serial.print(F(" Export stop: "));
-    Serial.println(export_end_ms);
-  }
-#endif
 
   // Handle Air Connect
   NMEA_loop();
@@ -1001,15 +950,395 @@ void on_msg(mode_s_t *self, struct mode_s_msg *mm) {
     }
 }
 
-int main()
+/*
+ * Offline replay and throughput benchmark.
+ *
+ *  $ ./SoftRF -r session.log [-n passes] [-q]
+ *
+ * Each line of the capture file is one of:
+ *  - "$PSRFI,<time>,<hex>,<rssi>" raw frame, as emitted by ParseData() with nmea_p on
+ *  - "$G..." NMEA sentence of own GNSS track
+ *  - "+<hex>;..." UAT ground uplink frame, as emitted by 'dump978'
+ *  - JSON object: SOFTRF settings, GPSD TPV, dump1090 'aircraft.json' or PingStation
+ *
+ * Lines are fed through protocol_decode, Traffic_Update/Add, alarm evaluation
+ * and all the exporters as fast as the host is able to. The replay clock is driven
+ * by timestamps of the capture, so exporters fire once per second of recorded time.
+ * Statistics go to stderr, exporters output - to stdout (unless -q is given).
+ */
+
+enum
+{
+  REPLAY_SINK_NMEA,
+  REPLAY_SINK_GDL90,
+  REPLAY_SINK_D1090,
+  REPLAY_SINK_JSON,
+  REPLAY_SINK_COUNT
+};
+
+static const char *Replay_Sink_Name[] = {
+  [REPLAY_SINK_NMEA]  = "NMEA",
+  [REPLAY_SINK_GDL90] = "GDL90",
+  [REPLAY_SINK_D1090] = "D1090",
+  [REPLAY_SINK_JSON]  = "JSON",
+};
+
+typedef struct replay_stats_struct {
+  uint32_t lines;
+  uint32_t frames;
+  uint32_t decoded;
+  uint32_t nmea;
+  uint32_t json;
+  uint32_t uplinks;
+  uint32_t errors;
+  uint32_t exports;
+  uint64_t bytes[REPLAY_SINK_COUNT];
+} replay_stats_t;
+
+static replay_stats_t Replay_Stats;
+static FILE          *Replay_stdout    = NULL;
+static uint64_t       Replay_out_bytes = 0;
+
+/*
+ * Every exporter on this platform ends up in stdio's stdout,
+ * so a counting stream in place of it gives exact output volume per sink
+ */
+static ssize_t Replay_stdout_write(void *cookie, const char *buf, size_t size)
+{
+  Replay_out_bytes += size;
+  if (!RPi_ReplayQuiet) {
+    fwrite(buf, 1, size, Replay_stdout);
+  }
+  return size;
+}
+
+static void Replay_Export(void (*exporter)(void), uint8_t sink)
+{
+  fflush(stdout);
+  uint64_t before = Replay_out_bytes;
+
+  (*exporter)();
+
+  fflush(stdout);
+  Replay_Stats.bytes[sink] += Replay_out_bytes - before;
+}
+
+static void Replay_Protocol_setup()
 {
-  // Init GPIO bcm
-  if (!bcm2835_init()) {
-      fprintf( stderr, "bcm2835_init() Failed\n\n" );
+  switch (settings->rf_protocol)
+  {
+  case RF_PROTOCOL_OGNTP:     protocol_decode = &ogntp_decode;  break;
+  case RF_PROTOCOL_P3I:       protocol_decode = &p3i_decode;    break;
+  case RF_PROTOCOL_FANET:     protocol_decode = &fanet_decode;  break;
+  case RF_PROTOCOL_ADSB_UAT:  protocol_decode = &uat978_decode; break;
+#if defined(ENABLE_ADSL)
+  case RF_PROTOCOL_ADSL_860:  protocol_decode = &adsl_decode;   break;
+#endif /* ENABLE_ADSL */
+  case RF_PROTOCOL_LEGACY:
+  default:                    protocol_decode = &legacy_decode; break;
+  }
+}
+
+extern size_t RF_rx_size;
+
+static bool Replay_Frame(const char *str)
+{
+  /* $PSRFI,<time>,<hex>,<rssi> */
+  char *ptr;
+  unsigned long timestamp = strtoul(str + 7, &ptr, 10);
+
+  if (*ptr != ',' || timestamp == 0) {
+    return false;
+  }
+  ptr++;
+
+  size_t size = 0;
+  memset(RxBuffer, 0, sizeof(RxBuffer));
+
+  while (isxdigit(ptr[0]) && isxdigit(ptr[1]) && size < sizeof(RxBuffer)) {
+    RxBuffer[size++] = (getVal(ptr[0]) << 4) + getVal(ptr[1]);
+    ptr += 2;
+  }
+
+  if (size == 0) {
+    return false;
+  }
+
+  RF_rx_size   = size;
+  RF_last_rssi = (*ptr == ',') ? atoi(ptr + 1) : 0;
+
+  setTime((time_t) timestamp);
+  ThisAircraft.timestamp = now();
+
+  rx_packets_counter++;
+  Replay_Stats.frames++;
+
+  if (isValidFix() && ParseData()) {
+    Replay_Stats.decoded++;
+  }
+
+  return true;
+}
+
+static bool Replay_NMEA(const char *str, int len)
+{
+  parseNMEA(str, len);
+  gnss.encode('\r'); /* end of sentence, stripped by the line reader */
+
+  /*
+   * GNSS_loop() is not in use here, so the fix is taken
+   * directly from the parser once it becomes complete
+   */
+  if (gnss.location.isUpdated() && gnss.location.isValid() &&
+      gnss.altitude.isValid()   && gnss.date.isValid()) {
+    if (gnss.time.isValid()) {
+      setTime(gnss.time.hour(), gnss.time.minute(), gnss.time.second(),
+              gnss.date.day(),  gnss.date.month(),  gnss.date.year());
+    }
+    RPi_ApplyGNSSFix();
+    hasValidGPSDFix = true;
+  }
+
+  return true;
+}
+
+static bool Replay_Uplink(const char *str)
+{
+  fflush(stdout);
+  uint64_t before = Replay_out_bytes;
+
+  bool success = FISB_Uplink_Hex(str + 1);
+
+  fflush(stdout);
+  Replay_Stats.bytes[REPLAY_SINK_GDL90] += Replay_out_bytes - before;
+
+  return success;
+}
+
+static bool Replay_JSON(const char *str)
+{
+  JsonObject& root = jsonBuffer.parseObject(str);
+
+  if (!root.success()) {
+    jsonBuffer.clear();
+    return false;
+  }
+
+  JsonVariant msg_class = root["class"];
+
+  if (msg_class.success()) {
+    const char *msg_class_s = msg_class.as<char*>();
+
+    if (!strcmp(msg_class_s,"TPV")) {
+      parseTPV(root);
+    } else if (!strcmp(msg_class_s,"SOFTRF")) {
+      parseSettings(root);
+
+      Replay_Protocol_setup();
+      Traffic_setup();
+    }
+  }
+
+  if (root.containsKey("now") &&
+      root.containsKey("messages") &&
+      root.containsKey("aircraft")) {
+    if (isValidFix()) {
+      parseD1090(root);
+    }
+  } else if (root.containsKey("aircraft")) {
+    if (isValidFix()) {
+      parsePING(root);
+    }
+  }
+
+  jsonBuffer.clear();
+
+  return true;
+}
+
+static void Replay_Report(double elapsed)
+{
+  double fps = elapsed > 0 ? Replay_Stats.frames / elapsed : 0;
+  double lps = elapsed > 0 ? Replay_Stats.lines  / elapsed : 0;
+
+  fprintf(stderr, "\nReplay of %s, %d pass(es):\n", RPi_ReplayFile, RPi_ReplayPasses);
+  fprintf(stderr, "  lines   : %u (NMEA %u, JSON %u, uplink %u, malformed %u)\n",
+          Replay_Stats.lines, Replay_Stats.nmea, Replay_Stats.json,
+          Replay_Stats.uplinks, Replay_Stats.errors);
+  fprintf(stderr, "  frames  : %u, decoded %u\n",
+          Replay_Stats.frames, Replay_Stats.decoded);
+  fprintf(stderr, "  elapsed : %.3f s, %.0f frames/s, %.0f lines/s\n",
+          elapsed, fps, lps);
+  fprintf(stderr, "  exports : %u\n", Replay_Stats.exports);
+
+  if (FISB_Stats.frames > 0) {
+    fprintf(stderr, "  FIS-B   : %u frames (%u bad, %u symbols fixed), %u APDUs: "
+                    "METAR %u, text %u, NEXRAD %u\n",
+            FISB_Stats.frames, FISB_Stats.fec_errors, FISB_Stats.rs_corrected,
+            FISB_Stats.apdus, FISB_Stats.metars, FISB_Stats.text, FISB_Stats.nexrad);
+  }
+
+  for (int i=0; i < REPLAY_SINK_COUNT; i++) {
+    fprintf(stderr, "  %-8s: %" PRIu64 " bytes\n",
+            Replay_Sink_Name[i], Replay_Stats.bytes[i]);
+  }
+
+#if defined(ENABLE_PROFILER)
+  profiler_stats_t stats;
+
+  fprintf(stderr, "  %-16s %8s %8s %8s %8s %8s\n",
+          "stage", "count", "min,us", "avg,us", "max,us", "p99,us");
+  for (uint8_t i=0; i < PROBE_COUNT; i++) {
+    if (Profiler_stats(i, &stats)) {
+      fprintf(stderr, "  %-16s %8u %8u %8u %8u %8u\n", Probe_Name[i],
+              stats.count, stats.min, stats.avg, stats.max, stats.p99);
+    }
+  }
+#endif /* ENABLE_PROFILER */
+}
+
+static int RPi_Replay()
+{
+  std::ifstream capture(RPi_ReplayFile);
+
+  if (!capture.is_open()) {
+    fprintf(stderr, "Unable to open replay file %s\n", RPi_ReplayFile);
+    return EXIT_FAILURE;
+  }
+
+  Replay_stdout = stdout;
+  cookie_io_functions_t funcs = { NULL, Replay_stdout_write, NULL, NULL };
+  FILE *counter = fopencookie(NULL, "w", funcs);
+  if (counter) {
+    setvbuf(counter, NULL, _IOFBF, BUFSIZ);
+    stdout = counter;
+  }
+
+  ThisAircraft.addr = SoC->getChipId() & 0x00FFFFFF;
+
+  Replay_Protocol_setup();
+  Traffic_setup();
+  NMEA_setup();
+
+  memset(&Replay_Stats, 0, sizeof(Replay_Stats));
+  Profiler_reset();
+
+  std::string line;
+  struct timespec start, finish;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+
+  for (int pass=0; pass < RPi_ReplayPasses; pass++) {
+    time_t last_export = 0;
+
+    for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
+      Container[i] = EmptyFO;
+    }
+    hasValidGPSDFix = false;
+
+    capture.clear();
+    capture.seekg(0);
+
+    while (std::getline(capture, line)) {
+      const char *str = line.c_str();
+      int len = line.length();
+      bool success = false;
+
+      if (len > 0 && str[len-1] == '\r') {
+        line.erase(--len);
+        str = line.c_str();
+      }
+
+      if (len == 0) {
+        continue;
+      }
+
+      Replay_Stats.lines++;
+
+      if (!strncmp(str, "$PSRFI,", 7)) {
+        success = Replay_Frame(str);
+      } else if (str[0] == '$' && str[1] == 'G') {
+        success = Replay_NMEA(str, len);
+        Replay_Stats.nmea++;
+      } else if (str[0] == '{') {
+        success = Replay_JSON(str);
+        Replay_Stats.json++;
+      } else if (str[0] == '+') {
+        success = Replay_Uplink(str);
+        Replay_Stats.uplinks++;
+      }
+
+      if (!success) {
+        Replay_Stats.errors++;
+        continue;
+      }
+
+      ThisAircraft.timestamp = now();
+
+      if (!isValidFix()) {
+        continue;
+      }
+
+      if (ThisAircraft.timestamp != last_export) {
+        /* replay clock has advanced - run the periodic work */
+        UpdateTrafficTimeMarker = millis() - TRAFFIC_UPDATE_INTERVAL_MS - 1;
+        Traffic_loop();
+
+        Traffic_Schedule((unsigned long) ThisAircraft.timestamp * 1000);
+
+        Replay_Export(NMEA_Export,  REPLAY_SINK_NMEA);
+        Replay_Export(GDL90_Export, REPLAY_SINK_GDL90);
+        Replay_Export(D1090_Export, REPLAY_SINK_D1090);
+        Replay_Export(JSON_Export,  REPLAY_SINK_JSON);
+
+        Replay_Stats.exports++;
+        last_export = ThisAircraft.timestamp;
+
+        ClearExpired();
+      }
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &finish);
+  fflush(stdout);
+
+  Replay_Report((finish.tv_sec  - start.tv_sec) +
+                (finish.tv_nsec - start.tv_nsec) / 1e9);
+
+  return EXIT_SUCCESS;
+}
+
+int main(int argc, char *argv[])
+{
+  int opt;
+
+  while ((opt = getopt(argc, argv, "r:n:q")) != -1) {
+    switch (opt)
+    {
+    case 'r':
+      RPi_ReplayFile = optarg;
+      break;
+    case 'n':
+      RPi_ReplayPasses = atoi(optarg) > 0 ? atoi(optarg) : 1;
+      break;
+    case 'q':
+      RPi_ReplayQuiet = true;
+      break;
+    default:
+      fprintf(stderr, "Usage: %s [-r replay_file [-n passes] [-q]]\n", argv[0]);
       exit(EXIT_FAILURE);
+    }
   }
 
-  Serial.begin(SERIAL_OUT_BR);
+  if (RPi_ReplayFile == NULL) {
+    // Init GPIO bcm
+    if (!bcm2835_init()) {
+        fprintf( stderr, "bcm2835_init() Failed\n\n" );
+        exit(EXIT_FAILURE);
+    }
+
+    /* also drives NSS pin of the radio, so no GPIO - no Serial.begin() */
+    Serial.begin(SERIAL_OUT_BR);
+  }
 
   hw_info.soc = SoC_setup(); // Has to be very first procedure in the execution order
 
@@ -1021,8 +1350,14 @@ int main()
   Serial.println(F("Copyright (C) 2015-2024 Linar Yusupov. All rights reserved."));
   Serial.flush();
 
+  Profiler_setup();
+
   mode_s_init(&state);
 
+  if (RPi_ReplayFile) {
+    exit(RPi_Replay());
+  }
+
 #if defined(ENABLE_RTLSDR) || defined(ENABLE_HACKRF) || defined(ENABLE_MIRISDR)
   sdrInitConfig();
 
@@ -1088,6 +1423,7 @@ int main()
 //  hw_info.gnss = GNSS_setup();
 
   Traffic_setup();
+  Relay_setup();
   NMEA_setup();
 
   Traffic_TCP_Server.setup(JSON_SRV_TCP_PORT);
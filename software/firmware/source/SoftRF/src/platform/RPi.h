@@ -136,7 +136,9 @@ extern const char *Hardware_Rev[];
 
 /* Experimental */
 #define ENABLE_ADSL
+#define ENABLE_FISB
 //#define ENABLE_PROL
+#define ENABLE_PROFILER
 
 //#define USE_OGN_RF_DRIVER
 //#define WITH_RFM95
@@ -226,6 +226,7 @@ typedef struct stm32_backup_struct {
 #define EXCLUDE_IMU
 #define EXCLUDE_MAG
 #define EXCLUDE_TRAFFIC_FILTER_EXTENSION
+#define EXCLUDE_TRAFFIC_EXTRAPOLATION
 #define EXCLUDE_AIR7             //  -1.8 kb
 //#define USE_OGN_RF_DRIVER
 //#define WITH_RFM95
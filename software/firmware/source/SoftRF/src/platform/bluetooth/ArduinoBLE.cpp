@@ -42,7 +42,6 @@ RingBufferN<BLE_FIFO_RX_SIZE> BLE_FIFO_RX = RingBufferN<BLE_FIFO_RX_SIZE>();
 
 String BT_name = HOSTNAME;
 
-static unsigned long BLE_Notify_TimeMarker = 0;
 static unsigned long BLE_Advertising_TimeMarker = 0;
 
 BLEService UARTService(UART_SERVICE_UUID16);
@@ -189,20 +188,27 @@ static void RA4M1_Bluetooth_loop()
     {
       BLE.poll();
 
-      if (deviceConnected && (millis() - BLE_Notify_TimeMarker > 10)) { /* < 18000 baud */
+      /*
+       * Back to back - HCI layer waits for the controller's buffer
+       * credits by itself. ArduinoBLE fixes the value length at
+       * creation time, 20 bytes fit into any negotiated MTU.
+       */
+      if (deviceConnected) {
           uint8_t chunk[BLE_MAX_WRITE_CHUNK_SIZE];
 
-          size_t size = BLE_FIFO_TX.available();
-          size = size < BLE_MAX_WRITE_CHUNK_SIZE ? size : BLE_MAX_WRITE_CHUNK_SIZE;
+          for (int n=0; n < BLE_NOTIFY_BURST; n++) {
+            size_t size = BLE_FIFO_TX.available();
+            size = size < BLE_MAX_WRITE_CHUNK_SIZE ? size : BLE_MAX_WRITE_CHUNK_SIZE;
+
+            if (size == 0) {
+              break;
+            }
 
-          if (size > 0) {
             for (int i=0; i < size; i++) {
               chunk[i] = BLE_FIFO_TX.read_char();
             }
             UARTCharacteristic.writeValue(chunk, size);
           }
-
-          BLE_Notify_TimeMarker = millis();
       }
       // disconnecting
       if (!deviceConnected && oldDeviceConnected && (millis() - BLE_Advertising_TimeMarker > 500) ) {
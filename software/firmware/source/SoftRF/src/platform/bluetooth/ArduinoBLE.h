@@ -38,6 +38,7 @@
 #define BLE_FIFO_RX_SIZE          128 /* TBD */
 
 #define BLE_MAX_WRITE_CHUNK_SIZE  20
+#define BLE_NOTIFY_BURST          8   /* notifications per loop() pass, at most */
 
 extern IODev_ops_t RA4M1_Bluetooth_ops;
 
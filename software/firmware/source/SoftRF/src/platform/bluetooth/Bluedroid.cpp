@@ -78,9 +78,12 @@ SoundData *sound_data = new OneChannelSoundData((int16_t*)piano16bit_raw, piano1
 
 String BT_name = HOSTNAME;
 
-static unsigned long BLE_Notify_TimeMarker = 0;
 static unsigned long BLE_Advertising_TimeMarker = 0;
 
+/* updated from the GATT server task */
+static volatile uint16_t BLE_Notify_Size      = BLE_MAX_WRITE_CHUNK_SIZE;
+static volatile bool     BLE_Notify_Congested = false;
+
 BLEDescriptor UserDescriptor(BLEUUID((uint16_t)0x2901));
 
 class MyServerCallbacks: public BLEServerCallbacks {
@@ -94,6 +97,28 @@ class MyServerCallbacks: public BLEServerCallbacks {
     }
 };
 
+static void ESP32_GATTS_event(esp_gatts_cb_event_t event,
+                              esp_gatt_if_t gatts_if,
+                              esp_ble_gatts_cb_param_t *param)
+{
+  switch (event)
+  {
+  case ESP_GATTS_MTU_EVT:
+    BLE_Notify_Size = param->mtu.mtu - 3 < BLE_MAX_NOTIFY_SIZE ?
+                      param->mtu.mtu - 3 : BLE_MAX_NOTIFY_SIZE;
+    break;
+  case ESP_GATTS_CONGEST_EVT:
+    BLE_Notify_Congested = param->congest.congested;
+    break;
+  case ESP_GATTS_DISCONNECT_EVT:
+    BLE_Notify_Size      = BLE_MAX_WRITE_CHUNK_SIZE;
+    BLE_Notify_Congested = false;
+    break;
+  default:
+    break;
+  }
+}
+
 class UARTCallbacks: public BLECharacteristicCallbacks {
     void onWrite(BLECharacteristic *pUARTCharacteristic) {
 #if defined(ESP_IDF_VERSION_MAJOR) && ESP_IDF_VERSION_MAJOR>=5
@@ -139,10 +164,11 @@ static void ESP32_Bluetooth_setup()
       BLEDevice::init((BT_name+"-LE").c_str());
 
       /*
-       * Set the MTU of the packets sent,
-       * maximum is 500, Apple needs 23 apparently.
+       * Largest MTU we are willing to accept. The central picks
+       * the final value, ESP_GATTS_MTU_EVT tells which one.
        */
-      // BLEDevice::setMTU(23);
+      BLEDevice::setMTU(BLE_MAX_NOTIFY_SIZE + 3);
+      BLEDevice::setCustomGattsHandler(ESP32_GATTS_event);
 
       // Create the BLE Server
       pServer = BLEDevice::createServer();
@@ -306,21 +332,23 @@ static void ESP32_Bluetooth_loop()
   case BLUETOOTH_LE_HM10_SERIAL:
     {
       // notify changed value
-      // bluetooth stack will go into congestion, if too many packets are sent
-      if (deviceConnected && (millis() - BLE_Notify_TimeMarker > 10)) { /* < 18000 baud */
+      // full MTU sized chunks, back to back until the stack reports congestion
+      if (deviceConnected) {
+          uint8_t chunk[BLE_MAX_NOTIFY_SIZE];
+
+          for (int i=0; i < BLE_NOTIFY_BURST && !BLE_Notify_Congested; i++) {
+            size_t size = BLE_FIFO_TX->available();
+            size = size < BLE_Notify_Size ? size : BLE_Notify_Size;
 
-          uint8_t chunk[BLE_MAX_WRITE_CHUNK_SIZE];
-          size_t size = BLE_FIFO_TX->available();
-          size = size < BLE_MAX_WRITE_CHUNK_SIZE ? size : BLE_MAX_WRITE_CHUNK_SIZE;
+            if (size == 0) {
+              break;
+            }
 
-          if (size > 0) {
             BLE_FIFO_TX->read((char *) chunk, size);
 
             pUARTCharacteristic->setValue(chunk, size);
             pUARTCharacteristic->notify();
           }
-
-          BLE_Notify_TimeMarker = millis();
       }
       // disconnecting
       if (!deviceConnected && oldDeviceConnected && (millis() - BLE_Advertising_TimeMarker > 500) ) {
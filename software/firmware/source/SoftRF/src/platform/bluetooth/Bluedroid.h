@@ -46,5 +46,7 @@
 #define BLE_FIFO_RX_SIZE          256
 
 #define BLE_MAX_WRITE_CHUNK_SIZE  20
+#define BLE_MAX_NOTIFY_SIZE       244 /* ATT MTU 247 - 3 */
+#define BLE_NOTIFY_BURST          8   /* notifications per loop() pass, at most */
 
 extern IODev_ops_t ESP32_Bluetooth_ops;
@@ -177,6 +177,19 @@ bool BLESensBox::notify_sys(uint8_t status)
 static unsigned long BLE_Notify_TimeMarker  = 0;
 static unsigned long BLE_SensBox_TimeMarker = 0;
 
+static uint32_t          BLE_Notify_Sent = 0;
+static volatile uint32_t BLE_Notify_Done = 0; /* updated from the SoftDevice event task */
+
+static void nRF52_BLE_event(ble_evt_t* evt)
+{
+  if (evt->header.evt_id == BLE_GATTS_EVT_HVN_TX_COMPLETE) {
+    uint32_t done = BLE_Notify_Done + evt->evt.gatts_evt.params.hvn_tx_complete.count;
+
+    /* SensBox and MIDI notifications complete here as well */
+    BLE_Notify_Done = done < BLE_Notify_Sent ? done : BLE_Notify_Sent;
+  }
+}
+
 /*********************************************************************
  This is an example for our nRF52 based Bluefruit LE modules
 
@@ -218,6 +231,29 @@ BLEService    BLE_ODID_service;
 
 static const uint8_t ODID_Uuid[] = {0x00, 0x00, 0xff, 0xfa, 0x00, 0x00, 0x10, 0x00,
                                     0x80, 0x00, 0x00, 0x80, 0x5f, 0x9b, 0x34, 0xfb};
+
+/* Service Data: ASTM UUID16, application code, message counter, message */
+static void rid_scan_callback(ble_gap_evt_adv_report_t* report)
+{
+  uint8_t buf[4 + ODID_MESSAGE_SIZE];
+  uint8_t len = Bluefruit.Scanner.parseReportByType(report,
+                                  BLE_GAP_AD_TYPE_SERVICE_DATA, buf, sizeof(buf));
+
+  if (len == sizeof(buf)                               &&
+      buf[0] == (UUID16_COMPANY_ID_ASTM & 0xFF)        &&
+      buf[1] == ((UUID16_COMPANY_ID_ASTM >> 8) & 0xFF) &&
+      buf[2] == RID_ODID_APP_CODE) {
+    uint8_t mac[BLE_GAP_ADDR_LEN];
+
+    /* SoftDevice keeps the address LSB first */
+    for (int i=0; i < BLE_GAP_ADDR_LEN; i++) {
+      mac[i] = report->peer_addr.addr[BLE_GAP_ADDR_LEN - 1 - i];
+    }
+    rid_receive(mac, buf + 4, len - 4, report->rssi);
+  }
+
+  Bluefruit.Scanner.resume();
+}
 #endif /* ENABLE_REMOTE_ID */
 
 String BT_name = HOSTNAME;
@@ -307,10 +343,14 @@ void startAdv(void)
 // callback invoked when central connects
 void connect_callback(uint16_t conn_handle)
 {
-#if DEBUG_BLE
   // Get the reference to current connection
   BLEConnection* connection = Bluefruit.Connection(conn_handle);
 
+  // ask for the largest MTU, notifications are sized after it
+  connection->requestMtuExchange(BLE_MAX_NOTIFY_SIZE + 3);
+
+#if DEBUG_BLE
+
   char central_name[32] = { 0 };
   connection->getPeerName(central_name, sizeof(central_name));
 
@@ -326,6 +366,8 @@ void connect_callback(uint16_t conn_handle)
  */
 void disconnect_callback(uint16_t conn_handle, uint8_t reason)
 {
+  BLE_Notify_Sent = BLE_Notify_Done;
+
 #if DEBUG_BLE
   (void) conn_handle;
   (void) reason;
@@ -355,7 +397,13 @@ void nRF52_Bluetooth_setup()
   // Note: All config***() function must be called before begin()
   Bluefruit.configPrphBandwidth(BANDWIDTH_MAX);
 
+#if defined(ENABLE_REMOTE_ID)
+  /* central role enables the scanner for OpenDroneID advertisements */
+  Bluefruit.begin(1, rid_enabled() ? 1 : 0);
+#else
   Bluefruit.begin();
+#endif /* ENABLE_REMOTE_ID */
+  Bluefruit.setEventCallback(nRF52_BLE_event);
   Bluefruit.setTxPower(4);    // Check bluefruit.h for supported values
   Bluefruit.setName((BT_name+"-LE").c_str());
   Bluefruit.Periph.setConnectCallback(connect_callback);
@@ -402,6 +450,17 @@ void nRF52_Bluetooth_setup()
   // Set up and start advertising
   startAdv();
 
+#if defined(ENABLE_REMOTE_ID)
+  if (rid_enabled()) {
+    Bluefruit.Scanner.setRxCallback(rid_scan_callback);
+    Bluefruit.Scanner.restartOnDisconnect(true);
+    /* 10% duty. UAs repeat every message type a few times per second */
+    Bluefruit.Scanner.setInterval(320, 32);      // in unit of 0.625 ms
+    Bluefruit.Scanner.useActiveScan(false);
+    Bluefruit.Scanner.start(0);                  // 0 = Don't stop scanning after n seconds
+  }
+#endif /* ENABLE_REMOTE_ID */
+
 #if DEBUG_BLE
   Serial.println("Please use Adafruit's Bluefruit LE app to connect in UART mode");
   Serial.println("Once connected, enter character(s) that you wish to send");
@@ -418,13 +477,25 @@ void nRF52_Bluetooth_setup()
 static void nRF52_Bluetooth_loop()
 {
   // notify changed value
-  // bluetooth stack will go into congestion, if too many packets are sent
+  // MTU sized chunks, back to back while the SoftDevice has HVN TX credits
   if ( Bluefruit.connected()              &&
-       bleuart_HM10.notifyEnabled()       &&
-       (millis() - BLE_Notify_TimeMarker > 10)) { /* < 18000 baud */
-    bleuart_HM10.flushTXD();
+       bleuart_HM10.notifyEnabled()) {
+    uint32_t inflight = BLE_Notify_Sent - BLE_Notify_Done;
+
+    if (inflight < BLE_NOTIFY_CREDITS) {
+      BLE_Notify_TimeMarker = millis();
+    } else if (millis() - BLE_Notify_TimeMarker > BLE_NOTIFY_STALL_MS) {
+      /* a completion event went missing - resync */
+      BLE_Notify_Sent = BLE_Notify_Done;
+      inflight = 0;
+    }
 
-    BLE_Notify_TimeMarker = millis();
+    for (; inflight < BLE_NOTIFY_CREDITS && bleuart_HM10.pendingTXD() > 0; inflight++) {
+      if (!bleuart_HM10.flushTXD()) {
+        break;
+      }
+      BLE_Notify_Sent++;
+    }
   }
 
   if (isTimeToBattery()) {
@@ -449,6 +520,8 @@ static void nRF52_Bluetooth_loop()
       RID_Time_Marker = millis();
     }
   }
+
+  rid_loop();
 #endif /* ENABLE_REMOTE_ID */
 }
 
@@ -475,6 +548,12 @@ static void nRF52_Bluetooth_fini()
     Bluefruit.Advertising.stop();
   }
 
+#if defined(ENABLE_REMOTE_ID)
+  if (Bluefruit.Scanner.isRunning()) {
+    Bluefruit.Scanner.stop();
+  }
+#endif /* ENABLE_REMOTE_ID */
+
   if (sd_en) sd_softdevice_disable();
 }
 
@@ -87,4 +87,7 @@ typedef struct {
 
 #define isTimeToSensBox() (millis() - BLE_SensBox_TimeMarker > 500) /* 2 Hz */
 
+#define BLE_NOTIFY_CREDITS  3    /* HVN TX queue depth of BANDWIDTH_MAX */
+#define BLE_NOTIFY_STALL_MS 1000
+
 extern IODev_ops_t nRF52_Bluetooth_ops;
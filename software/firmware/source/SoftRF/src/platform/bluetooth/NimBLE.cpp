@@ -66,6 +66,14 @@ String BT_name = HOSTNAME;
 static unsigned long BLE_Notify_TimeMarker = 0;
 static unsigned long BLE_Advertising_TimeMarker = 0;
 
+/* updated from the NimBLE host task */
+static volatile uint16_t BLE_Notify_Size      = BLE_MAX_WRITE_CHUNK_SIZE;
+static volatile bool     BLE_Notify_Congested = false;
+
+/* a chunk that the host had no buffers for is sent again, not dropped */
+static uint8_t BLE_Notify_Chunk[BLE_MAX_NOTIFY_SIZE];
+static size_t  BLE_Notify_Pending = 0;
+
 // NimBLEDescriptor UserDescriptor(NimBLEUUID((uint16_t)0x2901));
 
 class MyServerCallbacks: public NimBLEServerCallbacks {
@@ -76,6 +84,13 @@ class MyServerCallbacks: public NimBLEServerCallbacks {
     void onDisconnect(NimBLEServer* pServer) {
       deviceConnected = false;
       BLE_Advertising_TimeMarker = millis();
+      BLE_Notify_Size      = BLE_MAX_WRITE_CHUNK_SIZE;
+      BLE_Notify_Congested = false;
+      BLE_Notify_Pending   = 0;
+    }
+
+    void onMTUChange(uint16_t MTU, ble_gap_conn_desc* desc) {
+      BLE_Notify_Size = MTU - 3 < BLE_MAX_NOTIFY_SIZE ? MTU - 3 : BLE_MAX_NOTIFY_SIZE;
     }
 };
 
@@ -93,6 +108,13 @@ class UARTCallbacks: public BLECharacteristicCallbacks {
                       rxValue.length() : BLE_FIFO_RX->room()));
       }
     }
+
+    void onStatus(NimBLECharacteristic* pCharacteristic, Status s, int code) {
+      /* BLE_HS_ENOMEM - out of host buffers */
+      if (s == Status::ERROR_GATT) {
+        BLE_Notify_Congested = true;
+      }
+    }
 };
 
 static void ESP32_Bluetooth_setup()
@@ -111,10 +133,10 @@ static void ESP32_Bluetooth_setup()
       NimBLEDevice::init((BT_name+"-LE").c_str());
 
       /*
-       * Set the MTU of the packets sent,
-       * maximum is 500, Apple needs 23 apparently.
+       * Largest MTU we are willing to accept. The central picks
+       * the final value, onMTUChange() tells which one.
        */
-      // NimBLEDevice::setMTU(23);
+      NimBLEDevice::setMTU(BLE_MAX_NOTIFY_SIZE + 3);
 
       // Create the BLE Server
       pServer = NimBLEDevice::createServer();
@@ -267,21 +289,35 @@ static void ESP32_Bluetooth_loop()
   case BLUETOOTH_LE_HM10_SERIAL:
     {
       // notify changed value
-      // bluetooth stack will go into congestion, if too many packets are sent
-      if (deviceConnected && (millis() - BLE_Notify_TimeMarker > 10)) { /* < 18000 baud */
+      // full MTU sized chunks, back to back until the host runs out of buffers
+      if (deviceConnected) {
+          if (BLE_Notify_Congested &&
+              millis() - BLE_Notify_TimeMarker > BLE_NOTIFY_BACKOFF_MS) {
+            BLE_Notify_Congested = false;
+          }
+
+          for (int i=0; i < BLE_NOTIFY_BURST && !BLE_Notify_Congested; i++) {
+            if (BLE_Notify_Pending == 0) {
+              size_t size = BLE_FIFO_TX->available();
+              size = size < BLE_Notify_Size ? size : BLE_Notify_Size;
 
-          uint8_t chunk[BLE_MAX_WRITE_CHUNK_SIZE];
-          size_t size = BLE_FIFO_TX->available();
-          size = size < BLE_MAX_WRITE_CHUNK_SIZE ? size : BLE_MAX_WRITE_CHUNK_SIZE;
+              if (size == 0) {
+                break;
+              }
 
-          if (size > 0) {
-            BLE_FIFO_TX->read((char *) chunk, size);
+              BLE_Notify_Pending = BLE_FIFO_TX->read((char *) BLE_Notify_Chunk, size);
+            }
 
-            pUARTCharacteristic->setValue(chunk, size);
+            pUARTCharacteristic->setValue(BLE_Notify_Chunk, BLE_Notify_Pending);
             pUARTCharacteristic->notify();
-          }
 
-          BLE_Notify_TimeMarker = millis();
+            if (BLE_Notify_Congested) {
+              BLE_Notify_TimeMarker = millis();
+              break;
+            }
+
+            BLE_Notify_Pending = 0;
+          }
       }
       // disconnecting
       if (!deviceConnected && oldDeviceConnected && (millis() - BLE_Advertising_TimeMarker > 500) ) {
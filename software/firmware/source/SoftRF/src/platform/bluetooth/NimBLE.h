@@ -49,6 +49,9 @@
 #define BLE_FIFO_RX_SIZE          256
 
 #define BLE_MAX_WRITE_CHUNK_SIZE  20
+#define BLE_MAX_NOTIFY_SIZE       244 /* ATT MTU 247 - 3 */
+#define BLE_NOTIFY_BURST          8   /* notifications per loop() pass, at most */
+#define BLE_NOTIFY_BACKOFF_MS     5   /* wait for host buffers once out of them */
 
 extern IODev_ops_t ESP32_Bluetooth_ops;
 
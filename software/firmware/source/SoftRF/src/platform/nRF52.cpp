@@ -1511,7 +1511,9 @@ static void nRF52_EEPROM_extension(int cmd)
   {
     case EEPROM_EXT_STORE:
       for (int i=0; i<sizeof(ui_settings_t); i++) {
-        EEPROM.write(sizeof(eeprom_t) + i, raw[i]);
+        if (EEPROM.read(sizeof(eeprom_t) + i) != raw[i]) {
+          EEPROM.write(sizeof(eeprom_t) + i, raw[i]);
+        }
       }
       return;
     case EEPROM_EXT_DEFAULTS:
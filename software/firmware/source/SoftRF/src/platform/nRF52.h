@@ -317,6 +317,7 @@ struct rst_info {
 #define USE_OGN_ENCRYPTION
 #define ENABLE_ADSL
 #define ENABLE_PROL
+//#define ENABLE_PROFILER
 #if !defined(ARDUINO_ARCH_MBED)
 #define USE_BLE_MIDI
 #define ENABLE_REMOTE_ID
@@ -25,6 +25,7 @@
 #include "GDL90.h"
 #include "../../driver/EEPROM.h"
 #include "../../TrafficHelper.h"
+#include "../../system/Profiler.h"
 
 #define ADDR_TO_HEX_STR(s, c) (s += ((c) < 0x10 ? "0" : "") + String((c), HEX))
 
@@ -77,6 +78,8 @@ static void D1090_Out(byte *buf, size_t size)
 
 void D1090_Export()
 {
+  PROFILE_SCOPE(PROBE_D1090_EXPORT);
+
   frame_data_t df17;
   float distance;
   String str;
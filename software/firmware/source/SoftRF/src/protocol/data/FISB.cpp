@@ -0,0 +1,187 @@
+/*
+ * FISB.cpp
+ * Copyright (C) 2024 Linar Yusupov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "../../system/SoC.h"
+#include "FISB.h"
+
+fisb_stats_t FISB_Stats;
+char         FISB_METAR[FISB_TEXT_SIZE];
+uint32_t     FISB_NEXRAD_Block = 0;
+
+#if !defined(ENABLE_FISB)
+
+bool FISB_Uplink(uint8_t *frame, size_t size) { return false; }
+bool FISB_Uplink_Hex(const char *str)         { return false; }
+
+#else
+
+#include <uat.h>
+#include <fec.h>
+#include <uat_decode.h>
+
+#include "GDL90.h"
+
+static uint8_t               FISB_Frame[UPLINK_FRAME_BYTES];
+static struct uat_uplink_mdb FISB_mdb;
+
+static const char FISB_DLAC[] =
+  "\x03" "ABCDEFGHIJKLMNOPQRSTUVWXYZ\x1A\t\x1E\n| !\"#$%&'()*+,-./0123456789:;<=>?";
+
+/* 6-bit DLAC text of FIS-B generic text product, first record only */
+static size_t FISB_DLAC_decode(const uint8_t *data, size_t bytes, char *buf, size_t size)
+{
+  size_t len  = 0;
+  size_t bits = bytes * 8;
+  bool   tab  = false;
+
+  for (size_t bit = 0; bit + 6 <= bits && len + 1 < size; bit += 6) {
+    size_t   idx = bit >> 3;
+    uint8_t  off = bit & 7;
+    uint16_t w   = (data[idx] << 8) | (idx + 1 < bytes ? data[idx + 1] : 0);
+    uint8_t  ch  = (w >> (10 - off)) & 0x3F;
+    char     c   = FISB_DLAC[ch];
+
+    if (tab) {
+      /* character after TAB is a number of spaces */
+      while (ch-- > 0 && len + 1 < size) {
+        buf[len++] = ' ';
+      }
+      tab = false;
+    } else if (c == '\t') {
+      tab = true;
+    } else if (c == '\x03' || c == '\x1E' || c == '\x1A') {
+      break; /* end of text or of record */
+    } else {
+      buf[len++] = (c == '\n') ? ' ' : c;
+    }
+  }
+
+  buf[len] = 0;
+
+  return len;
+}
+
+static void FISB_Product(const struct fisb_apdu *apdu)
+{
+  char text[FISB_TEXT_SIZE];
+
+  FISB_Stats.apdus++;
+
+  switch (apdu->product_id)
+  {
+  case FISB_PRODUCT_TEXT:
+    FISB_DLAC_decode(apdu->data, apdu->length, text, sizeof(text));
+    if (!strncmp(text, "METAR ", 6) || !strncmp(text, "SPECI ", 6)) {
+      memcpy(FISB_METAR, text, sizeof(FISB_METAR));
+      FISB_Stats.metars++;
+    } else {
+      FISB_Stats.text++;
+    }
+    break;
+
+  case FISB_PRODUCT_NEXRAD_REGIONAL:
+  case FISB_PRODUCT_NEXRAD_CONUS:
+    if (apdu->length >= 3) {
+      FISB_NEXRAD_Block = ((apdu->data[0] & 0x0F) << 16) |
+                           (apdu->data[1] << 8) | apdu->data[2];
+      FISB_Stats.nexrad++;
+    }
+    break;
+
+  default:
+    break;
+  }
+}
+
+/*
+ * frame is either raw (interleaved, UPLINK_FRAME_BYTES) ground uplink
+ * or an already corrected one (UPLINK_FRAME_DATA_BYTES), like dump978 does emit
+ */
+bool FISB_Uplink(uint8_t *frame, size_t size)
+{
+  uint8_t *data;
+  int rs_errors = 0;
+
+  FISB_Stats.frames++;
+
+  /* dump978 input may come with no UAT radio present to set FEC up */
+  init_fec();
+
+  if (size == UPLINK_FRAME_BYTES) {
+    if (correct_uplink_frame(frame, FISB_Frame, &rs_errors) < 0) {
+      FISB_Stats.fec_errors++;
+      return false;
+    }
+    FISB_Stats.rs_corrected += rs_errors;
+    data = FISB_Frame;
+  } else if (size == UPLINK_FRAME_DATA_BYTES) {
+    data = frame;
+  } else {
+    FISB_Stats.fec_errors++;
+    return false;
+  }
+
+  uat_decode_uplink_mdb(data, &FISB_mdb);
+
+  if (FISB_mdb.app_data_valid) {
+    for (unsigned i=0; i < FISB_mdb.num_info_frames; i++) {
+      struct uat_uplink_info_frame *info = &FISB_mdb.info_frames[i];
+
+      if (info->is_fisb) {
+        FISB_Product(&info->fisb);
+      }
+    }
+  }
+
+  /* time of reception is not known */
+  if (GDL90_Uplink(data, 0xFFFFFF)) {
+    FISB_Stats.exported++;
+  }
+
+  return true;
+}
+
+static inline int8_t FISB_hex(char c)
+{
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+/* "<hex>[;rs=..;ss=..;]" - a dump978 uplink line, leading '+' stripped */
+bool FISB_Uplink_Hex(const char *str)
+{
+  static uint8_t raw[UPLINK_FRAME_BYTES];
+  size_t size = 0;
+
+  while (size < sizeof(raw)) {
+    int8_t hi = FISB_hex(str[0]);
+    int8_t lo = hi < 0 ? -1 : FISB_hex(str[1]);
+
+    if (lo < 0) {
+      break;
+    }
+    raw[size++] = (hi << 4) | lo;
+    str += 2;
+  }
+
+  return FISB_Uplink(raw, size);
+}
+
+#endif /* ENABLE_FISB */
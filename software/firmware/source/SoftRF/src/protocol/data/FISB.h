@@ -0,0 +1,48 @@
+/*
+ * FISB.h
+ * Copyright (C) 2024 Linar Yusupov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef FISBHELPER_H
+#define FISBHELPER_H
+
+#include "../../system/SoC.h"
+
+#define FISB_PRODUCT_NEXRAD_REGIONAL  63
+#define FISB_PRODUCT_NEXRAD_CONUS     64
+#define FISB_PRODUCT_TEXT             413 /* METAR, TAF, SPECI, PIREP, WINDS */
+
+#define FISB_TEXT_SIZE                128
+
+typedef struct fisb_stats_struct {
+  uint32_t frames;
+  uint32_t fec_errors;
+  uint32_t rs_corrected;
+  uint32_t apdus;
+  uint32_t metars;
+  uint32_t text;      /* all the other text products */
+  uint32_t nexrad;
+  uint32_t exported;  /* GDL90 messages #7 */
+} fisb_stats_t;
+
+bool FISB_Uplink(uint8_t *, size_t);
+bool FISB_Uplink_Hex(const char *);
+
+extern fisb_stats_t FISB_Stats;
+extern char         FISB_METAR[FISB_TEXT_SIZE];
+extern uint32_t     FISB_NEXRAD_Block;
+
+#endif /* FISBHELPER_H */
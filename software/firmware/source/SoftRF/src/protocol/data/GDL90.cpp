@@ -29,6 +29,7 @@
 #include "../../driver/EEPROM.h"
 #include "../../driver/WiFi.h"
 #include "../../TrafficHelper.h"
+#include "../../system/Profiler.h"
 #include "../radio/Legacy.h"
 #include "NMEA.h"
 
@@ -51,6 +52,7 @@ const char *GDL90_CallSign_Prefix[] = {
   [RF_PROTOCOL_FANET]     = "FA",
   [RF_PROTOCOL_APRS]      = "HA",
   [RF_PROTOCOL_ADSL_860]  = "AL",
+  [RF_PROTOCOL_EID]       = "ID",
 };
 
 const uint8_t aircraft_type_to_gdl90[] PROGMEM = {
@@ -434,6 +436,8 @@ static size_t makeFFid(uint8_t *buf)
 static void GDL90_Out(byte *buf, size_t size)
 {
   if (size > 0) {
+    Traffic_Export_Sent(EXPORT_CLASS_TRAFFIC, settings->gdl90, size);
+
     switch(settings->gdl90)
     {
     case GDL90_UART:
@@ -470,50 +474,106 @@ static void GDL90_Out(byte *buf, size_t size)
   }
 }
 
+/*
+ * UAT ground uplink (FIS-B, TIS-B) is handed over to EFB as is -
+ * message #7 carries the whole 432 bytes of FEC corrected payload.
+ */
+bool GDL90_Uplink(uint8_t *data, uint32_t tor)
+{
+  static uint8_t msg[GDL90_UPLINK_TOR_SIZE + GDL90_UPLINK_DATA_SIZE];
+  static uint8_t buf[2 * (1 + sizeof(msg) + 2) + 2];
+  uint8_t *ptr = buf;
+
+  if (settings->gdl90 == GDL90_OFF) {
+    return false;
+  }
+
+  msg[0] = tor         & 0xFF;
+  msg[1] = (tor >>  8) & 0xFF;
+  msg[2] = (tor >> 16) & 0xFF;
+  memcpy(msg + GDL90_UPLINK_TOR_SIZE, data, GDL90_UPLINK_DATA_SIZE);
+
+  uint16_t fcs = GDL90_calcFCS(GDL90_UPLINK_MSG_ID, msg, sizeof(msg));
+  uint8_t fcs_lsb, fcs_msb;
+
+  fcs_lsb = fcs        & 0xFF;
+  fcs_msb = (fcs >> 8) & 0xFF;
+
+  *ptr++ = 0x7E; /* Start flag */
+  *ptr++ = GDL90_UPLINK_MSG_ID;
+  ptr = GDL90_EscapeFilter(ptr, msg, sizeof(msg));
+  ptr = GDL90_EscapeFilter(ptr, &fcs_lsb, 1);
+  ptr = GDL90_EscapeFilter(ptr, &fcs_msb, 1);
+  *ptr++ = 0x7E; /* Stop flag */
+
+  /* weather is less urgent than traffic - skip when the link is busy */
+  if (!Traffic_Export_Allow(EXPORT_CLASS_TRAFFIC, settings->gdl90, ptr - buf)) {
+    return false;
+  }
+
+  GDL90_Out(buf, ptr - buf);
+
+  return true;
+}
+
 void GDL90_Export()
 {
+  PROFILE_SCOPE(PROBE_GDL90_EXPORT);
+
   size_t size;
-  time_t this_moment = now();
   uint8_t *buf = (uint8_t *) (sizeof(UDPpacketBuffer) < UDP_PACKET_BUFSIZE ?
                               NMEABuffer : UDPpacketBuffer);
 
   if (settings->gdl90 != GDL90_OFF) {
-    size = makeHeartbeat(buf);
-    GDL90_Out(buf, size);
+    if (Traffic_Export_Full) {
+      size = makeHeartbeat(buf);
+      GDL90_Out(buf, size);
 
 #if defined(DO_GDL90_FF_EXT)
-    size = makeFFid(buf);
-    GDL90_Out(buf, size);
+      size = makeFFid(buf);
+      GDL90_Out(buf, size);
 #endif /* DO_GDL90_FF_EXT */
 
 #if defined(ENABLE_AHRS)
-    size = AHRS_GDL90(buf);
-    GDL90_Out(buf, size);
+      size = AHRS_GDL90(buf);
+      GDL90_Out(buf, size);
 #endif /* ENABLE_AHRS */
 
-    if (isValidFix()) {
-      size = makeOwnershipReport(buf, &ThisAircraft);
-      GDL90_Out(buf, size);
+      if (isValidFix()) {
+        size = makeOwnershipReport(buf, &ThisAircraft);
+        GDL90_Out(buf, size);
 
-      size = makeGeometricAltitude(buf, &ThisAircraft);
-      GDL90_Out(buf, size);
+        size = makeGeometricAltitude(buf, &ThisAircraft);
+        GDL90_Out(buf, size);
+      }
     }
 
-    for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
-      if (Container[i].addr &&
-         (this_moment - Container[i].timestamp) <= EXPORT_EXPIRATION_TIME) {
+    /* targets which are due in this cycle, most relevant first */
+    for (int k=0; k < Traffic_Scheduled; k++) {
+      ufo_t *fop = traffic_by_prio[k].fop;
 
-        /*
-         * Disable distance filter when we have no GNSS data source to locate
-         * own position. Assume that we never gonna fly over 'Null Island'.
-         */
+      if (!Traffic_Export_Due(EXPORT_SINK_GDL90, fop)) {
+        continue;
+      }
 
-        if ((ThisAircraft.latitude == 0 && ThisAircraft.longitude == 0) ||
-            Container[i].distance < ALARM_ZONE_NONE) {
-          size = makeTrafficReport(buf, &Container[i]);
-          GDL90_Out(buf, size);
+      /*
+       * Disable distance filter when we have no GNSS data source to locate
+       * own position. Assume that we never gonna fly over 'Null Island'.
+       */
+
+      if ((ThisAircraft.latitude == 0 && ThisAircraft.longitude == 0) ||
+          fop->distance < ALARM_ZONE_NONE) {
+        size = makeTrafficReport(buf, fop);
+
+        /* link budget is exhausted - rest of the list is less important */
+        if (!Traffic_Export_Allow(EXPORT_CLASS_TRAFFIC, settings->gdl90, size)) {
+          break;
         }
+
+        GDL90_Out(buf, size);
       }
+
+      Traffic_Export_Done(EXPORT_SINK_GDL90, fop);
     }
   }
 }
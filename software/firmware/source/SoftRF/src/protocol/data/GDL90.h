@@ -132,6 +132,10 @@ typedef struct GDL90_Msg_OwnershipGeometricAltitude {
 
 } __attribute__((packed)) GDL90_Msg_OwnershipGeometricAltitude_t;
 
+#define GDL90_UPLINK_MSG_ID      7
+#define GDL90_UPLINK_TOR_SIZE    3   /* 80 ns units, LSB first */
+#define GDL90_UPLINK_DATA_SIZE   432 /* UAT ground uplink payload */
+
 #if defined(DO_GDL90_FF_EXT)
 
 #define GDL90_FFEXT_MSG_ID  0x65
@@ -161,7 +165,8 @@ extern const uint8_t gdl90_to_aircraft_type[] PROGMEM;
 extern const char *GDL90_CallSign_Prefix[];
 
 void GDL90_Export(void);
+bool GDL90_Uplink(uint8_t *, uint32_t);
 uint16_t GDL90_calcFCS(uint8_t, uint8_t *, int);
 uint8_t *GDL90_EscapeFilter(uint8_t *, uint8_t *, int);
 
-#endif /* GDL90HELPER_H */
\ No newline at end of file
+#endif /* GDL90HELPER_H */
\ No newline at end of file
@@ -31,6 +31,7 @@
 #include "NMEA.h"
 #include "GDL90.h"
 #include "D1090.h"
+#include "../../system/Profiler.h"
 
 #undef DEPRECATED
 #include "JSON.h"
@@ -62,6 +63,8 @@ byte getVal(char c)
 
 void JSON_Export()
 {
+  PROFILE_SCOPE(PROBE_JSON_EXPORT);
+
   if (settings->json != JSON_PING) {
     return;
   }
@@ -30,9 +30,32 @@
 static unsigned long MAVLinkTimeSyncMarker = 0;
 static bool MAVLinkAPisArmed = false;
 
+/* what the autopilot was told last time, per Container[] slot */
+typedef struct mavlink_traffic_struct {
+  uint32_t      addr;
+  uint8_t       protocol;
+  char          callsign[8+1];
+  float         latitude;
+  float         longitude;
+  float         altitude;
+  float         course;
+  float         speed;
+  float         vs;
+  unsigned long marker;
+} mavlink_traffic_t;
+
+static mavlink_traffic_t MAVLink_Traffic[MAX_TRACKING_OBJECTS];
+static uint32_t MAVLink_Budget = MAVLINK_TRAFFIC_BUDGET;
+static unsigned long MAVLink_Budget_Marker = 0;
+static int MAVLink_Next_Slot = 0;
+
 void MAVLink_setup()
 {
   SoC->swSer_begin(57600);
+
+  memset(MAVLink_Traffic, 0, sizeof(MAVLink_Traffic));
+  MAVLink_Budget        = MAVLINK_TRAFFIC_BUDGET;
+  MAVLink_Budget_Marker = millis();
 }
 
 void PickMAVLinkFix()
@@ -54,34 +77,95 @@ void MAVLinkTimeSync()
   }
 }
 
+static bool MAVLinkTrafficChanged(ufo_t *fop, mavlink_traffic_t *last)
+{
+  if (millis() - last->marker >= MAVLINK_REFRESH_TIME) {
+    return true;
+  }
+
+  float dlat   = (fop->latitude  - last->latitude) * 111195.0; /* metres */
+  float dlon   = (fop->longitude - last->longitude) * 111195.0 *
+                  cosf(fop->latitude * (PI / 180.0));
+  float course = fabsf(fop->course - last->course);
+
+  if (course > 180.0) {
+    course = 360.0 - course;
+  }
+
+  return dlat * dlat + dlon * dlon > MAVLINK_DELTA_DISTANCE * MAVLINK_DELTA_DISTANCE ||
+         fabsf(fop->altitude - last->altitude) > MAVLINK_DELTA_ALTITUDE ||
+         course                                > MAVLINK_DELTA_COURSE   ||
+         fabsf(fop->speed    - last->speed)    > MAVLINK_DELTA_SPEED    ||
+         fabsf(fop->vs       - last->vs)       > MAVLINK_DELTA_VS;
+}
+
 void MAVLinkShareTraffic()
 {
     time_t this_moment = now();
+    unsigned long ms = millis();
+    unsigned long elapsed = ms - MAVLink_Budget_Marker;
+
+    /* the bucket holds one second worth of the link */
+    if (elapsed > 1000) {
+      elapsed = 1000;
+    }
+
+    uint32_t gain = elapsed * MAVLINK_TRAFFIC_BUDGET / 1000;
+
+    if (gain > 0) {
+      MAVLink_Budget = MAVLink_Budget + gain < MAVLINK_TRAFFIC_BUDGET ?
+                       MAVLink_Budget + gain : MAVLINK_TRAFFIC_BUDGET;
+      MAVLink_Budget_Marker = ms;
+    }
+
+    /* round robin, so that a crowded sky does not starve the last slots */
+    for (int n=0; n < MAX_TRACKING_OBJECTS; n++) {
+      int i = (MAVLink_Next_Slot + n) % MAX_TRACKING_OBJECTS;
+      ufo_t *fop = &Container[i];
+      mavlink_traffic_t *last = &MAVLink_Traffic[i];
 
-    for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
-      if (Container[i].addr && (this_moment - Container[i].timestamp) <= EXPORT_EXPIRATION_TIME) {
-
-        char hexbuf[8];
-        char callsign[8+1];
-
-        snprintf(hexbuf, sizeof(hexbuf), "%06X", Container[i].addr);
-        memcpy(callsign, GDL90_CallSign_Prefix[Container[i].protocol],
-          strlen(GDL90_CallSign_Prefix[Container[i].protocol]));
-        memcpy(callsign + strlen(GDL90_CallSign_Prefix[Container[i].protocol]),
-          hexbuf, strlen(hexbuf) + 1);
-
-        write_mavlink(  Container[i].addr,
-                        Container[i].latitude,
-                        Container[i].longitude,
-                        Container[i].altitude,
-                        Container[i].course,
-                        Container[i].speed * _GPS_MPS_PER_KNOT, /* m/s */
-                        Container[i].vs / (_GPS_FEET_PER_METER * 60.0), /* m/s */
-                        (settings->band == RF_BAND_US ? 1200 : 7000),
-                        callsign,
-                        AT_TO_GDL90(Container[i].aircraft_type));
+      if (fop->addr == 0 || (this_moment - fop->timestamp) > EXPORT_EXPIRATION_TIME) {
+        last->addr = 0;
+        continue;
+      }
 
+      if (last->addr != fop->addr || last->protocol != fop->protocol) {
+        snprintf(last->callsign, sizeof(last->callsign), "%s%06X",
+                 GDL90_CallSign_Prefix[fop->protocol], fop->addr);
+        last->addr     = fop->addr;
+        last->protocol = fop->protocol;
+        last->marker   = ms - MAVLINK_REFRESH_TIME;
       }
+
+      if (!MAVLinkTrafficChanged(fop, last)) {
+        continue;
+      }
+
+      if (MAVLink_Budget < MAVLINK_ADSB_VEHICLE_SIZE) {
+        MAVLink_Next_Slot = i;
+        return;
+      }
+
+      write_mavlink(  fop->addr,
+                      fop->latitude,
+                      fop->longitude,
+                      fop->altitude,
+                      fop->course,
+                      fop->speed * _GPS_MPS_PER_KNOT, /* m/s */
+                      fop->vs / (_GPS_FEET_PER_METER * 60.0), /* m/s */
+                      (settings->band == RF_BAND_US ? 1200 : 7000),
+                      last->callsign,
+                      AT_TO_GDL90(fop->aircraft_type));
+
+      MAVLink_Budget -= MAVLINK_ADSB_VEHICLE_SIZE;
+
+      last->latitude  = fop->latitude;
+      last->longitude = fop->longitude;
+      last->altitude  = fop->altitude;
+      last->course    = fop->course;
+      last->speed     = fop->speed;
+      last->vs        = fop->vs;
+      last->marker    = ms;
     }
 }
 
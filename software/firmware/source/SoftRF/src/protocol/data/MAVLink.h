@@ -30,10 +30,25 @@
 
 #define isValidMAVFix() (the_aircraft.gps.fix_type == 3 /* 3D fix */ )
 
+/* ADSB_VEHICLE (#246) on the wire */
+#define MAVLINK_ADSB_VEHICLE_SIZE   (MAVLINK_NUM_NON_PAYLOAD_BYTES + \
+                                     MAVLINK_MSG_ID_ADSB_VEHICLE_LEN)
+
+/* share of a 57600 baud autopilot link given to traffic, bytes per second */
+#define MAVLINK_TRAFFIC_BUDGET      (57600 / 10 / 2)
+
+/* re-send a target when it has moved or turned this much */
+#define MAVLINK_DELTA_DISTANCE      30.0  /* metres */
+#define MAVLINK_DELTA_ALTITUDE      10.0  /* metres */
+#define MAVLINK_DELTA_COURSE        10.0  /* degrees */
+#define MAVLINK_DELTA_SPEED         2.0   /* knots */
+#define MAVLINK_DELTA_VS            100.0 /* fpm */
+#define MAVLINK_REFRESH_TIME        3000  /* ms, anyway */
+
 void MAVLink_setup();
 void PickMAVLinkFix();
 void MAVLinkTimeSync();
 void MAVLinkShareTraffic();
 void MAVLinkSetWiFiPower();
 
-#endif /* MAVLINKHELPER_H */
\ No newline at end of file
+#endif /* MAVLINKHELPER_H */
\ No newline at end of file
@@ -27,6 +27,7 @@
 #include "../../driver/Battery.h"
 #include "../../driver/Baro.h"
 #include "../../TrafficHelper.h"
+#include "../../system/Profiler.h"
 
 #define ADDR_TO_HEX_STR(s, c) (s += ((c) < 0x10 ? "0" : "") + String((c), HEX))
 
@@ -54,11 +55,17 @@ const char *NMEA_CallSign_Prefix[] = {
   [RF_PROTOCOL_FANET]     = "FAN",
   [RF_PROTOCOL_APRS]      = "HAM",
   [RF_PROTOCOL_ADSL_860]  = "ADL",
+  [RF_PROTOCOL_EID]       = "RID",
 };
 
 #define isTimeToPGRMZ() (millis() - PGRMZ_TimeMarker > 1000)
 unsigned long PGRMZ_TimeMarker = 0;
 
+#if defined(ENABLE_PROFILER)
+#define isTimeToPSRFP() (millis() - PSRFP_TimeMarker > 10000)
+unsigned long PSRFP_TimeMarker = 0;
+#endif /* ENABLE_PROFILER */
+
 #if defined(ENABLE_AHRS)
 #include "../../driver/AHRSHelper.h"
 
@@ -274,6 +281,28 @@ void NMEA_loop()
   }
 #endif /* ENABLE_AHRS */
 
+#if defined(ENABLE_PROFILER)
+  if (settings->nmea_p && isTimeToPSRFP()) {
+    profiler_stats_t stats;
+
+    for (uint8_t i=0; i < PROBE_COUNT; i++) {
+      if (Profiler_stats(i, &stats)) {
+        snprintf_P(NMEABuffer, sizeof(NMEABuffer),
+                PSTR("$PSRFP,%s,%lu,%lu,%lu,%lu,%lu*"),
+                Probe_Name[i], (unsigned long) stats.count,
+                (unsigned long) stats.min, (unsigned long) stats.avg,
+                (unsigned long) stats.max, (unsigned long) stats.p99);
+
+        NMEA_add_checksum(NMEABuffer, sizeof(NMEABuffer) - strlen(NMEABuffer));
+
+        NMEA_Out(settings->nmea_out, (byte *) NMEABuffer, strlen(NMEABuffer), false);
+      }
+    }
+
+    PSRFP_TimeMarker = millis();
+  }
+#endif /* ENABLE_PROFILER */
+
 #if defined(NMEA_TCP_SERVICE)
   uint8_t i;
 
@@ -336,7 +365,7 @@ void NMEA_fini()
 #endif /* NMEA_TCP_SERVICE */
 }
 
-void NMEA_Out(uint8_t dest, byte *buf, size_t size, bool nl)
+static void NMEA_Write(uint8_t dest, byte *buf, size_t size, bool nl)
 {
   switch (dest)
   {
@@ -407,8 +436,31 @@ void NMEA_Out(uint8_t dest, byte *buf, size_t size, bool nl)
   }
 }
 
+void NMEA_Out(uint8_t dest, byte *buf, size_t size, bool nl)
+{
+  Traffic_Export_Sent(EXPORT_CLASS_TRAFFIC, dest, nl ? size + 1 : size);
+
+  NMEA_Write(dest, buf, size, nl);
+}
+
+/* GNSS sentences go out on a link budget of their own */
+void NMEA_Passthrough(uint8_t dest, byte *buf, size_t size, bool nl)
+{
+  size_t len = nl ? size + 1 : size;
+
+  if (!Traffic_Export_Allow(EXPORT_CLASS_GNSS, dest, len)) {
+    return;
+  }
+
+  Traffic_Export_Sent(EXPORT_CLASS_GNSS, dest, len);
+
+  NMEA_Write(dest, buf, size, nl);
+}
+
 void NMEA_Export()
 {
+    PROFILE_SCOPE(PROBE_NMEA_EXPORT);
+
     int bearing;
     int alt_diff;
     float distance;
@@ -427,106 +479,118 @@ void NMEA_Export()
 
     bool has_Fix       = isValidFix() || (settings->mode == SOFTRF_MODE_TXRX_TEST);
 
-    if (has_Fix) {
-      for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
-        if (Container[i].addr && (this_moment - Container[i].timestamp) <= EXPORT_EXPIRATION_TIME) {
+    if (has_Fix && settings->nmea_l) {
+      /* targets which are due in this cycle, most relevant first */
+      for (int k=0; k < Traffic_Scheduled; k++) {
+        int i = traffic_by_prio[k].fop - Container;
 
-#if 0
-          Serial.println(fo.addr);
-          Serial.println(fo.latitude, 4);
-          Serial.println(fo.longitude, 4);
-          Serial.println(fo.altitude);
-          Serial.println(fo.addr_type);
-          Serial.println(fo.vs);
-          Serial.println(fo.aircraft_type);
-          Serial.println(fo.stealth);
-          Serial.println(fo.no_track);
-#endif
-          if (settings->nmea_l) {
-            distance = Container[i].distance;
+        if (!Traffic_Export_Due(EXPORT_SINK_NMEA, &Container[i])) {
+          continue;
+        }
 
-            if (distance < ALARM_ZONE_NONE) {
+        distance = Container[i].distance;
 
-              total_objects++;
+        if (distance < ALARM_ZONE_NONE) {
+          char str_climb_rate[8] = "";
+          uint8_t addr_type = Container[i].addr_type > ADDR_TYPE_ANONYMOUS ?
+                              ADDR_TYPE_ANONYMOUS : Container[i].addr_type;
 
-              char str_climb_rate[8] = "";
-              uint8_t addr_type = Container[i].addr_type > ADDR_TYPE_ANONYMOUS ?
-                                  ADDR_TYPE_ANONYMOUS : Container[i].addr_type;
+          bearing = Container[i].bearing;
+          alarm_level = Container[i].alarm_level;
+          alt_diff = (int) (Container[i].altitude - ThisAircraft.altitude);
 
-              bearing = Container[i].bearing;
-              alarm_level = Container[i].alarm_level;
-              alt_diff = (int) (Container[i].altitude - ThisAircraft.altitude);
+          if (!Container[i].stealth && !ThisAircraft.stealth) {
+            dtostrf(
+              constrain(Container[i].vs / (_GPS_FEET_PER_METER * 60.0), -32.7, 32.7),
+              5, 1, str_climb_rate);
+          }
 
-              if (!Container[i].stealth && !ThisAircraft.stealth) {
-                dtostrf(
-                  constrain(Container[i].vs / (_GPS_FEET_PER_METER * 60.0), -32.7, 32.7),
-                  5, 1, str_climb_rate);
+          /*
+           * When callsign is available - send it to a NMEA client.
+           * If it is not - generate a callsign substitute,
+           * based upon a protocol ID and the ICAO address
+           */
+          memset((void *) NMEA_Callsign, 0, sizeof(NMEA_Callsign));
+
+          if (strnlen((char *) Container[i].callsign, sizeof(Container[i].callsign)) > 0) {
+            memcpy(NMEA_Callsign, Container[i].callsign, sizeof(Container[i].callsign));
+            for (int j=0; j < sizeof(NMEA_Callsign); j++) {
+              if (NMEA_Callsign[j] == ' ' || NMEA_Callsign[j] == ',' || NMEA_Callsign[j] == '*') {
+                NMEA_Callsign[j] = 0;
+                break;
               }
+            }
+          } else {
+            memcpy(NMEA_Callsign, NMEA_CallSign_Prefix[Container[i].protocol],
+              strlen(NMEA_CallSign_Prefix[Container[i].protocol]));
 
-              /*
-               * When callsign is available - send it to a NMEA client.
-               * If it is not - generate a callsign substitute,
-               * based upon a protocol ID and the ICAO address
-               */
-              memset((void *) NMEA_Callsign, 0, sizeof(NMEA_Callsign));
-
-              if (strnlen((char *) Container[i].callsign, sizeof(Container[i].callsign)) > 0) {
-                memcpy(NMEA_Callsign, Container[i].callsign, sizeof(Container[i].callsign));
-                for (int j=0; j < sizeof(NMEA_Callsign); j++) {
-                  if (NMEA_Callsign[j] == ' ' || NMEA_Callsign[j] == ',' || NMEA_Callsign[j] == '*') {
-                    NMEA_Callsign[j] = 0;
-                    break;
-                  }
-                }
-              } else {
-                memcpy(NMEA_Callsign, NMEA_CallSign_Prefix[Container[i].protocol],
-                  strlen(NMEA_CallSign_Prefix[Container[i].protocol]));
-
-                String str = "_";
-
-                ADDR_TO_HEX_STR(str, (Container[i].addr >> 16) & 0xFF);
-                ADDR_TO_HEX_STR(str, (Container[i].addr >>  8) & 0xFF);
-                ADDR_TO_HEX_STR(str, (Container[i].addr      ) & 0xFF);
-
-                str.toUpperCase();
-                memcpy(NMEA_Callsign + strlen(NMEA_CallSign_Prefix[Container[i].protocol]),
-                  str.c_str(), str.length());
-              }
+            String str = "_";
 
-              data_source = (Container[i].protocol == RF_PROTOCOL_ADSB_UAT ||
-                             Container[i].protocol == RF_PROTOCOL_ADSB_1090) ?
-                            DATA_SOURCE_ADSB : DATA_SOURCE_FLARM;
-
-              snprintf_P(NMEABuffer, sizeof(NMEABuffer),
-                      PSTR("$PFLAA,%d,%d,%d,%d,%d,%06X!%s,%d,,%d,%s,%X" PFLAA_EXT1_FMT "*"),
-                      alarm_level,
-                      (int) (distance * cos(radians(bearing))), (int) (distance * sin(radians(bearing))),
-                      alt_diff, addr_type, Container[i].addr, NMEA_Callsign,
-                      (int) Container[i].course, (int) (Container[i].speed * _GPS_MPS_PER_KNOT),
-                      ltrim(str_climb_rate), Container[i].aircraft_type
-                      PFLAA_EXT1_ARGS );
-
-              NMEA_add_checksum(NMEABuffer, sizeof(NMEABuffer) - strlen(NMEABuffer));
-
-              NMEA_Out(settings->nmea_out, (byte *) NMEABuffer, strlen(NMEABuffer), false);
-
-              /* Most close traffic is treated as highest priority target */
-              if (distance < HP_distance && abs(alt_diff) < VERTICAL_VISIBILITY_RANGE) {
-                HP_bearing = bearing;
-                HP_alt_diff = alt_diff;
-                HP_alarm_level = alarm_level;
-                HP_distance = distance;
-                HP_addr = Container[i].addr;
-              }
+            ADDR_TO_HEX_STR(str, (Container[i].addr >> 16) & 0xFF);
+            ADDR_TO_HEX_STR(str, (Container[i].addr >>  8) & 0xFF);
+            ADDR_TO_HEX_STR(str, (Container[i].addr      ) & 0xFF);
 
-            }
+            str.toUpperCase();
+            memcpy(NMEA_Callsign + strlen(NMEA_CallSign_Prefix[Container[i].protocol]),
+              str.c_str(), str.length());
+          }
+
+          data_source = (Container[i].protocol == RF_PROTOCOL_ADSB_UAT ||
+                         Container[i].protocol == RF_PROTOCOL_ADSB_1090) ?
+                        DATA_SOURCE_ADSB : DATA_SOURCE_FLARM;
+
+          snprintf_P(NMEABuffer, sizeof(NMEABuffer),
+                  PSTR("$PFLAA,%d,%d,%d,%d,%d,%06X!%s,%d,,%d,%s,%X" PFLAA_EXT1_FMT "*"),
+                  alarm_level,
+                  (int) (distance * cos(radians(bearing))), (int) (distance * sin(radians(bearing))),
+                  alt_diff, addr_type, Container[i].addr, NMEA_Callsign,
+                  (int) Container[i].course, (int) (Container[i].speed * _GPS_MPS_PER_KNOT),
+                  ltrim(str_climb_rate), Container[i].aircraft_type
+                  PFLAA_EXT1_ARGS );
+
+          NMEA_add_checksum(NMEABuffer, sizeof(NMEABuffer) - strlen(NMEABuffer));
+
+          size_t size = strlen(NMEABuffer);
+
+          /* link budget is exhausted - rest of the list is less important */
+          if (!Traffic_Export_Allow(EXPORT_CLASS_TRAFFIC, settings->nmea_out, size)) {
+            break;
+          }
+
+          NMEA_Out(settings->nmea_out, (byte *) NMEABuffer, size, false);
+        }
+
+        Traffic_Export_Done(EXPORT_SINK_NMEA, &Container[i]);
+      }
+
+      for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
+        if (Container[i].addr &&
+            (this_moment - Container[i].timestamp) <= EXPORT_EXPIRATION_TIME &&
+            Container[i].distance < ALARM_ZONE_NONE) {
+
+          total_objects++;
+
+          distance = Container[i].distance;
+          alt_diff = (int) (Container[i].altitude - ThisAircraft.altitude);
+
+          /* Most close traffic is treated as highest priority target */
+          if (distance < HP_distance && abs(alt_diff) < VERTICAL_VISIBILITY_RANGE) {
+            HP_bearing = Container[i].bearing;
+            HP_alt_diff = alt_diff;
+            HP_alarm_level = Container[i].alarm_level;
+            HP_distance = distance;
+            HP_addr = Container[i].addr;
           }
         }
       }
     }
 
-    /* One PFLAU NMEA sentence is mandatory regardless of traffic reception status */
-    if (settings->nmea_l) {
+    /*
+     * One PFLAU NMEA sentence per second is mandatory regardless of traffic
+     * reception status. Fast cycles repeat it while there is an alarm.
+     */
+    if (settings->nmea_l &&
+        (Traffic_Export_Full || HP_alarm_level >= ALARM_LEVEL_IMPORTANT)) {
       float voltage    = Battery_voltage();
       int power_status = voltage > BATTERY_THRESHOLD_INVALID &&
                          voltage < Battery_threshold() ?
@@ -559,14 +623,16 @@ void NMEA_Export()
       NMEA_Out(settings->nmea_out, (byte *) NMEABuffer, strlen(NMEABuffer), false);
 
 #if !defined(EXCLUDE_SOFTRF_HEARTBEAT)
-      snprintf_P(NMEABuffer, sizeof(NMEABuffer),
-              PSTR("$PSRFH,%06X,%d,%d,%d,%d*"),
-              ThisAircraft.addr,settings->rf_protocol,
-              rx_packets_counter,tx_packets_counter,(int)(voltage*100));
+      if (Traffic_Export_Full) {
+        snprintf_P(NMEABuffer, sizeof(NMEABuffer),
+                PSTR("$PSRFH,%06X,%d,%d,%d,%d*"),
+                ThisAircraft.addr,settings->rf_protocol,
+                rx_packets_counter,tx_packets_counter,(int)(voltage*100));
 
-      NMEA_add_checksum(NMEABuffer, sizeof(NMEABuffer) - strlen(NMEABuffer));
+        NMEA_add_checksum(NMEABuffer, sizeof(NMEABuffer) - strlen(NMEABuffer));
 
-      NMEA_Out(settings->nmea_out, (byte *) NMEABuffer, strlen(NMEABuffer), false);
+        NMEA_Out(settings->nmea_out, (byte *) NMEABuffer, strlen(NMEABuffer), false);
+      }
 #endif /* EXCLUDE_SOFTRF_HEARTBEAT */
     }
 }
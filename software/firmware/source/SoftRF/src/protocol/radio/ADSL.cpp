@@ -112,6 +112,14 @@ bool adsl_decode(void *pkt, ufo_t *this_aircraft, ufo_t *fop) {
 
   uint8_t *ptr = (uint8_t *) pkt;
 
+  /*
+   * Radio drivers do check (and repair) CRC of a frame.
+   * Raw frames that come over network or from a replay log do not.
+   */
+  if (ADSL_Packet::Repair(ptr, ADSL_PAYLOAD_SIZE + ADSL_CRC_SIZE) < 0) {
+    return false;
+  }
+
   r.Init();
   r.Version = *ptr;
   ptr += sizeof(ADSL_Packet::Version);
@@ -162,9 +170,10 @@ size_t adsl_encode(void *pkt, ufo_t *this_aircraft) {
   pos.Speed   = (int16_t) (this_aircraft->speed * 10 * _GPS_MPS_PER_KNOT);
   pos.HDOP    = (uint8_t) (this_aircraft->hdop / 10);
 
-  pos.Sec     = second();
+  /* from the time sample - this may run in the RF task */
+  pos.Sec     = RF_Slot_Time % 60;
   // pos.Sec     = gnss.time.second();
-  pos.FracSec = gnss.time.centisecond();
+  pos.FracSec = RF_Slot_CSec;
 
   t.Init();
   t.setAddress(this_aircraft->addr);
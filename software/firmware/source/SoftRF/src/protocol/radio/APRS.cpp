@@ -121,117 +121,152 @@ char APRS_FromCall[10] = "";
 char APRS_ToCall  [10] = "OGFLR"; // TODO: make use of assigned APSRFx value
 char APRS_Path    [10] = "";      // "WIDE1-1"
 
-int packet2Raw(String &tnc2, AX25Msg &Packet) {
-  if (Packet.len < 5) return 0;
-
-  tnc2 = String(Packet.src.call);
+/*
+ * TNC2 text is built straight in the parser buffer.
+ * Callsign and path pointers are set while the header is written,
+ * so there is no need to scan the text over again.
+ */
+static size_t aprs_put_call(char *dst, size_t size, const AX25Call *call)
+{
+  size_t len = strnlen(call->call, sizeof(call->call));
 
-  if (Packet.src.ssid > 0) {
-      tnc2 += String(F("-"));
-      tnc2 += String(Packet.src.ssid);
+  if (len + 5 /* -15, repeated mark and a delimiter */ > size) {
+    return 0;
   }
 
-  tnc2 += String(F(">"));
-  tnc2 += String(Packet.dst.call);
+  memcpy(dst, call->call, len);
 
-  if (Packet.dst.ssid > 0) {
-      tnc2 += String(F("-"));
-      tnc2 += String(Packet.dst.ssid);
+  if (call->ssid > 0) {
+    dst[len++] = '-';
+    if (call->ssid > 9) {
+      dst[len++] = '1';
+    }
+    dst[len++] = '0' + call->ssid % 10;
   }
 
-  for (int i = 0; i < Packet.rpt_count; i++) {
-      tnc2 += String(",");
-      tnc2 += String(Packet.rpt_list[i].call);
-      if (Packet.rpt_list[i].ssid > 0) {
-          tnc2 += String("-");
-          tnc2 += String(Packet.rpt_list[i].ssid);
-      }
-      if (Packet.rpt_flags & (1 << i)) tnc2 += "*";
-  }
+  return len;
+}
 
-  tnc2 += String(F(":"));
-  tnc2 += String((const char *)Packet.info);
-  tnc2 += String("\n");
+static bool aprs_parse(ufo_t *this_aircraft, ufo_t *fop)
+{
+  if (aprsParse.parse_aprs(&aprs))
+  {
+#if 0 // ndef RASPBERRY_PI
+    Serial.print("lat: "); Serial.println(aprs.lat);
+    Serial.print("lon: "); Serial.println(aprs.lng);
+    Serial.print("alt: "); Serial.println(aprs.altitude);
+    Serial.print("crs: "); Serial.println(aprs.course);
+    Serial.print("spd: "); Serial.println(aprs.speed);
+    Serial.print("id:  "); Serial.println(aprs.ogn_id, HEX);
+#endif
+
+    fop->protocol  = RF_PROTOCOL_APRS;
 
-  // #ifdef DEBUG_TNC
-  //     Serial.printf("[%d] ", ++pkgTNC_count);
-  //     Serial.print(tnc2);
-  // #endif
+    fop->addr      = aprs.ogn_id & 0x00FFFFFF;
+    fop->latitude  = aprs.lat;
+    fop->longitude = aprs.lng;
+    fop->altitude  = (float) aprs.altitude;                   /* metres */
+    fop->course    = (aprs.course == 360) ? 0 : (float) aprs.course;
+    fop->speed     = (float) aprs.speed / _GPS_KMPH_PER_KNOT; /* knots  */
+    fop->timestamp = (uint32_t) this_aircraft->timestamp;
 
-  return tnc2.length();
+    uint8_t XX         = (aprs.ogn_id >> 24) & 0xFF;
+    fop->addr_type     = XX & 0x3;
+    fop->aircraft_type = (XX >> 2) & 0xF;
+    fop->no_track      = (XX >> 6) & 0x1;
+    fop->stealth       = (XX >> 7) & 0x1;
+
+    if (fop->addr) return true;
+  }
+
+  return false;
 }
 
 bool aprs_decode(void *pkt, ufo_t *this_aircraft, ufo_t *fop) {
 
-  String tnc2((char *) pkt);
+  const char *tnc2 = (const char *) pkt;
 
-  // Serial.println("APRS RX: " + tnc2);
+  // Serial.print("APRS RX: "); Serial.println(tnc2);
 
-  int start_val = tnc2.indexOf(">", 0);
-  if (start_val > 3)
-  {
-    String src_call = tnc2.substring(0, start_val);
-    memset(&aprs, 0, sizeof(pbuf_t));
-    aprs.buf_len = 300;
-    aprs.packet_len = tnc2.length();
-    tnc2.toCharArray(&aprs.data[0], aprs.packet_len);
-    int start_info = tnc2.indexOf(":", 0);
-    int end_ssid = tnc2.indexOf(",", 0);
-    int start_dst = tnc2.indexOf(">", 2);
-    int start_dstssid = tnc2.indexOf("-", start_dst);
-    if ((start_dstssid > start_dst) && (start_dstssid < start_dst + 10))
-    {
-        aprs.dstcall_end_or_ssid = &aprs.data[start_dstssid];
-    }
-    else
-    {
-        aprs.dstcall_end_or_ssid = &aprs.data[end_ssid];
-    }
-    aprs.info_start = &aprs.data[start_info + 1];
-    aprs.dstname = &aprs.data[start_dst + 1];
-    aprs.dstname_len = end_ssid - start_dst;
-    aprs.dstcall_end = &aprs.data[end_ssid];
-    aprs.srccall_end = &aprs.data[start_dst];
-
-    if (aprsParse.parse_aprs(&aprs))
-    {
-#if 0 // ndef RASPBERRY_PI
-      Serial.print("lat: "); Serial.println(aprs.lat);
-      Serial.print("lon: "); Serial.println(aprs.lng);
-      Serial.print("alt: "); Serial.println(aprs.altitude);
-      Serial.print("crs: "); Serial.println(aprs.course);
-      Serial.print("spd: "); Serial.println(aprs.speed);
-      Serial.print("id:  "); Serial.println(aprs.ogn_id, HEX);
-#endif
+  memset(&aprs, 0, sizeof(pbuf_t));
+  aprs.buf_len = sizeof(aprs.data);
 
-      fop->protocol  = RF_PROTOCOL_APRS;
+  size_t len = strnlen(tnc2, sizeof(aprs.data) - 1);
+  memcpy(aprs.data, tnc2, len);
+  aprs.data[len] = 0;
+  aprs.packet_len = len + 1;
 
-      fop->addr      = aprs.ogn_id & 0x00FFFFFF;
-      fop->latitude  = aprs.lat;
-      fop->longitude = aprs.lng;
-      fop->altitude  = (float) aprs.altitude;                   /* metres */
-      fop->course    = (aprs.course == 360) ? 0 : (float) aprs.course;
-      fop->speed     = (float) aprs.speed / _GPS_KMPH_PER_KNOT; /* knots  */
-      fop->timestamp = (uint32_t) this_aircraft->timestamp;
+  const char *start_dst  = (const char *) memchr(aprs.data, '>', len);
+  const char *start_info = (const char *) memchr(aprs.data, ':', len);
 
-      uint8_t XX         = (aprs.ogn_id >> 24) & 0xFF;
-      fop->addr_type     = XX & 0x3;
-      fop->aircraft_type = (XX >> 2) & 0xF;
-      fop->no_track      = (XX >> 6) & 0x1;
-      fop->stealth       = (XX >> 7) & 0x1;
+  if (start_dst == NULL || start_dst - aprs.data <= 3 ||
+      start_info == NULL || start_info < start_dst) {
+    return false;
+  }
 
-      if (fop->addr) return true;
-    }
+  const char *end_dst = (const char *) memchr(start_dst, ',', start_info - start_dst);
+  if (end_dst == NULL) {
+    end_dst = start_info;
   }
 
-  return false;
+  const char *start_dstssid = (const char *) memchr(start_dst, '-', end_dst - start_dst);
+
+  aprs.srccall_end         = start_dst;
+  aprs.dstcall_end_or_ssid = start_dstssid ? start_dstssid : end_dst;
+  aprs.dstcall_end         = end_dst;
+  aprs.dstname             = start_dst + 1;
+  aprs.dstname_len         = end_dst - start_dst - 1;
+  aprs.info_start          = start_info + 1;
+
+  return aprs_parse(this_aircraft, fop);
 }
 
 bool ax25_decode(void *pkt, ufo_t *this_aircraft, ufo_t *fop) {
-  String tnc2;
-  packet2Raw(tnc2, Incoming_APRS_Packet);
+  AX25Msg *Packet = &Incoming_APRS_Packet;
+
+  if (Packet->len < 5) return false;
+
+  memset(&aprs, 0, sizeof(pbuf_t));
+  aprs.buf_len = sizeof(aprs.data);
+
+  char *p    = aprs.data;
+  char *end  = aprs.data + sizeof(aprs.data) - 1;
+  size_t len;
+
+  if ((len = aprs_put_call(p, end - p, &Packet->src)) <= 3) return false;
+  p += len;
+  aprs.srccall_end = p;
+  *p++ = '>';
+
+  aprs.dstname = p;
+  if ((len = aprs_put_call(p, end - p, &Packet->dst)) == 0) return false;
+  aprs.dstcall_end_or_ssid = p + strnlen(Packet->dst.call, sizeof(Packet->dst.call));
+  p += len;
+  aprs.dstcall_end = p;
+  aprs.dstname_len = p - aprs.dstname;
+
+  for (int i = 0; i < Packet->rpt_count; i++) {
+    *p++ = ',';
+    if ((len = aprs_put_call(p, end - p, &Packet->rpt_list[i])) == 0) return false;
+    p += len;
+    if (Packet->rpt_flags & (1 << i)) *p++ = '*';
+  }
+
+  *p++ = ':';
+  aprs.info_start = p;
+
+  size_t info_len = Packet->len < sizeof(Packet->info) ? Packet->len : sizeof(Packet->info);
+  info_len = strnlen((const char *) Packet->info, info_len);
+  if (info_len > (size_t) (end - p)) {
+    info_len = end - p;
+  }
+  memcpy(p, Packet->info, info_len);
+  p += info_len;
+  *p = 0;
+
+  aprs.packet_len = p - aprs.data + 1;
 
-  return aprs_decode((void *) tnc2.c_str(), this_aircraft, fop);
+  return aprs_parse(this_aircraft, fop);
 }
 
 size_t aprs_encode(void *pkt, ufo_t *this_aircraft) {
@@ -206,98 +206,488 @@ static void payload_absolut2coord(float *lat, float *lon, uint8_t *buf)
 /* ------------------------------------------------------------------------- */
 #endif
 
-bool fanet_decode(void *fanet_pkt, ufo_t *this_aircraft, ufo_t *fop) {
+/* ------------------------------------------------------------------------- */
 
-  fanet_packet_t *pkt = (fanet_packet_t *) fanet_pkt;
-  unsigned int altitude;
-  uint8_t speed_byte, climb_byte, offset_byte;
-  int speed_int, climb_int, offset_int;
-  bool rval = false;
+extern size_t RF_rx_size;
+
+typedef struct fanet_dedup_struct {
+  uint32_t src;
+  uint16_t hash;
+  uint8_t  type;
+  uint8_t  bucket;
+} fanet_dedup_t;
+
+typedef struct fanet_name_struct {
+  uint32_t addr;
+  uint8_t  name[8];
+} fanet_name_t;
+
+typedef struct fanet_fwd_struct {
+  uint8_t       frame[MAX_PKT_SIZE];
+  uint8_t       size;
+  int8_t        rssi;
+  uint8_t       type;
+  uint16_t      hash;
+  uint32_t      src;
+  unsigned long marker; /* ms */
+  unsigned long due;    /* ms */
+} fanet_fwd_t;
+
+static fanet_dedup_t fanet_dedup[FANET_DEDUP_SIZE];
+static uint8_t       fanet_dedup_next = 0;
 
-  if (pkt->ext_header == 0 && pkt->type == 1 ) {  /* Tracking  */
+static fanet_name_t  fanet_names[FANET_NAME_CACHE_SIZE];
+static uint8_t       fanet_names_next = 0;
 
-    /* ignore this device own (relayed) packets */
-    if (pkt->vendor  == SOFRF_FANET_VENDOR_ID &&
-        pkt->address == (this_aircraft->addr & 0xFFFF) /* && */
-        /* pkt->forward == 1 */) {
-      return rval;
+static fanet_fwd_t   fanet_fwd[FANET_FWD_QUEUE_SIZE];
+
+/* forwarding airtime allowance, in microseconds */
+static uint32_t      fanet_fwd_budget = FANET_FWD_AIRTIME_WINDOW_MS *
+                                        FANET_FWD_DUTY_PERMILLE;
+static unsigned long fanet_fwd_marker = 0;
+
+fanet_service_t fanet_service;
+fanet_stats_t   fanet_stats;
+
+static uint16_t fanet_hash(const uint8_t *data, size_t size)
+{
+  uint32_t h = 2166136261UL;
+
+  while (size--) {
+    h ^= *data++;
+    h *= 16777619UL;
+  }
+
+  return (uint16_t) (h ^ (h >> 16));
+}
+
+static bool fanet_dedup_seen(uint32_t src, uint8_t type, uint16_t hash)
+{
+  uint8_t bucket = millis() / FANET_DEDUP_BUCKET_MS;
+
+  for (int i=0; i < FANET_DEDUP_SIZE; i++) {
+    fanet_dedup_t *e = &fanet_dedup[i];
+
+    if (e->src == src && e->type == type && e->hash == hash &&
+        (uint8_t) (bucket - e->bucket) < FANET_DEDUP_BUCKETS) {
+      return true;
     }
+  }
 
-    fop->protocol = RF_PROTOCOL_FANET;
-    fop->addr     = (pkt->vendor << 16) | pkt->address;
+  return false;
+}
 
-#if defined(FANET_DEPRECATED)
-    fop->latitude  = payload_compressed2coord(pkt->latitude, this_aircraft->latitude);
-    fop->longitude = payload_compressed2coord(pkt->longitude, this_aircraft->longitude);
-#else
-    payload_absolut2coord(&(fop->latitude), &(fop->longitude),
-      ((uint8_t *) pkt) + FANET_HEADER_SIZE);
-#endif
+static void fanet_dedup_add(uint32_t src, uint8_t type, uint16_t hash)
+{
+  fanet_dedup_t *e = &fanet_dedup[fanet_dedup_next];
 
-    altitude = ((pkt->altitude_msb << 8) | pkt->altitude_lsb);
-    if (pkt->altitude_scale) {
-      altitude = altitude * 4 /* -2 */;
+  fanet_dedup_next = (fanet_dedup_next + 1) % FANET_DEDUP_SIZE;
+
+  e->src    = src;
+  e->type   = type;
+  e->hash   = hash;
+  e->bucket = millis() / FANET_DEDUP_BUCKET_MS;
+}
+
+static void fanet_name_store(uint32_t addr, const uint8_t *name, size_t size)
+{
+  fanet_name_t *e = NULL;
+
+  for (int i=0; i < FANET_NAME_CACHE_SIZE; i++) {
+    if (fanet_names[i].addr == addr) {
+      e = &fanet_names[i];
+      break;
     }
-    fop->altitude = (float) altitude;
+  }
 
-    fop->aircraft_type = AT_FROM_FANET(pkt->aircraft_type);
-    fop->course = (float) pkt->heading * 360.0 / 256.0;
+  if (e == NULL) {
+    e = &fanet_names[fanet_names_next];
+    fanet_names_next = (fanet_names_next + 1) % FANET_NAME_CACHE_SIZE;
+  }
+
+  e->addr = addr;
+  memset(e->name, 0, sizeof(e->name));
+  memcpy(e->name, name, size > sizeof(e->name) ? sizeof(e->name) : size);
+}
+
+static void fanet_name_lookup(uint32_t addr, uint8_t *callsign)
+{
+  for (int i=0; i < FANET_NAME_CACHE_SIZE; i++) {
+    if (fanet_names[i].addr == addr) {
+      memcpy(callsign, fanet_names[i].name, sizeof(fanet_names[i].name));
+      return;
+    }
+  }
 
-    speed_byte = pkt->speed;
-    speed_int = (int) (speed_byte | (speed_byte & (1<<6) ? 0xFFFFFF80U : 0));
+  memset(callsign, 0, sizeof(fanet_names[0].name));
+}
 
-    if (pkt->speed_scale) {
-      speed_int *= 5 /* -2 */;
+static void fanet_fwd_push(const uint8_t *frame, size_t size,
+                           uint32_t src, uint8_t type, uint16_t hash)
+{
+  unsigned long ms = millis();
+
+  for (int i=0; i < FANET_FWD_QUEUE_SIZE; i++) {
+    fanet_fwd_t *e = &fanet_fwd[i];
+
+    if (e->size == 0 || (ms - e->marker) > FANET_FWD_MAX_AGE_MS) {
+      memcpy(e->frame, frame, size);
+      ((fanet_packet_t *) e->frame)->forward = 0; /* one hop only */
+
+      e->size   = size;
+      e->rssi   = RF_last_rssi;
+      e->type   = type;
+      e->hash   = hash;
+      e->src    = src;
+      e->marker = ms;
+      e->due    = ms + SoC->random(FANET_FWD_DELAY_MIN, FANET_FWD_DELAY_MAX);
+      return;
     }
-    fop->speed = ((float) speed_int) / (2 * _GPS_KMPH_PER_KNOT);
+  }
+}
+
+/*
+ * A copy of a frame which waits in the queue. Somebody has relayed it
+ * already - when it is much louder than the original, towards our direction
+ */
+static bool fanet_fwd_cancel(uint32_t src, uint8_t type, uint16_t hash)
+{
+  bool queued = false;
 
-    climb_byte = pkt->climb;
-    climb_int = (int) (climb_byte | (climb_byte & (1<<6) ? 0xFFFFFF80U : 0));
+  for (int i=0; i < FANET_FWD_QUEUE_SIZE; i++) {
+    fanet_fwd_t *e = &fanet_fwd[i];
 
-    if (pkt->climb_scale) {
-      climb_int *= 5 /* +-2 */;
+    if (e->size && e->src == src && e->type == type && e->hash == hash) {
+      queued = true;
+      if (RF_last_rssi > e->rssi + FANET_FWD_RSSI_BOOST) {
+        e->size = 0;
+        fanet_stats.cancelled++;
+      }
     }
-    fop->vs = ((float)climb_int) * (_GPS_FEET_PER_METER * 6.0);
+  }
 
-#if defined(FANET_NEXT)
-    offset_byte = pkt->qne_offset;
-    offset_int = (int) (offset_byte | (offset_byte & (1<<6) ? 0xFFFFFF80U : 0));
+  return queued;
+}
+
+/*
+ * Relayed frames are extra transmissions in between own time slots,
+ * as FANET MAC does. Own position rate is not affected.
+ */
+size_t fanet_forward(void *buf)
+{
+  unsigned long ms = millis();
+  uint32_t gain    = (ms - fanet_fwd_marker) * FANET_FWD_DUTY_PERMILLE;
+  uint32_t cap     = FANET_FWD_AIRTIME_WINDOW_MS * FANET_FWD_DUTY_PERMILLE;
+
+  fanet_fwd_marker = ms;
+  fanet_fwd_budget = (cap - fanet_fwd_budget) > gain ?
+                      fanet_fwd_budget + gain : cap;
+
+  fanet_fwd_t *oldest = NULL;
+
+  for (int i=0; i < FANET_FWD_QUEUE_SIZE; i++) {
+    fanet_fwd_t *e = &fanet_fwd[i];
 
-    if (pkt->qne_scale) {
-      offset_int *= 4;
+    if (e->size == 0) {
+      continue;
     }
+    if ((ms - e->marker) > FANET_FWD_MAX_AGE_MS) {
+      e->size = 0;
+      continue;
+    }
+    if ((long) (ms - e->due) < 0) {
+      continue;
+    }
+    if (oldest == NULL || (ms - e->marker) > (ms - oldest->marker)) {
+      oldest = e;
+    }
+  }
+
+  if (oldest == NULL) {
+    return 0;
+  }
+
+  size_t size   = oldest->size;
+  uint32_t cost = (uint32_t) FANET_AIR_TIME * 1000 *
+                  (size > FANET_PAYLOAD_SIZE ? size : FANET_PAYLOAD_SIZE) /
+                  FANET_PAYLOAD_SIZE;
+
+  if (fanet_fwd_budget < cost) {
+    fanet_stats.deferred++;
+    return 0;
+  }
+
+  memcpy(buf, oldest->frame, size);
+  oldest->size = 0;
+
+  fanet_fwd_budget -= cost;
+  fanet_stats.forwarded++;
+
+  return size;
+}
+
+static void fanet_decode_common(uint32_t src, ufo_t *this_aircraft, ufo_t *fop)
+{
+  fop->protocol  = RF_PROTOCOL_FANET;
+  fop->addr      = src;
+  fop->addr_type = ADDR_TYPE_FANET;
+  fop->timestamp = this_aircraft->timestamp;
+
+  fop->stealth = 0;
+
+  fop->ns[0] = 0; fop->ns[1] = 0;
+  fop->ns[2] = 0; fop->ns[3] = 0;
+  fop->ew[0] = 0; fop->ew[1] = 0;
+  fop->ew[2] = 0; fop->ew[3] = 0;
+
+  fanet_name_lookup(src, fop->callsign);
+}
 
-    fop->pressure_altitude = fop->altitude + (float) offset_int;
+static bool fanet_decode_tracking(fanet_packet_t *pkt, ufo_t *this_aircraft, ufo_t *fop) {
+
+  unsigned int altitude;
+  uint8_t speed_byte, climb_byte, offset_byte;
+  int speed_int, climb_int, offset_int;
+
+  fanet_decode_common((pkt->vendor << 16) | pkt->address, this_aircraft, fop);
+
+#if defined(FANET_DEPRECATED)
+  fop->latitude  = payload_compressed2coord(pkt->latitude, this_aircraft->latitude);
+  fop->longitude = payload_compressed2coord(pkt->longitude, this_aircraft->longitude);
+#else
+  payload_absolut2coord(&(fop->latitude), &(fop->longitude),
+    ((uint8_t *) pkt) + FANET_HEADER_SIZE);
 #endif
 
-    fop->addr_type = ADDR_TYPE_FANET;
-    fop->timestamp = this_aircraft->timestamp;
+  altitude = ((pkt->altitude_msb << 8) | pkt->altitude_lsb);
+  if (pkt->altitude_scale) {
+    altitude = altitude * 4 /* -2 */;
+  }
+  fop->altitude = (float) altitude;
+
+  fop->aircraft_type = AT_FROM_FANET(pkt->aircraft_type);
+  fop->course = (float) pkt->heading * 360.0 / 256.0;
 
-    fop->stealth = 0;
-    fop->no_track = !(pkt->track_online);
+  speed_byte = pkt->speed;
+  speed_int = (int) (speed_byte | (speed_byte & (1<<6) ? 0xFFFFFF80U : 0));
 
-    fop->ns[0] = 0; fop->ns[1] = 0;
-    fop->ns[2] = 0; fop->ns[3] = 0;
-    fop->ew[0] = 0; fop->ew[1] = 0;
-    fop->ew[2] = 0; fop->ew[3] = 0;
+  if (pkt->speed_scale) {
+    speed_int *= 5 /* -2 */;
+  }
+  fop->speed = ((float) speed_int) / (2 * _GPS_KMPH_PER_KNOT);
+
+  climb_byte = pkt->climb;
+  climb_int = (int) (climb_byte | (climb_byte & (1<<6) ? 0xFFFFFF80U : 0));
+
+  if (pkt->climb_scale) {
+    climb_int *= 5 /* +-2 */;
+  }
+  fop->vs = ((float)climb_int) * (_GPS_FEET_PER_METER * 6.0);
+
+#if defined(FANET_NEXT)
+  offset_byte = pkt->qne_offset;
+  offset_int = (int) (offset_byte | (offset_byte & (1<<6) ? 0xFFFFFF80U : 0));
+
+  if (pkt->qne_scale) {
+    offset_int *= 4;
+  }
+
+  fop->pressure_altitude = fop->altitude + (float) offset_int;
+#endif
+
+  fop->no_track = !(pkt->track_online);
 #if 0
-    Serial.print(fop->addr, HEX);
-    Serial.print(',');
-    Serial.print(fop->aircraft_type, HEX);
-    Serial.print(',');
-    Serial.print(fop->latitude, 6);
-    Serial.print(',');
-    Serial.print(fop->longitude, 6);
-    Serial.print(',');
-    Serial.print(fop->altitude);
-    Serial.print(',');
-    Serial.print(fop->speed);
-    Serial.print(',');
-    Serial.print(fop->course);
-    Serial.println();
-    Serial.flush();
+  Serial.print(fop->addr, HEX);
+  Serial.print(',');
+  Serial.print(fop->aircraft_type, HEX);
+  Serial.print(',');
+  Serial.print(fop->latitude, 6);
+  Serial.print(',');
+  Serial.print(fop->longitude, 6);
+  Serial.print(',');
+  Serial.print(fop->altitude);
+  Serial.print(',');
+  Serial.print(fop->speed);
+  Serial.print(',');
+  Serial.print(fop->course);
+  Serial.println();
+  Serial.flush();
 #endif
-    rval = true;
+
+  return true;
+}
+
+#if !defined(FANET_DEPRECATED)
+
+/* 0.2 km/h units, bit 7 is x5 scale */
+static float fanet_wind_speed(uint8_t val)
+{
+  return (float) ((val & 0x7F) * (val & 0x80 ? 5 : 1)) / 5.0f;
+}
+
+static bool fanet_decode_ground(uint32_t src, uint8_t *payload, size_t size,
+                                ufo_t *this_aircraft, ufo_t *fop) {
+  if (size < 7) {
+    return false;
+  }
+
+  fanet_decode_common(src, this_aircraft, fop);
+
+  payload_absolut2coord(&(fop->latitude), &(fop->longitude), payload);
+
+  /* no altitude in the frame, the object is on the ground */
+  fop->altitude          = 0;
+  fop->pressure_altitude = 0;
+  fop->aircraft_type     = AIRCRAFT_TYPE_STATIC;
+  fop->course            = 0;
+  fop->speed             = 0;
+  fop->vs                = 0;
+  fop->no_track          = !(payload[6] & 0x01);
+
+  return true;
+}
+
+static void fanet_decode_service(uint32_t src, uint8_t *payload, size_t size,
+                                 ufo_t *this_aircraft) {
+  uint8_t *p   = payload;
+  uint8_t *end = payload + size;
+  fanet_service_t srv;
+
+  if (p >= end) {
+    return;
+  }
+
+  memset(&srv, 0, sizeof(srv));
+  srv.addr      = src;
+  srv.timestamp = this_aircraft->timestamp;
+  srv.header    = *p++;
+
+  if (srv.header & FANET_SRV_EXTENDED) {
+    p++;
+  }
+
+  if (srv.header & FANET_SRV_POSITION) {
+    if (p + 6 > end) {
+      return;
+    }
+    payload_absolut2coord(&srv.latitude, &srv.longitude, p);
+    p += 6;
+  }
+
+  if ((srv.header & FANET_SRV_TEMPERATURE) && p < end) {
+    srv.temperature = (float) ((int8_t) *p++) / 2.0f;
+  }
+
+  if ((srv.header & FANET_SRV_WIND) && p + 3 <= end) {
+    srv.wind_dir   = (float) p[0] * 360.0 / 256.0;
+    srv.wind_speed = fanet_wind_speed(p[1]);
+    srv.wind_gust  = fanet_wind_speed(p[2]);
+    p += 3;
+  }
+
+  if ((srv.header & FANET_SRV_HUMIDITY) && p < end) {
+    srv.humidity = (float) *p++ * 0.4f;
+  }
+
+  if ((srv.header & FANET_SRV_BARO) && p + 2 <= end) {
+    srv.pressure = (float) (p[0] | (p[1] << 8)) / 10.0f + 430.0f;
+    p += 2;
+  }
+
+  if ((srv.header & FANET_SRV_SOC) && p < end) {
+    srv.charge = (*p++ & 0x0F) * 100 / 15;
+  }
+
+  fanet_service = srv;
+}
+
+#endif /* FANET_DEPRECATED */
+
+bool fanet_decode(void *fanet_pkt, ufo_t *this_aircraft, ufo_t *fop) {
+
+  fanet_packet_t *pkt = (fanet_packet_t *) fanet_pkt;
+  uint8_t *frame      = (uint8_t *) fanet_pkt;
+  size_t size         = RF_rx_size > FANET_HEADER_SIZE &&
+                        RF_rx_size <= MAX_PKT_SIZE ?
+                        RF_rx_size : FANET_PAYLOAD_SIZE;
+  size_t offset       = FANET_HEADER_SIZE;
+  bool unicast        = false;
+  uint32_t src        = (pkt->vendor << 16) | pkt->address;
+  bool rval           = false;
+
+  /* ignore this device own (relayed) packets */
+  if (pkt->vendor  == SOFRF_FANET_VENDOR_ID &&
+      pkt->address == (this_aircraft->addr & 0xFFFF)) {
+    return rval;
+  }
+
+  if (pkt->ext_header) {
+    uint8_t ext = frame[offset++];
+
+    if (ext & FANET_EXT_UNICAST) {
+      unicast = true;
+      offset += 3;
+    }
+    if (ext & FANET_EXT_SIGNATURE) {
+      offset += 4;
+    }
+  }
+
+  if (offset >= size) {
+    return rval;
+  }
+
+  uint8_t *payload = frame + offset;
+  size_t   len     = size - offset;
+  uint8_t  type    = pkt->type;
+  uint16_t hash    = fanet_hash(payload, len);
+
+  /*
+   * Original and relayed copies carry the same payload. Only a relayed
+   * copy (forward bit is cleared) or one of a frame which we are about
+   * to relay ourselves is a duplicate: a stationary sender repeats
+   * identical originals
+   */
+  bool queued = fanet_fwd_cancel(src, type, hash);
+
+  if (queued || (!pkt->forward && fanet_dedup_seen(src, type, hash))) {
+    fanet_stats.duplicates++;
+    return rval;
+  }
+  fanet_dedup_add(src, type, hash);
+
+  if (pkt->forward && !unicast && RF_last_rssi <= FANET_FWD_MAX_RSSI) {
+    fanet_fwd_push(frame, size, src, type, hash);
+  }
+
+  switch (type)
+  {
+  case FANET_TYPE_TRACKING:
+    {
+      fanet_packet_t trk;
+
+      memset(&trk, 0, sizeof(trk));
+      memcpy(&trk, frame, FANET_HEADER_SIZE);
+      memcpy(((uint8_t *) &trk) + FANET_HEADER_SIZE, payload,
+             len < sizeof(trk) - FANET_HEADER_SIZE ?
+             len : sizeof(trk) - FANET_HEADER_SIZE);
+
+      rval = fanet_decode_tracking(&trk, this_aircraft, fop);
+    }
+    break;
+  case FANET_TYPE_NAME:
+    fanet_name_store(src, payload, len);
+    break;
+#if !defined(FANET_DEPRECATED)
+  case FANET_TYPE_SERVICE:
+    fanet_decode_service(src, payload, len, this_aircraft);
+    break;
+  case FANET_TYPE_GROUND_TRACKING:
+    rval = fanet_decode_ground(src, payload, len, this_aircraft, fop);
+    break;
+#endif /* FANET_DEPRECATED */
+  default:
+    break;
   }
 
   return rval;
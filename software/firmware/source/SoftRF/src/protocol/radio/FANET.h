@@ -40,6 +40,18 @@
 
 #define SOFRF_FANET_VENDOR_ID       0x07
 
+enum
+{
+	FANET_TYPE_ACK,
+	FANET_TYPE_TRACKING,
+	FANET_TYPE_NAME,
+	FANET_TYPE_MESSAGE,
+	FANET_TYPE_SERVICE,
+	FANET_TYPE_LANDMARK,
+	FANET_TYPE_REMOTE_CONFIG,
+	FANET_TYPE_GROUND_TRACKING
+};
+
 //#define FANET_NEXT
 
 enum
@@ -103,14 +115,76 @@ typedef struct {
 #define FANET_PAYLOAD_SIZE    sizeof(fanet_packet_t)
 #define FANET_HEADER_SIZE     4
 
+/* extended header byte */
+#define FANET_EXT_UNICAST     0x20 /* 3 bytes of destination address follow */
+#define FANET_EXT_SIGNATURE   0x10 /* 4 bytes of signature follow */
+
+/* service frame (#4) header bits */
+#define FANET_SRV_GATEWAY     0x80
+#define FANET_SRV_TEMPERATURE 0x40
+#define FANET_SRV_WIND        0x20
+#define FANET_SRV_HUMIDITY    0x10
+#define FANET_SRV_BARO        0x08
+#define FANET_SRV_REMOTE_CFG  0x04
+#define FANET_SRV_SOC         0x02
+#define FANET_SRV_EXTENDED    0x01
+#define FANET_SRV_POSITION    (FANET_SRV_TEMPERATURE | FANET_SRV_WIND | \
+                               FANET_SRV_HUMIDITY | FANET_SRV_BARO | FANET_SRV_SOC)
+
+#define FANET_NAME_CACHE_SIZE 8
+
+/*
+ * duplicates cache: (source, type, payload hash) over a few time buckets.
+ * The window stays under FANET_TX_INTERVAL_MIN: a stationary sender
+ * repeats the very same frame on every transmission
+ */
+#define FANET_DEDUP_SIZE      16
+#define FANET_DEDUP_BUCKET_MS 1000
+#define FANET_DEDUP_BUCKETS   2
+
+/* forwarding rules, as of FANET MAC */
+#define FANET_FWD_QUEUE_SIZE  2
+#define FANET_FWD_MAX_RSSI    -90  /* dBm, stronger ones are heard by all */
+#define FANET_FWD_RSSI_BOOST  20   /* dB over ours, a louder relayed copy cancels it */
+#define FANET_FWD_MAX_AGE_MS  5000
+#define FANET_FWD_DELAY_MIN   300  /* ms, lets a louder relay cancel ours */
+#define FANET_FWD_DELAY_MAX   1200
+#define FANET_FWD_DUTY_PERMILLE     5
+#define FANET_FWD_AIRTIME_WINDOW_MS 20000
+
 #define FANET_AIR_TIME        36   /* in ms */
 
 #define FANET_TX_INTERVAL_MIN 2500 /* in ms */
 #define FANET_TX_INTERVAL_MAX 3500
 
+typedef struct fanet_service_struct {
+  uint32_t      addr;
+  time_t        timestamp;
+  uint8_t       header;       /* FANET_SRV_* bits */
+  float         latitude;
+  float         longitude;
+  float         temperature;  /* Celsius */
+  float         wind_dir;     /* degrees */
+  float         wind_speed;   /* km/h */
+  float         wind_gust;    /* km/h */
+  float         humidity;     /* % */
+  float         pressure;     /* hPa */
+  uint8_t       charge;       /* % */
+} fanet_service_t;
+
+typedef struct fanet_stats_struct {
+  uint32_t duplicates;
+  uint32_t forwarded;
+  uint32_t cancelled;
+  uint32_t deferred;  /* out of airtime */
+} fanet_stats_t;
+
 extern const rf_proto_desc_t fanet_proto_desc;
+extern fanet_service_t fanet_service;
+extern fanet_stats_t   fanet_stats;
 
 bool fanet_decode(void *, ufo_t *, ufo_t *);
 size_t fanet_encode(void *, ufo_t *);
+size_t fanet_forward(void *);
 
 #endif /* PROTOCOL_FANET_H */
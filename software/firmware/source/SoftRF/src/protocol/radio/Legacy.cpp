@@ -27,6 +27,7 @@
 #include "../../../SoftRF.h"
 #include "../../driver/RF.h"
 #include "../../driver/EEPROM.h"
+#include "../../system/RFTask.h"
 
 const rf_proto_desc_t legacy_proto_desc = {
   .name            = {'L','e','g','a','c','y', 0},
@@ -194,8 +195,8 @@ static bool legacy_v6_decode(void *legacy_pkt, ufo_t *this_aircraft, ufo_t *fop)
     }
     if (pkt_parity % 2) {
         if (settings->nmea_p) {
-          StdOut.print(F("$PSRFE,bad parity of decoded packet: "));
-          StdOut.println(pkt_parity % 2, HEX);
+          RFOut.print(F("$PSRFE,bad parity of decoded packet: "));
+          RFOut.println(pkt_parity % 2, HEX);
         }
         return false;
     }
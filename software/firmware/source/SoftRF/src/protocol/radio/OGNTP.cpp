@@ -153,9 +153,10 @@ size_t ogntp_encode(void *pkt, ufo_t *this_aircraft) {
   pos.Speed   = (int16_t) (this_aircraft->speed * 10 * _GPS_MPS_PER_KNOT);
   pos.HDOP    = (uint8_t) (this_aircraft->hdop / 10);
 
-  pos.Sec     = second();
+  /* from the time sample - this may run in the RF task */
+  pos.Sec     = RF_Slot_Time % 60;
   // pos.Sec     = gnss.time.second();
-  pos.FracSec = gnss.time.centisecond();
+  pos.FracSec = RF_Slot_CSec;
 
   pos.Encode(ogn_tx_pkt.Packet);
 
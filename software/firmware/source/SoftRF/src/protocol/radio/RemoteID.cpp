@@ -23,6 +23,8 @@
 #include "../../../SoftRF.h"
 #include "../../driver/RF.h"
 #include "../../driver/EEPROM.h"
+#include "../../TrafficHelper.h"
+#include "RemoteID.h"
 
 #if defined(ENABLE_REMOTE_ID)
 #include <id_open.h>
@@ -151,10 +153,286 @@ size_t rid_encode(void *pkt, ufo_t *this_aircraft) {
   return 0;
 }
 
+/* ------------------------------------------------------------------------- */
+
+typedef struct rid_rx_msg_struct {
+  uint8_t  mac[6];
+  int8_t   rssi;
+  uint8_t  data[ODID_MESSAGE_SIZE];
+} rid_rx_msg_t;
+
+typedef struct rid_source_struct {
+  uint8_t       mac[6];
+  uint8_t       ua_type;
+  char          uas_id[ODID_ID_SIZE + 1];
+  unsigned long seen;    /* ms */
+  unsigned long bridged; /* ms */
+  unsigned long op_bridged; /* ms, operator position */
+} rid_source_t;
+
+typedef void (*rid_handler_t)(rid_source_t *, const ODID_Message_encoded *, int8_t);
+
+/* single producer (radio stack callback), single consumer (rid_loop) */
+static rid_rx_msg_t     rid_rx_queue[RID_RX_QUEUE_SIZE];
+static volatile uint8_t rid_rx_head = 0;
+static volatile uint8_t rid_rx_tail = 0;
+
+static rid_source_t     rid_sources[RID_RX_SOURCES];
+
+/* 0.5 m resolution, -1000 m offset. Zero is 'invalid' */
+static float rid_altitude(uint16_t raw)
+{
+  return (float) raw * 0.5f - 1000.0f;
+}
+
 bool rid_decode(void *pkt, ufo_t *this_aircraft, ufo_t *fop) {
 
-  /* N/A */
+  const ODID_Location_encoded *loc = (const ODID_Location_encoded *) pkt;
+
+  if (loc->MessageType != ODID_MESSAGETYPE_LOCATION ||
+      (loc->Latitude == 0 && loc->Longitude == 0)) {
+    return false;
+  }
+
+  float alt_geo  = rid_altitude(loc->AltitudeGeo);
+  float alt_baro = rid_altitude(loc->AltitudeBaro);
+
+  if (alt_geo == INV_ALT && alt_baro == INV_ALT) {
+    return false;
+  }
+
+  fop->protocol  = RF_PROTOCOL_EID;
+  fop->addr_type = ADDR_TYPE_RANDOM;
+  fop->timestamp = this_aircraft->timestamp;
+
+  fop->latitude  = (float) loc->Latitude  / 10000000.0f;
+  fop->longitude = (float) loc->Longitude / 10000000.0f;
+  /* geodetic altitude is above WGS-84 ellipsoid */
+  fop->altitude  = alt_geo != INV_ALT ?
+                   alt_geo - this_aircraft->geoid_separation : alt_baro;
+  fop->pressure_altitude = alt_baro != INV_ALT ? alt_baro : 0;
+
+  fop->aircraft_type = AIRCRAFT_TYPE_UAV;
+
+  unsigned int direction = loc->Direction + (loc->EWDirection ? 180 : 0);
+  fop->course = direction < 360 ? (float) direction : 0;
+
+  /* 255 with the multiplier set is 'invalid' */
+  float speed = loc->SpeedMult ?
+                (loc->SpeedHorizontal == 255 ? 0 :
+                 (float) loc->SpeedHorizontal * 0.75f + 255 * 0.25f) :
+                (float) loc->SpeedHorizontal * 0.25f;
+  fop->speed = speed / _GPS_MPS_PER_KNOT;
+
+  float climb = loc->SpeedVertical == (INV_SPEED_V * 2) ? 0 :
+                (float) loc->SpeedVertical * 0.5f;
+  fop->vs = climb * (_GPS_FEET_PER_METER * 60.0);
+
+  fop->stealth  = 0;
+  fop->no_track = 0;
+
+  fop->ns[0] = 0; fop->ns[1] = 0;
+  fop->ns[2] = 0; fop->ns[3] = 0;
+  fop->ew[0] = 0; fop->ew[1] = 0;
+  fop->ew[2] = 0; fop->ew[3] = 0;
+
+  return true;
+}
+
+static void rid_basic_id(rid_source_t *src, const ODID_Message_encoded *msg, int8_t rssi)
+{
+  src->ua_type = msg->basicId.UAType;
+  memcpy(src->uas_id, msg->basicId.UASID, ODID_ID_SIZE);
+  src->uas_id[ODID_ID_SIZE] = 0;
+}
+
+/*
+ * 24 bit address of a UA. UAS ID of the Basic ID message is the identity
+ * that survives a change of the radio. Until one is heard - NIC specific
+ * part of the MAC address, OUI is shared by every UA of a vendor.
+ */
+static uint32_t rid_address(rid_source_t *src)
+{
+  uint32_t addr;
+
+  if (src->uas_id[0]) {
+    const uint8_t *p = (const uint8_t *) src->uas_id;
+
+    addr = 2166136261UL;
+    while (*p) {
+      addr ^= *p++;
+      addr *= 16777619UL;
+    }
+    addr = (addr ^ (addr >> 24)) & 0x00FFFFFF;
+  } else {
+    addr = ((uint32_t) src->mac[3] << 16) | (src->mac[4] << 8) | src->mac[5];
+  }
+
+  return addr ? addr : 1;
+}
+
+static void rid_location(rid_source_t *src, const ODID_Message_encoded *msg, int8_t rssi)
+{
+  /* a UA may beacon at 10 Hz and more - keep the traffic table calm */
+  if (!isValidFix() || (millis() - src->bridged) < RID_RX_INTERVAL_MIN) {
+    return;
+  }
+
+  ufo_t report = EmptyFO;
+
+  if (!rid_decode((void *) msg, &ThisAircraft, &report)) {
+    return;
+  }
+
+  report.addr = rid_address(src);
+  report.rssi = rssi;
+
+  size_t len = strnlen(src->uas_id, ODID_ID_SIZE);
+  if (len > sizeof(report.callsign)) {
+    /* tail of a serial number is the most distinctive part */
+    memcpy(report.callsign, src->uas_id + len - sizeof(report.callsign),
+           sizeof(report.callsign));
+  } else {
+    memcpy(report.callsign, src->uas_id, len);
+  }
+
+  src->bridged = millis();
 
-  return false;
+  Traffic_Update(&report);
+  Traffic_Add(&report);
+}
+
+/* operator of the UA goes to the traffic table as a static ground object */
+static void rid_system(rid_source_t *src, const ODID_Message_encoded *msg, int8_t rssi)
+{
+  const ODID_System_encoded *sys = &msg->system;
+
+  if (!isValidFix() || (millis() - src->op_bridged) < RID_RX_INTERVAL_MIN ||
+      (sys->OperatorLatitude == 0 && sys->OperatorLongitude == 0)) {
+    return;
+  }
+
+  ufo_t report = EmptyFO;
+  float alt_geo = rid_altitude(sys->OperatorAltitudeGeo);
+
+  report.protocol      = RF_PROTOCOL_EID;
+  report.addr_type     = ADDR_TYPE_RANDOM;
+  report.addr          = rid_address(src) ^ RID_RX_OPERATOR_MASK;
+  report.timestamp     = ThisAircraft.timestamp;
+  report.rssi          = rssi;
+
+  report.latitude      = (float) sys->OperatorLatitude  / 10000000.0f;
+  report.longitude     = (float) sys->OperatorLongitude / 10000000.0f;
+  /* ASTM F3411-19 has no operator altitude, the object is on the ground */
+  report.altitude      = alt_geo != INV_ALT ?
+                         alt_geo - ThisAircraft.geoid_separation : 0;
+  report.aircraft_type = AIRCRAFT_TYPE_STATIC;
+
+  src->op_bridged = millis();
+
+  Traffic_Update(&report);
+  Traffic_Add(&report);
+}
+
+static const rid_handler_t rid_handler[] = {
+  rid_basic_id,  /* ODID_MESSAGETYPE_BASIC_ID    */
+  rid_location,  /* ODID_MESSAGETYPE_LOCATION    */
+  NULL,          /* ODID_MESSAGETYPE_AUTH        */
+  NULL,          /* ODID_MESSAGETYPE_SELF_ID     */
+  rid_system,    /* ODID_MESSAGETYPE_SYSTEM      */
+  NULL,          /* ODID_MESSAGETYPE_OPERATOR_ID */
+};
+
+#define RID_HANDLERS  (sizeof(rid_handler) / sizeof(rid_handler[0]))
+
+static void rid_rx_push(const uint8_t *mac, const uint8_t *msg, int8_t rssi)
+{
+  uint8_t type = msg[0] >> 4;
+  uint8_t head = rid_rx_head;
+  uint8_t next = (head + 1) % RID_RX_QUEUE_SIZE;
+
+  /* nothing to do with the rest of message types */
+  if (type >= RID_HANDLERS || rid_handler[type] == NULL || next == rid_rx_tail) {
+    return;
+  }
+
+  rid_rx_msg_t *e = &rid_rx_queue[head];
+
+  memcpy(e->mac, mac, sizeof(e->mac));
+  memcpy(e->data, msg, ODID_MESSAGE_SIZE);
+  e->rssi = rssi;
+
+  rid_rx_head = next;
+}
+
+/*
+ * Entry point for the radio stacks: a single 25 byte message (BLE legacy
+ * advertising) or a message pack (Wi-Fi beacon, BLE long range).
+ * MAC address goes in transmission order, OUI first.
+ * Safe to call from a callback of the stack.
+ */
+bool rid_receive(const uint8_t *mac, const uint8_t *data, size_t size, int8_t rssi) {
+
+  if (size < ODID_MESSAGE_SIZE) {
+    return false;
+  }
+
+  if ((data[0] >> 4) == ODID_MESSAGETYPE_PACKED) {
+    const ODID_MessagePack_encoded *pack = (const ODID_MessagePack_encoded *) data;
+
+    if (pack->SingleMessageSize != ODID_MESSAGE_SIZE ||
+        pack->MsgPackSize > ODID_PACK_MAX_MESSAGES   ||
+        size < offsetof(ODID_MessagePack_encoded, Messages) +
+               pack->MsgPackSize * ODID_MESSAGE_SIZE) {
+      return false;
+    }
+
+    for (int i=0; i < pack->MsgPackSize; i++) {
+      rid_rx_push(mac, pack->Messages[i].rawData, rssi);
+    }
+  } else {
+    rid_rx_push(mac, data, rssi);
+  }
+
+  return true;
+}
+
+static rid_source_t *rid_source(const uint8_t *mac)
+{
+  unsigned long ms = millis();
+  rid_source_t *victim = &rid_sources[0];
+
+  for (int i=0; i < RID_RX_SOURCES; i++) {
+    rid_source_t *src = &rid_sources[i];
+
+    if (src->seen != 0 && memcmp(src->mac, mac, sizeof(src->mac)) == 0) {
+      src->seen = ms;
+      return src;
+    }
+    if (src->seen == 0 || (ms - src->seen) > (ms - victim->seen)) {
+      victim = src;
+    }
+  }
+
+  memset(victim, 0, sizeof(rid_source_t));
+  memcpy(victim->mac, mac, sizeof(victim->mac));
+  victim->seen    = ms ? ms : 1;
+  victim->bridged = ms - RID_RX_INTERVAL_MIN;
+  victim->op_bridged = victim->bridged;
+
+  return victim;
+}
+
+void rid_loop() {
+
+  while (rid_rx_tail != rid_rx_head) {
+    rid_rx_msg_t *e = &rid_rx_queue[rid_rx_tail];
+    uint8_t type    = e->data[0] >> 4;
+
+    rid_handler[type](rid_source(e->mac),
+                      (const ODID_Message_encoded *) e->data, e->rssi);
+
+    rid_rx_tail = (rid_rx_tail + 1) % RID_RX_QUEUE_SIZE;
+  }
 }
 #endif /* ENABLE_REMOTE_ID */
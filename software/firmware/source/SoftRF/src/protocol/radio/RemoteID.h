@@ -24,6 +24,12 @@
 #define RID_TX_INTERVAL_MIN  490  /* in ms */
 #define RID_TX_INTERVAL_MAX  510
 
+#define RID_ODID_APP_CODE    0x0D /* ASTM F3411 BLE AD application code */
+#define RID_RX_QUEUE_SIZE    8    /* messages, between radio stack and loop() */
+#define RID_RX_SOURCES       8    /* UAs tracked at once */
+#define RID_RX_INTERVAL_MIN  1000 /* ms, per UA into the traffic table */
+#define RID_RX_OPERATOR_MASK 0x800000 /* address of an operator, next to its UA */
+
 typedef struct {
 
   /* Dummy type definition. */
@@ -34,6 +40,8 @@ bool   rid_init();
 bool   rid_enabled();
 size_t rid_encode(void *, ufo_t *);
 bool   rid_decode(void *, ufo_t *, ufo_t *);
+bool   rid_receive(const uint8_t *, const uint8_t *, size_t, int8_t);
+void   rid_loop();
 
 #if defined(ENABLE_REMOTE_ID)
 #include <id_open.h>
@@ -0,0 +1,209 @@
+/*
+ * Profiler.cpp
+ * Copyright (C) 2024 Linar Yusupov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SoC.h"
+#include "Profiler.h"
+
+const char *Probe_Name[] = {
+  [PROBE_RF_TRANSMIT]     = "RF_Transmit",
+  [PROBE_RF_RECEIVE]      = "RF_Receive",
+  [PROBE_PARSE_DATA]      = "ParseData",
+  [PROBE_PROTOCOL_DECODE] = "protocol_decode",
+  [PROBE_TRAFFIC_LOOP]    = "Traffic_loop",
+  [PROBE_NMEA_EXPORT]     = "NMEA_Export",
+  [PROBE_GDL90_EXPORT]    = "GDL90_Export",
+  [PROBE_D1090_EXPORT]    = "D1090_Export",
+  [PROBE_JSON_EXPORT]     = "JSON_Export",
+  [PROBE_DISPLAY_LOOP]    = "Display_loop",
+};
+
+#if !defined(ENABLE_PROFILER)
+
+void   Profiler_setup()                                {}
+void   Profiler_record(uint8_t probe, uint32_t ticks)  {}
+void   Profiler_reset()                                {}
+bool   Profiler_stats(uint8_t probe, profiler_stats_t *stats) { return false; }
+size_t Profiler_JSON(char *buf, size_t size)           { return 0; }
+
+#else
+
+typedef struct probe_struct {
+  uint32_t count;
+  uint32_t min;
+  uint32_t max;
+  uint64_t sum;
+  uint16_t hist[PROFILER_HIST_BUCKETS];
+} probe_t;
+
+static probe_t  Probes[PROBE_COUNT];
+static uint32_t Profiler_ticks_per_us = 1;
+
+Profiler_Scope::~Profiler_Scope()
+{
+  Profiler_record(_probe, Profiler_ticks() - _start);
+}
+
+static uint8_t Profiler_bucket(uint32_t us)
+{
+  if (us < PROFILER_HIST_LINEAR) {
+    return (uint8_t) us;
+  }
+
+  uint8_t octave = 31 - __builtin_clz(us);
+
+  if (octave > PROFILER_HIST_MAX_OCTAVE) {
+    return PROFILER_HIST_BUCKETS - 1;
+  }
+
+  uint8_t sub = (us >> (octave - 2)) & (PROFILER_HIST_SUBBUCKETS - 1);
+
+  return PROFILER_HIST_LINEAR + (octave - 4) * PROFILER_HIST_SUBBUCKETS + sub;
+}
+
+/* upper bound (in us) of values that fall into the bucket */
+static uint32_t Profiler_bucket_limit(uint8_t bucket)
+{
+  if (bucket < PROFILER_HIST_LINEAR) {
+    return bucket;
+  }
+
+  uint8_t octave = 4 + (bucket - PROFILER_HIST_LINEAR) / PROFILER_HIST_SUBBUCKETS;
+  uint8_t sub    = (bucket - PROFILER_HIST_LINEAR) % PROFILER_HIST_SUBBUCKETS;
+  uint32_t step  = 1UL << (octave - 2);
+
+  return (1UL << octave) + (sub + 1) * step - 1;
+}
+
+void Profiler_setup()
+{
+#if defined(RASPBERRY_PI)
+  Profiler_ticks_per_us = 1000; /* clock_gettime() nanoseconds */
+#elif defined(ESP32)
+  Profiler_ticks_per_us = getCpuFrequencyMhz();
+#elif defined(ESP8266)
+  Profiler_ticks_per_us = ESP.getCpuFreqMHz();
+#elif defined(DWT) && (defined(__ARM_ARCH_7M__)  || \
+                       defined(__ARM_ARCH_7EM__) || \
+                       defined(__ARM_ARCH_8M_MAIN__))
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  DWT->CYCCNT       = 0;
+  DWT->CTRL        |= DWT_CTRL_CYCCNTENA_Msk;
+
+  Profiler_ticks_per_us = SystemCoreClock / 1000000;
+#endif
+
+  if (Profiler_ticks_per_us == 0) {
+    Profiler_ticks_per_us = 1;
+  }
+
+  Profiler_reset();
+}
+
+void Profiler_record(uint8_t probe, uint32_t ticks)
+{
+  if (probe >= PROBE_COUNT) {
+    return;
+  }
+
+  probe_t *p  = &Probes[probe];
+  uint32_t us = ticks / Profiler_ticks_per_us;
+
+  if (p->count == 0 || us < p->min) { p->min = us; }
+  if (us > p->max)                  { p->max = us; }
+  p->sum += us;
+  p->count++;
+
+  uint16_t *h = &p->hist[Profiler_bucket(us)];
+
+  /* keep shape of the distribution when a bucket is about to saturate */
+  if (*h == UINT16_MAX) {
+    for (int i=0; i < PROFILER_HIST_BUCKETS; i++) {
+      p->hist[i] >>= 1;
+    }
+  }
+  (*h)++;
+}
+
+void Profiler_reset()
+{
+  memset(Probes, 0, sizeof(Probes));
+}
+
+bool Profiler_stats(uint8_t probe, profiler_stats_t *stats)
+{
+  if (probe >= PROBE_COUNT || Probes[probe].count == 0) {
+    return false;
+  }
+
+  probe_t *p = &Probes[probe];
+
+  stats->count = p->count;
+  stats->min   = p->min;
+  stats->max   = p->max;
+  stats->avg   = (uint32_t) (p->sum / p->count);
+
+  uint32_t total = 0;
+  for (int i=0; i < PROFILER_HIST_BUCKETS; i++) {
+    total += p->hist[i];
+  }
+
+  uint32_t threshold = total - total / 100;
+  uint32_t acc = 0;
+  int i;
+
+  for (i=0; i < PROFILER_HIST_BUCKETS - 1; i++) {
+    acc += p->hist[i];
+    if (acc >= threshold) {
+      break;
+    }
+  }
+
+  uint32_t limit = Profiler_bucket_limit(i);
+  stats->p99 = limit < p->max ? limit : p->max;
+
+  return true;
+}
+
+size_t Profiler_JSON(char *buf, size_t size)
+{
+  profiler_stats_t stats;
+  size_t len;
+
+  len = snprintf_P(buf, size, PSTR("{\"probes\":["));
+
+  for (uint8_t i=0; i < PROBE_COUNT && len < size; i++) {
+    if (!Profiler_stats(i, &stats)) {
+      memset(&stats, 0, sizeof(stats));
+    }
+
+    len += snprintf_P(buf + len, size - len,
+             PSTR("%s{\"name\":\"%s\",\"count\":%lu,\"min\":%lu,\"avg\":%lu,\"max\":%lu,\"p99\":%lu}"),
+             i ? "," : "", Probe_Name[i],
+             (unsigned long) stats.count, (unsigned long) stats.min,
+             (unsigned long) stats.avg,   (unsigned long) stats.max,
+             (unsigned long) stats.p99);
+  }
+
+  if (len < size) {
+    len += snprintf_P(buf + len, size - len, PSTR("]}"));
+  }
+
+  return len < size ? len : size - 1;
+}
+
+#endif /* ENABLE_PROFILER */
@@ -0,0 +1,118 @@
+/*
+ * Profiler.h
+ * Copyright (C) 2024 Linar Yusupov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROFILERHELPER_H
+#define PROFILERHELPER_H
+
+#include "SoC.h"
+
+#if defined(RASPBERRY_PI)
+#include <time.h>
+#endif /* RASPBERRY_PI */
+
+enum
+{
+  PROBE_RF_TRANSMIT,
+  PROBE_RF_RECEIVE,
+  PROBE_PARSE_DATA,
+  PROBE_PROTOCOL_DECODE,
+  PROBE_TRAFFIC_LOOP,
+  PROBE_NMEA_EXPORT,
+  PROBE_GDL90_EXPORT,
+  PROBE_D1090_EXPORT,
+  PROBE_JSON_EXPORT,
+  PROBE_DISPLAY_LOOP,
+  PROBE_COUNT
+};
+
+/*
+ * Log-linear histogram of durations in microseconds:
+ * values below 16 us are counted one bucket per microsecond,
+ * every next octave is split into 4 buckets (12.5% resolution).
+ * Anything beyond 2^20 us (~1 second) lands into the last bucket.
+ */
+#define PROFILER_HIST_LINEAR      16
+#define PROFILER_HIST_SUBBUCKETS  4
+#define PROFILER_HIST_MAX_OCTAVE  20
+#define PROFILER_HIST_BUCKETS     (PROFILER_HIST_LINEAR + \
+                                   (PROFILER_HIST_MAX_OCTAVE - 4 + 1) * \
+                                   PROFILER_HIST_SUBBUCKETS)
+
+#define PROFILER_JSON_SIZE        (112 * PROBE_COUNT + 16)
+
+typedef struct profiler_stats_struct {
+  uint32_t count;
+  uint32_t min;     /* us */
+  uint32_t avg;     /* us */
+  uint32_t max;     /* us */
+  uint32_t p99;     /* us */
+} profiler_stats_t;
+
+#if defined(ENABLE_PROFILER)
+
+/*
+ * Free running counter of the best resolution available on the platform.
+ * Only differences of two readings are ever used, so wrap-around is harmless.
+ */
+static inline uint32_t Profiler_ticks()
+{
+#if defined(RASPBERRY_PI)
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint32_t) ts.tv_sec * 1000000000UL + (uint32_t) ts.tv_nsec;
+#elif defined(ESP32) || defined(ESP8266)
+  return ESP.getCycleCount();
+#elif defined(DWT) && (defined(__ARM_ARCH_7M__)  || \
+                       defined(__ARM_ARCH_7EM__) || \
+                       defined(__ARM_ARCH_8M_MAIN__))
+  return DWT->CYCCNT;
+#else
+  return micros();
+#endif
+}
+
+class Profiler_Scope {
+  public:
+    Profiler_Scope(uint8_t probe) : _probe(probe), _start(Profiler_ticks()) {}
+    ~Profiler_Scope();
+  private:
+    uint8_t  _probe;
+    uint32_t _start;
+};
+
+#define PROFILE_BEGIN(p)  uint32_t __profile_##p = Profiler_ticks()
+#define PROFILE_END(p)    Profiler_record(p, Profiler_ticks() - __profile_##p)
+#define PROFILE_SCOPE(p)  Profiler_Scope __profile_scope(p)
+
+#else
+
+#define PROFILE_BEGIN(p)
+#define PROFILE_END(p)
+#define PROFILE_SCOPE(p)
+
+#endif /* ENABLE_PROFILER */
+
+void   Profiler_setup(void);
+void   Profiler_record(uint8_t, uint32_t);
+void   Profiler_reset(void);
+bool   Profiler_stats(uint8_t, profiler_stats_t *);
+size_t Profiler_JSON(char *, size_t);
+
+extern const char *Probe_Name[];
+
+#endif /* PROFILERHELPER_H */
@@ -0,0 +1,220 @@
+/*
+ * RFTask.cpp
+ * Copyright (C) 2024 Linar Yusupov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "SoC.h"
+#include "RFTask.h"
+
+rf_task_stats_t RF_Task_Stats;
+
+#if !defined(ENABLE_RF_TASK)
+
+void RF_Task_setup()                         {}
+void RF_Task_fini()                          {}
+bool RF_Task_Active()                        { return false; }
+void RF_Task_Update(ufo_t *fop, bool valid)  {}
+bool RF_Task_Receive()                       { return false; }
+
+#else
+
+#include "../driver/RF.h"
+#include "../driver/EEPROM.h"
+#include "../TrafficHelper.h"
+
+/*
+ * Radio slot handling, Rx and Tx, and protocol decode live in a task
+ * pinned to PRO_CPU. Wi-Fi, web, UI and exports keep running in loop()
+ * on APP_CPU and can no longer make the radio miss its time slots.
+ *
+ * loop() publishes a copy of own position and of GNSS time, the task
+ * hands decoded reports and debug lines back through bounded queues.
+ * Traffic table, gnss, TimeLib and the console are only ever touched
+ * by loop().
+ */
+
+static TaskHandle_t      RF_Task_Handle = NULL;
+static QueueHandle_t     RF_Task_Queue  = NULL;
+static QueueHandle_t     RF_Task_Log    = NULL;
+static SemaphoreHandle_t RF_Task_Done   = NULL;
+static portMUX_TYPE      RF_Task_mutex  = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool     RF_Task_Stop   = false;
+
+/* published by loop() */
+static ufo_t     RF_Task_Own;
+static bool      RF_Task_Own_valid = false;
+static rf_time_t RF_Task_Time;
+static bool      RF_Task_Time_valid = false;
+
+RF_Task_Print RF_Task_Out;
+
+size_t RF_Task_Print::write(uint8_t c)
+{
+  if (RF_Task_Handle == NULL ||
+      xTaskGetCurrentTaskHandle() != RF_Task_Handle) {
+    return StdOut.write(c);
+  }
+
+  if (c == '\n') {
+    _line[_len] = 0;
+    /* a slow console must not stall the radio - drop the line */
+    xQueueSend(RF_Task_Log, _line, 0);
+    _len = 0;
+  } else if (c != '\r' && _len < sizeof(_line) - 1) {
+    _line[_len++] = c;
+  }
+
+  return 1;
+}
+
+static void RF_Task(void *parameter)
+{
+  ufo_t own, report;
+  rf_time_t time;
+  bool valid, synced;
+
+  while (!RF_Task_Stop) {
+    portENTER_CRITICAL(&RF_Task_mutex);
+    own    = RF_Task_Own;
+    valid  = RF_Task_Own_valid;
+    time   = RF_Task_Time;
+    synced = RF_Task_Time_valid;
+    portEXIT_CRITICAL(&RF_Task_mutex);
+
+    if (!synced) {
+      vTaskDelay(1);
+      continue;
+    }
+
+    RF_SetChannel_Time(&time);
+    RF_Forward();
+
+    if (valid) {
+      RF_Transmit(RF_Encode(&own), true);
+    }
+
+    if (RF_Receive() && valid) {
+      report = EmptyFO;
+
+      if (Traffic_Decode(&own, &report) &&
+          xQueueSend(RF_Task_Queue, &report, 0) != pdTRUE) {
+        RF_Task_Stats.dropped++;
+      }
+    }
+
+    vTaskDelay(1);
+  }
+
+  /* radio is idle here, between two transactions */
+  xSemaphoreGive(RF_Task_Done);
+  vTaskDelete(NULL);
+}
+
+void RF_Task_setup()
+{
+  memset(&RF_Task_Stats, 0, sizeof(RF_Task_Stats));
+
+  if (settings->mode != SOFTRF_MODE_NORMAL || RF_Task_Handle != NULL) {
+    return;
+  }
+
+  RF_Task_Queue = xQueueCreate(RF_TASK_QUEUE_DEPTH, sizeof(ufo_t));
+  RF_Task_Log   = xQueueCreate(RF_TASK_LOG_DEPTH, RF_TASK_LINE_SIZE);
+  RF_Task_Done  = xSemaphoreCreateBinary();
+
+  RF_Task_Stop       = false;
+  RF_Task_Own_valid  = false;
+  RF_Task_Time_valid = false;
+
+  if (RF_Task_Queue == NULL || RF_Task_Log == NULL || RF_Task_Done == NULL ||
+      xTaskCreatePinnedToCore(RF_Task, "RF", RF_TASK_STACK_SZ, NULL,
+                              RF_TASK_PRIO, &RF_Task_Handle,
+                              RF_TASK_CORE) != pdPASS) {
+    RF_Task_Handle = NULL;
+    RF_Task_fini();
+  }
+}
+
+void RF_Task_fini()
+{
+  if (RF_Task_Handle != NULL) {
+    RF_Task_Stop = true;
+
+    /* let it finish the slot in progress */
+    if (xSemaphoreTake(RF_Task_Done,
+                       pdMS_TO_TICKS(RF_TASK_JOIN_MS)) != pdTRUE) {
+      /* stuck in a driver - nothing left to wait for */
+      vTaskDelete(RF_Task_Handle);
+    }
+    RF_Task_Handle = NULL;
+  }
+  if (RF_Task_Queue != NULL) {
+    vQueueDelete(RF_Task_Queue);
+    RF_Task_Queue = NULL;
+  }
+  if (RF_Task_Log != NULL) {
+    vQueueDelete(RF_Task_Log);
+    RF_Task_Log = NULL;
+  }
+  if (RF_Task_Done != NULL) {
+    vSemaphoreDelete(RF_Task_Done);
+    RF_Task_Done = NULL;
+  }
+}
+
+bool RF_Task_Active()
+{
+  return RF_Task_Handle != NULL;
+}
+
+/*
+ * Own position and a GNSS time sample go over to the task together.
+ * The task never reads gnss or TimeLib on its own.
+ */
+void RF_Task_Update(ufo_t *this_aircraft, bool valid)
+{
+  rf_time_t time;
+
+  RF_Time_Sample(&time);
+
+  portENTER_CRITICAL(&RF_Task_mutex);
+  RF_Task_Own        = *this_aircraft;
+  RF_Task_Own_valid  = valid;
+  RF_Task_Time       = time;
+  RF_Task_Time_valid = true;
+  portEXIT_CRITICAL(&RF_Task_mutex);
+}
+
+bool RF_Task_Receive()
+{
+  ufo_t report;
+  char line[RF_TASK_LINE_SIZE];
+  bool success = false;
+
+  while (xQueueReceive(RF_Task_Log, line, 0) == pdTRUE) {
+    StdOut.println(line);
+  }
+
+  while (xQueueReceive(RF_Task_Queue, &report, 0) == pdTRUE) {
+    Traffic_Update(&report);
+    Traffic_Add(&report);
+    success = true;
+  }
+
+  return success;
+}
+
+#endif /* ENABLE_RF_TASK */
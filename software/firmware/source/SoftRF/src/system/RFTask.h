@@ -0,0 +1,64 @@
+/*
+ * RFTask.h
+ * Copyright (C) 2024 Linar Yusupov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RFTASKHELPER_H
+#define RFTASKHELPER_H
+
+#include "SoC.h"
+
+#define RF_TASK_STACK_SZ      4096
+#define RF_TASK_PRIO          2     /* above Arduino loop() */
+#define RF_TASK_CORE          0     /* PRO_CPU, loop() runs on APP_CPU */
+#define RF_TASK_QUEUE_DEPTH   8     /* decoded reports in flight */
+#define RF_TASK_LOG_DEPTH     4     /* $PSRFx lines in flight */
+#define RF_TASK_LINE_SIZE     128
+#define RF_TASK_JOIN_MS       500
+
+typedef struct rf_task_stats_struct {
+  uint32_t dropped;   /* reports lost, queue was full */
+} rf_task_stats_t;
+
+#if defined(ENABLE_RF_TASK)
+/*
+ * $PSRFx debug sentences of the radio path. Printed by the RF task,
+ * they are handed over to loop() line by line, so that they do not
+ * interleave with NMEA output. Anywhere else it is a pass-through.
+ */
+class RF_Task_Print : public Print {
+  public:
+    size_t write(uint8_t);
+  private:
+    char   _line[RF_TASK_LINE_SIZE];
+    size_t _len = 0;
+};
+
+extern RF_Task_Print RF_Task_Out;
+#define RFOut   RF_Task_Out
+#else
+#define RFOut   StdOut
+#endif /* ENABLE_RF_TASK */
+
+void RF_Task_setup(void);
+void RF_Task_fini(void);
+bool RF_Task_Active(void);
+void RF_Task_Update(ufo_t *, bool);
+bool RF_Task_Receive(void);
+
+extern rf_task_stats_t RF_Task_Stats;
+
+#endif /* RFTASKHELPER_H */
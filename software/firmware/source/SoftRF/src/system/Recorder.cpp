@@ -18,16 +18,21 @@
 
 #include "SoC.h"
 
+#include "Recorder.h"
+
 #if !defined(ENABLE_RECORDER)
 void Recorder_setup()   {}
 void Recorder_loop()    {}
 void Recorder_fini()    {}
+
+uint32_t Recorder_Index_count()                                   { return 0; }
+size_t   Recorder_Index_page(uint32_t first, recorder_index_t *buf,
+                             size_t max)                          { return 0; }
 #else
 
 #include <SdFat.h>
 #include <FlightRecorder.h>
 
-#include "Recorder.h"
 #include "../driver/GNSS.h"
 #include "../driver/Baro.h"
 
@@ -40,6 +45,277 @@ bool FR_is_active = false;
 static const char *m10s_specs = "u-blox,MAX-M10S,49,50000,GPS,GLO,BDS,GAL";
 static const char *l76k_specs = "Quectel,L76K,32,50000,GPS,GLO,BDS";
 
+typedef struct __attribute__((packed)) recorder_index_header_struct {
+  uint32_t magic;
+  uint32_t reserved;
+} recorder_index_header_t;
+
+#define RECORDER_INDEX_OFFSET(n)  (sizeof(recorder_index_header_t) + \
+                                   (n) * sizeof(recorder_index_t))
+
+static bool     Recorder_Index_valid   = false;
+static uint32_t Recorder_Index_entries = 0;
+static int32_t  Recorder_Index_active  = -1; /* record of the log being written */
+static char     Recorder_Index_path[48];
+static unsigned long Recorder_Index_marker = 0;
+
+static void Recorder_Index_stat(File32 &file, recorder_index_t *rec)
+{
+  rec->size = file.size();
+  if (!file.getModifyDateTime(&rec->date, &rec->time)) {
+    rec->date = rec->time = 0;
+  }
+}
+
+static bool Recorder_Index_write(uint32_t n, recorder_index_t *rec)
+{
+  File32 index = uSD.open(RECORDER_INDEX_FILE, O_RDWR | O_CREAT);
+
+  if (!index) {
+    return false;
+  }
+
+  bool rval = index.seekSet(RECORDER_INDEX_OFFSET(n)) &&
+              index.write(rec, sizeof(recorder_index_t)) == sizeof(recorder_index_t);
+  index.close();
+
+  return rval;
+}
+
+/* header is sane and the newest indexed log is still on the card */
+static bool Recorder_Index_check()
+{
+  recorder_index_header_t hdr;
+  recorder_index_t rec;
+
+  File32 index = uSD.open(RECORDER_INDEX_FILE, O_RDONLY);
+
+  if (!index) {
+    return false;
+  }
+
+  uint32_t size = index.size();
+  bool rval = size >= sizeof(hdr) &&
+              (size - sizeof(hdr)) % sizeof(rec) == 0 &&
+              index.read(&hdr, sizeof(hdr)) == sizeof(hdr) &&
+              hdr.magic == RECORDER_INDEX_MAGIC;
+
+  if (rval) {
+    Recorder_Index_entries = (size - sizeof(hdr)) / sizeof(rec);
+
+    if (Recorder_Index_entries > 0) {
+      rval = index.seekSet(RECORDER_INDEX_OFFSET(Recorder_Index_entries - 1)) &&
+             index.read(&rec, sizeof(rec)) == sizeof(rec);
+      if (rval) {
+        char path[sizeof(RECORDER_FLIGHTS_DIR) + sizeof(rec.name)];
+
+        rec.name[sizeof(rec.name) - 1] = 0;
+        snprintf(path, sizeof(path), RECORDER_FLIGHTS_DIR "/%s", rec.name);
+        rval = uSD.exists(path);
+      }
+    }
+  }
+  index.close();
+
+  return rval;
+}
+
+/* oldest first: by FAT date and time, then by IGC file name */
+static int Recorder_Index_cmp(const void *a, const void *b)
+{
+  const recorder_index_t *ra = (const recorder_index_t *) a;
+  const recorder_index_t *rb = (const recorder_index_t *) b;
+
+  if (ra->date != rb->date) { return ra->date < rb->date ? -1 : 1; }
+  if (ra->time != rb->time) { return ra->time < rb->time ? -1 : 1; }
+
+  return strncmp(ra->name, rb->name, sizeof(ra->name));
+}
+
+/*
+ * One full directory walk - only when the index is missing or stale.
+ * Directory order is not chronological, so records are sorted before
+ * they go out. Should the heap be short, the walk order is kept.
+ */
+static bool Recorder_Index_rebuild()
+{
+  recorder_index_header_t hdr = { RECORDER_INDEX_MAGIC, 0 };
+  recorder_index_t rec;
+  recorder_index_t *list = NULL;
+  uint32_t count = 0;
+  uint32_t room  = 0;
+  bool sorted    = true;
+
+  File32 index = uSD.open(RECORDER_INDEX_FILE, O_RDWR | O_CREAT | O_TRUNC);
+
+  if (!index) {
+    return false;
+  }
+
+  index.write(&hdr, sizeof(hdr));
+
+  File32 root = uSD.open(RECORDER_FLIGHTS_DIR);
+  if (root) {
+    root.rewindDirectory();
+    File32 file = root.openNextFile();
+    while (file) {
+      memset(&rec, 0, sizeof(rec));
+      if (!file.isDirectory() && file.getName(rec.name, sizeof(rec.name)) > 4) {
+        size_t len = strlen(rec.name);
+
+        if (strcasecmp(rec.name + len - 4, ".IGC") == 0) {
+          Recorder_Index_stat(file, &rec);
+
+          if (sorted && count == room) {
+            recorder_index_t *more = (recorder_index_t *)
+              realloc(list, (room + RECORDER_INDEX_PAGE) * sizeof(rec));
+            if (more) {
+              list  = more;
+              room += RECORDER_INDEX_PAGE;
+            } else {
+              /* flush what is there and go on unsorted */
+              sorted = false;
+              qsort(list, count, sizeof(rec), Recorder_Index_cmp);
+              for (uint32_t i=0; i < count; i++) {
+                index.write(&list[i], sizeof(rec));
+              }
+            }
+          }
+
+          if (sorted) {
+            list[count++] = rec;
+          } else if (index.write(&rec, sizeof(rec)) == sizeof(rec)) {
+            count++;
+          }
+        }
+      }
+      file.close();
+      file = root.openNextFile();
+    }
+    root.close();
+  }
+
+  if (sorted && count > 0) {
+    qsort(list, count, sizeof(rec), Recorder_Index_cmp);
+    if (index.write(list, count * sizeof(rec)) != count * sizeof(rec)) {
+      count = 0;
+    }
+  }
+  free(list);
+
+  index.close();
+
+  Recorder_Index_entries = count;
+
+  return true;
+}
+
+static void Recorder_Index_open(const char *path)
+{
+  recorder_index_t rec;
+  const char *name = strrchr(path, '/');
+
+  memset(&rec, 0, sizeof(rec));
+  strncpy(rec.name, name ? name + 1 : path, sizeof(rec.name) - 1);
+
+  File32 file = uSD.open(path, O_RDONLY);
+  if (file) {
+    Recorder_Index_stat(file, &rec);
+    file.close();
+  }
+
+  if (Recorder_Index_write(Recorder_Index_entries, &rec)) {
+    strncpy(Recorder_Index_path, path, sizeof(Recorder_Index_path) - 1);
+    Recorder_Index_active = Recorder_Index_entries++;
+  } else {
+    Recorder_Index_valid = false;
+  }
+}
+
+/* keep size and date of the log being written up to date on the card */
+static void Recorder_Index_refresh()
+{
+  if (Recorder_Index_active < 0) {
+    return;
+  }
+
+  recorder_index_t rec;
+
+  memset(&rec, 0, sizeof(rec));
+  strncpy(rec.name, strrchr(Recorder_Index_path, '/') + 1, sizeof(rec.name) - 1);
+
+  File32 file = uSD.open(Recorder_Index_path, O_RDONLY);
+  if (file) {
+    Recorder_Index_stat(file, &rec);
+    file.close();
+    Recorder_Index_write(Recorder_Index_active, &rec);
+  }
+
+  Recorder_Index_marker = millis();
+}
+
+static void Recorder_Index_close()
+{
+  Recorder_Index_refresh();
+  Recorder_Index_active = -1;
+}
+
+uint32_t Recorder_Index_count()
+{
+  return Recorder_Index_valid ? Recorder_Index_entries : 0;
+}
+
+/*
+ * Fetch up to 'max' records, newest first, skipping 'first' newest ones.
+ * Costs one seek and one read regardless of how many flights are recorded.
+ */
+size_t Recorder_Index_page(uint32_t first, recorder_index_t *buf, size_t max)
+{
+  if (!Recorder_Index_valid || first >= Recorder_Index_entries || max == 0) {
+    return 0;
+  }
+
+  uint32_t last  = Recorder_Index_entries - first;
+  size_t   n     = last < max ? last : max;
+  uint32_t start = last - n;
+
+  File32 index = uSD.open(RECORDER_INDEX_FILE, O_RDONLY);
+
+  if (!index) {
+    return 0;
+  }
+
+  bool rval = index.seekSet(RECORDER_INDEX_OFFSET(start)) &&
+              index.read(buf, n * sizeof(recorder_index_t)) ==
+                (int) (n * sizeof(recorder_index_t));
+  index.close();
+
+  if (!rval) {
+    return 0;
+  }
+
+  for (size_t i=0; i < n / 2; i++) {
+    recorder_index_t tmp = buf[i];
+    buf[i]         = buf[n - 1 - i];
+    buf[n - 1 - i] = tmp;
+  }
+
+  for (size_t i=0; i < n; i++) {
+    buf[i].name[sizeof(buf[i].name) - 1] = 0;
+
+    /* the log being written grows after its record was made */
+    if ((int32_t) (start + n - 1 - i) == Recorder_Index_active) {
+      File32 file = uSD.open(Recorder_Index_path, O_RDONLY);
+      if (file) {
+        Recorder_Index_stat(file, &buf[i]);
+        file.close();
+      }
+    }
+  }
+
+  return n;
+}
+
 void Recorder_setup()
 {
   const char *gnss_specs = hw_info.gnss == GNSS_MODULE_U10  ? m10s_specs :
@@ -54,6 +330,10 @@ void Recorder_setup()
     if (!FR_is_active && uSD.volumeBegin()) {
       FR_is_active = FR.begin(&uSD, SoC->getChipId(), gnss_specs);
     }
+
+    if (FR_is_active) {
+      Recorder_Index_valid = Recorder_Index_check() || Recorder_Index_rebuild();
+    }
   }
 }
 
@@ -61,6 +341,27 @@ void Recorder_loop()
 {
   if (FR_is_active) {
     FR.loop(&gnss, ThisAircraft.pressure_altitude);
+
+    if (Recorder_Index_valid) {
+      const char *path = FR.file();
+
+      /* the log was closed, or a new flight has started a new one */
+      if (Recorder_Index_active >= 0 &&
+          (path == NULL ||
+           strncmp(path, Recorder_Index_path,
+                   sizeof(Recorder_Index_path) - 1) != 0)) {
+        Recorder_Index_close();
+      }
+
+      if (Recorder_Index_active < 0) {
+        if (path) {
+          Recorder_Index_open(path);
+          Recorder_Index_marker = millis();
+        }
+      } else if (millis() - Recorder_Index_marker > RECORDER_INDEX_REFRESH_MS) {
+        Recorder_Index_refresh();
+      }
+    }
   }
 }
 
@@ -68,6 +369,7 @@ void Recorder_fini()
 {
   if (FR_is_active) {
     FR.end();
+    Recorder_Index_close();
     FR_is_active = false;
   }
 }
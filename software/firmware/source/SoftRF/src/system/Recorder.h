@@ -19,10 +19,35 @@
 #ifndef RECORDERHELPER_H
 #define RECORDERHELPER_H
 
+#include <stdint.h>
+#include <stddef.h>
+
+#define RECORDER_FLIGHTS_DIR    "/Flights"
+#define RECORDER_INDEX_FILE     RECORDER_FLIGHTS_DIR "/INDEX.DAT"
+#define RECORDER_INDEX_MAGIC    0x31585249UL /* "IRX1" */
+#define RECORDER_INDEX_PAGE     25           /* entries per web page */
+#define RECORDER_INDEX_REFRESH_MS 60000      /* record of the active log */
+
+/*
+ * On-card index of recorded flights: a short header followed by
+ * fixed size records, oldest first. The recorder appends a record
+ * when a log gets its header and refreshes it every minute and when
+ * the log is closed, so that listing never has to walk the directory.
+ */
+typedef struct __attribute__((packed)) recorder_index_struct {
+  char     name[40];
+  uint32_t size;  /* bytes */
+  uint16_t date;  /* FAT format */
+  uint16_t time;  /* FAT format */
+} recorder_index_t;
+
 void Recorder_setup(void);
 void Recorder_loop(void);
 void Recorder_fini(void);
 
+uint32_t Recorder_Index_count(void);
+size_t   Recorder_Index_page(uint32_t, recorder_index_t *, size_t);
+
 extern bool FR_is_active;
 
 #endif /* RECORDERHELPER_H */
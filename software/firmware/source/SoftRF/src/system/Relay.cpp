@@ -0,0 +1,243 @@
+/*
+ * Relay.cpp
+ * Copyright (C) 2024 Linar Yusupov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <TimeLib.h>
+
+#include "SoC.h"
+#include "Relay.h"
+#include "../driver/RF.h"
+#include "../driver/EEPROM.h"
+#include "../driver/GNSS.h"
+#include "../TrafficHelper.h"
+
+typedef struct relay_dedup_struct {
+  uint32_t key;
+  uint32_t marker; /* ms */
+} relay_dedup_t;
+
+static relay_dedup_t Relay_Dedup[RELAY_DEDUP_SIZE];
+
+/* airtime allowance, in microseconds to keep sub-ms refill accuracy */
+static uint32_t Relay_Airtime_Budget = 0;
+static uint32_t Relay_Airtime_Cap    = 0;
+static uint16_t Relay_Duty_Permille  = 10;
+static unsigned long Relay_Airtime_Marker = 0;
+
+relay_stats_t Relay_Stats;
+
+static uint32_t Relay_Hash(const void *data, size_t size, uint32_t h = 2166136261UL)
+{
+  const byte *p = (const byte *) data;
+
+  while (size--) {
+    h ^= *p++;
+    h *= 16777619UL;
+  }
+
+  return h ? h : 1; /* zero marks a free slot */
+}
+
+/* identity of a decoded report: same source, same fix */
+static uint32_t Relay_Key(ufo_t *fop)
+{
+  uint32_t h = Relay_Hash(&fop->addr,      sizeof(fop->addr));
+  h = Relay_Hash(&fop->timestamp, sizeof(fop->timestamp), h);
+  h = Relay_Hash(&fop->latitude,  sizeof(fop->latitude),  h);
+  h = Relay_Hash(&fop->longitude, sizeof(fop->longitude), h);
+  h = Relay_Hash(&fop->altitude,  sizeof(fop->altitude),  h);
+
+  return h;
+}
+
+static bool Relay_Seen(uint32_t key)
+{
+  uint32_t ms = millis();
+
+  for (int i=0; i < RELAY_DEDUP_PROBES; i++) {
+    relay_dedup_t *e = &Relay_Dedup[(key + i) & (RELAY_DEDUP_SIZE - 1)];
+
+    if (e->key == key && (ms - e->marker) < RELAY_DEDUP_TTL * 1000UL) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+static void Relay_Remember(uint32_t key)
+{
+  uint32_t ms = millis();
+  relay_dedup_t *victim = NULL;
+
+  for (int i=0; i < RELAY_DEDUP_PROBES; i++) {
+    relay_dedup_t *e = &Relay_Dedup[(key + i) & (RELAY_DEDUP_SIZE - 1)];
+
+    if (e->key == key || e->key == 0 ||
+        (ms - e->marker) >= RELAY_DEDUP_TTL * 1000UL) {
+      victim = e;
+      break;
+    }
+    if (victim == NULL || (ms - e->marker) > (ms - victim->marker)) {
+      victim = e;
+    }
+  }
+
+  victim->key    = key;
+  victim->marker = ms;
+}
+
+static void Relay_Airtime_Refill()
+{
+  unsigned long ms      = millis();
+  unsigned long elapsed = ms - Relay_Airtime_Marker;
+
+  /* a full window refills the bucket, more would overflow the product */
+  if (elapsed > RELAY_AIRTIME_WINDOW_MS) {
+    elapsed = RELAY_AIRTIME_WINDOW_MS;
+  }
+
+  uint32_t gain = elapsed * Relay_Duty_Permille;
+
+  Relay_Airtime_Marker = ms;
+  Relay_Airtime_Budget = (Relay_Airtime_Cap - Relay_Airtime_Budget) > gain ?
+                          Relay_Airtime_Budget + gain : Relay_Airtime_Cap;
+}
+
+void Relay_setup()
+{
+  memset(Relay_Dedup, 0, sizeof(Relay_Dedup));
+  memset(&Relay_Stats, 0, sizeof(Relay_Stats));
+
+  switch (settings->band)
+  {
+  case RF_BAND_AUTO:
+  case RF_BAND_EU:
+  case RF_BAND_UK:
+  case RF_BAND_RU:
+  case RF_BAND_IN:
+    /* ETSI EN 300 220: 1% in g1, 10% in g3 (869.4 - 869.65 MHz) */
+    Relay_Duty_Permille = settings->rf_protocol == RF_PROTOCOL_P3I ? 100 : 10;
+    break;
+  default:
+    /* no hard limit - stay a good neighbour anyway */
+    Relay_Duty_Permille = 100;
+    break;
+  }
+
+  Relay_Airtime_Cap    = RELAY_AIRTIME_WINDOW_MS * Relay_Duty_Permille;
+  Relay_Airtime_Budget = Relay_Airtime_Cap;
+  Relay_Airtime_Marker = millis();
+}
+
+/* frames received over the air are not worth to repeat */
+void Relay_Heard(byte *buf, size_t size)
+{
+  if (size > 0) {
+    Relay_Remember(Relay_Hash(buf, size));
+  }
+}
+
+void Relay_loop()
+{
+  traffic_by_dist_t queue[MAX_TRACKING_OBJECTS];
+  uint32_t keys[MAX_TRACKING_OBJECTS];
+  int count = 0;
+  time_t this_moment = now();
+
+  size_t size = RF_Payload_Size(settings->rf_protocol);
+  size = size > sizeof(EmptyFO.raw) ? sizeof(EmptyFO.raw) : size;
+  size = size > sizeof(TxBuffer)    ? sizeof(TxBuffer)    : size;
+
+  for (int i=0; i < MAX_TRACKING_OBJECTS; i++) {
+    ufo_t *fop = &Container[i];
+    bool raw   = (memcmp(fop->raw, EmptyFO.raw, size) != 0);
+    uint32_t key;
+    float score;
+
+    if (raw) {
+      key   = Relay_Hash(fop->raw, size);
+      score = 0;
+    } else if (isValidFix() &&
+               fop->addr &&
+               fop->latitude  != 0.0 &&
+               fop->longitude != 0.0 &&
+               fop->altitude  != 0.0 &&
+               fop->distance < RELAY_MAX_RANGE) {
+      key   = Relay_Key(fop);
+      score = fop->distance;
+    } else {
+      continue;
+    }
+
+    time_t age = this_moment - fop->timestamp;
+
+    if (age > RELAY_MAX_AGE) {
+      Relay_Stats.expired++;
+      *fop = EmptyFO;
+      continue;
+    }
+
+    if (Relay_Seen(key)) {
+      Relay_Stats.duplicates++;
+      *fop = EmptyFO;
+      continue;
+    }
+
+    /* close and fresh targets go first */
+    queue[count].fop      = fop;
+    queue[count].distance = score + (age > 0 ? age : 0) * RELAY_AGE_PENALTY;
+    keys[fop - Container] = key;
+    count++;
+  }
+
+  if (count == 0 || millis() <= TxTimeMarker) {
+    return;
+  }
+
+  Relay_Airtime_Refill();
+
+  uint32_t cost = (uint32_t) RF_Air_Time() * 1000;
+
+  if (Relay_Airtime_Budget < cost) {
+    Relay_Stats.deferred++;
+    return;
+  }
+
+  qsort(queue, count, sizeof(traffic_by_dist_t), traffic_cmp_by_distance);
+
+  ufo_t *fop = queue[0].fop;
+  size_t tx_size;
+
+  if (memcmp(fop->raw, EmptyFO.raw, size) != 0) {
+    memcpy(TxBuffer, fop->raw, size);
+    tx_size = size;
+  } else {
+    fo = *fop;
+    fo.timestamp = this_moment; /* GNSS date&time */
+    tx_size = RF_Encode(&fo);
+  }
+
+  /* one frame per time slot. Follow duty cycle rule */
+  if (tx_size > 0 && RF_Transmit(tx_size, true)) {
+    Relay_Remember(keys[fop - Container]);
+    Relay_Remember(Relay_Hash(TxBuffer, tx_size));
+    Relay_Airtime_Budget -= cost;
+    Relay_Stats.relayed++;
+    *fop = EmptyFO;
+  }
+}
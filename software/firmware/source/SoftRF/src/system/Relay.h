@@ -0,0 +1,48 @@
+/*
+ * Relay.h
+ * Copyright (C) 2024 Linar Yusupov
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef RELAYHELPER_H
+#define RELAYHELPER_H
+
+#include "SoC.h"
+
+#define RELAY_DEDUP_SIZE        64    /* entries, power of 2 */
+#define RELAY_DEDUP_PROBES      4
+#define RELAY_DEDUP_TTL         30    /* seconds */
+
+#define RELAY_MAX_AGE           EXPORT_EXPIRATION_TIME /* seconds */
+#define RELAY_MAX_RANGE         (ALARM_ZONE_NONE * 2)  /* metres */
+#define RELAY_AGE_PENALTY       1000  /* metres of distance per second of age */
+
+/* airtime bucket holds this much of duty cycle allowance */
+#define RELAY_AIRTIME_WINDOW_MS 60000
+
+typedef struct relay_stats_struct {
+  uint32_t relayed;
+  uint32_t duplicates;
+  uint32_t expired;
+  uint32_t deferred;  /* out of airtime */
+} relay_stats_t;
+
+void Relay_setup(void);
+void Relay_loop(void);
+void Relay_Heard(byte *, size_t);
+
+extern relay_stats_t Relay_Stats;
+
+#endif /* RELAYHELPER_H */
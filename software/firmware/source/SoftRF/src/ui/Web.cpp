@@ -25,6 +25,7 @@ void Web_fini()     {}
 #else
 
 #include <Arduino.h>
+#include <stdarg.h>
 
 #include "../driver/Battery.h"
 #include "../driver/RF.h"
@@ -38,6 +39,8 @@ void Web_fini()     {}
 #include "../protocol/data/GDL90.h"
 #include "../protocol/data/D1090.h"
 #include "../system/Time.h"
+#include "../system/Profiler.h"
+#include "../system/RFTask.h"
 
 #if defined(ENABLE_AHRS)
 #include "../driver/AHRS.h"
@@ -65,6 +68,128 @@ WebServer server ( 80 );
 WiFiWebServer server ( 80 );
 #endif
 
+/*
+ * Pages are streamed with chunked transfer encoding through a small
+ * static staging buffer, so that heap usage does not depend on page size.
+ */
+static char   Web_chunk[WEB_CHUNK_SIZE];
+static size_t Web_chunk_len = 0;
+
+static void Web_flush()
+{
+  if (Web_chunk_len > 0) {
+    server.sendContent(Web_chunk, Web_chunk_len);
+    Web_chunk_len = 0;
+  }
+}
+
+static void Web_putc(char c)
+{
+  if (Web_chunk_len >= sizeof(Web_chunk)) {
+    Web_flush();
+  }
+  Web_chunk[Web_chunk_len++] = c;
+}
+
+static void Web_puts(const char *s)
+{
+  while (*s) {
+    Web_putc(*s++);
+  }
+}
+
+/*
+ * Subset of printf which streams straight into the staging buffer:
+ * %d %i %u %x %X %c with flags, width and 'l' modifier, %s and %%.
+ * Format string is in PROGMEM, string arguments are in RAM.
+ */
+static void Web_printf_P(PGM_P fmt, ...)
+{
+  char spec[12];
+  char field[24];
+  char c;
+  va_list ap;
+
+  va_start(ap, fmt);
+
+  while ((c = pgm_read_byte(fmt++)) != 0) {
+    if (c != '%') {
+      Web_putc(c);
+      continue;
+    }
+
+    size_t n = 0;
+    spec[n++] = c;
+    do {
+      c = pgm_read_byte(fmt++);
+      spec[n++] = c;
+    } while (c && strchr("-+ #0123456789.l", c) && n < sizeof(spec) - 1);
+    spec[n] = 0;
+
+    if (c == 0) {
+      break;
+    }
+
+    bool is_long = (strchr(spec, 'l') != NULL);
+
+    switch (c)
+    {
+    case '%':
+      Web_putc(c);
+      break;
+    case 's':
+      {
+        const char *str = va_arg(ap, const char *);
+        Web_puts(str ? str : "");
+      }
+      break;
+    case 'c':
+    case 'd':
+    case 'i':
+      if (is_long) {
+        snprintf(field, sizeof(field), spec, va_arg(ap, long));
+      } else {
+        snprintf(field, sizeof(field), spec, va_arg(ap, int));
+      }
+      Web_puts(field);
+      break;
+    case 'u':
+    case 'x':
+    case 'X':
+      if (is_long) {
+        snprintf(field, sizeof(field), spec, va_arg(ap, unsigned long));
+      } else {
+        snprintf(field, sizeof(field), spec, va_arg(ap, unsigned int));
+      }
+      Web_puts(field);
+      break;
+    default:
+      Web_puts(spec);
+      break;
+    }
+  }
+
+  va_end(ap);
+}
+
+static void Web_begin(int code, const char *content_type)
+{
+  server.sendHeader(String(F("Cache-Control")), String(F("no-cache, no-store, must-revalidate")));
+  server.sendHeader(String(F("Pragma")), String(F("no-cache")));
+  server.sendHeader(String(F("Expires")), String(F("-1")));
+  server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+  server.send(code, content_type, "");
+
+  Web_chunk_len = 0;
+}
+
+static void Web_end()
+{
+  Web_flush();
+  /* zero size chunk terminates the response */
+  server.sendContent(Web_chunk, 0);
+}
+
 byte getVal(char c)
 {
    if(c >= '0' && c <= '9')
@@ -150,19 +275,11 @@ Copyright (C) 2015-2024 &nbsp;&nbsp;&nbsp; Linar Yusupov\
 
 void handleSettings() {
 
-  size_t size = 5700;
-  char *offset;
-  size_t len = 0;
-  char *Settings_temp = (char *) malloc(size);
-
-  if (Settings_temp == NULL) {
-    return;
-  }
-
-  offset = Settings_temp;
+  SoC->swSer_enableRx(false);
+  Web_begin(200, "text/html");
 
   /* Common part 1 */
-  snprintf_P ( offset, size,
+  Web_printf_P (
     PSTR("<html>\
 <head>\
 <meta name='viewport' content='width=device-width, initial-scale=1'>\
@@ -190,15 +307,11 @@ void handleSettings() {
 /*  (settings->mode == SOFTRF_MODE_WATCHOUT ? "selected" : ""), SOFTRF_MODE_WATCHOUT, */
   );
 
-  len = strlen(offset);
-  offset += len;
-  size -= len;
-
   /* Radio specific part 1 */
   if (hw_info.rf == RF_IC_SX1276 ||
       hw_info.rf == RF_IC_SX1262 ||
       hw_info.rf == RF_IC_LR112X) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("\
 <tr>\
 <th align=left>Protocol</th>\
@@ -235,7 +348,7 @@ void handleSettings() {
      RF_PROTOCOL_APRS, prol_proto_desc.name
     );
   } else {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("\
 <tr>\
 <th align=left>Protocol</th>\
@@ -250,12 +363,9 @@ void handleSettings() {
      "UNK")))))
     );
   }
-  len = strlen(offset);
-  offset += len;
-  size -= len;
 
   /* Common part 2 */
-  snprintf_P ( offset, size,
+  Web_printf_P (
     PSTR("\
 <tr>\
 <th align=left>Region</th>\
@@ -372,14 +482,10 @@ void handleSettings() {
   (settings->pointer == LED_OFF ? "selected" : ""), LED_OFF
   );
 
-  len = strlen(offset);
-  offset += len;
-  size -= len;
-
 #if !defined(EXCLUDE_BLUETOOTH)
   /* SoC specific part 1 */
   if (SoC->id == SOC_ESP32 || SoC->id == SOC_RP2040) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("\
 <tr>\
 <th align=left>Built-in Bluetooth</th>\
@@ -398,15 +504,11 @@ void handleSettings() {
     (settings->bluetooth == BLUETOOTH_A2DP_SOURCE    ? "selected" : ""), BLUETOOTH_A2DP_SOURCE
     );
 
-    len = strlen(offset);
-    offset += len;
-    size -= len;
-
   } else if (SoC->id == SOC_ESP32S3 || SoC->id == SOC_ESP32C2 ||
              SoC->id == SOC_ESP32C3 || SoC->id == SOC_ESP32C6 ||
              SoC->id == SOC_RA4M1) {
 
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("\
 <tr>\
 <th align=left>Built-in Bluetooth</th>\
@@ -420,15 +522,11 @@ void handleSettings() {
     (settings->bluetooth == BLUETOOTH_NONE           ? "selected" : ""), BLUETOOTH_NONE,
     (settings->bluetooth == BLUETOOTH_LE_HM10_SERIAL ? "selected" : ""), BLUETOOTH_LE_HM10_SERIAL
     );
-
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 #endif /* EXCLUDE_BLUETOOTH */
 
   /* Common part 3 */
-  snprintf_P ( offset, size,
+  Web_printf_P (
     PSTR("\
 <tr>\
 <th align=left>NMEA sentences:</th>\
@@ -476,16 +574,12 @@ void handleSettings() {
   (settings->nmea_out == NMEA_UART ? "selected" : ""), NMEA_UART,
   (settings->nmea_out == NMEA_UDP  ? "selected" : ""), NMEA_UDP);
 
-  len = strlen(offset);
-  offset += len;
-  size -= len;
-
   /* SoC specific part 2 */
   if (SoC->id == SOC_ESP32   || SoC->id == SOC_ESP32S3 ||
       SoC->id == SOC_ESP32C2 || SoC->id == SOC_ESP32C3 ||
       SoC->id == SOC_ESP32C6 || SoC->id == SOC_RP2040  ||
       SoC->id == SOC_RA4M1) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR(
 #if defined(NMEA_TCP_SERVICE)
 "<option %s value='%d'>TCP</option>"
@@ -495,25 +589,17 @@ void handleSettings() {
 "<option %s value='%d'>Bluetooth</option>"),
       (settings->nmea_out == NMEA_TCP       ? "selected" : ""), NMEA_TCP,
       (settings->nmea_out == NMEA_BLUETOOTH ? "selected" : ""), NMEA_BLUETOOTH);
-
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
   if (SoC->id == SOC_ESP32S2 || SoC->id == SOC_ESP32S3 ||
       SoC->id == SOC_ESP32C3 || SoC->id == SOC_ESP32C6 ||
       SoC->id == SOC_RP2040) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("<option %s value='%d'>USB</option>"),
       (settings->nmea_out == NMEA_USB       ? "selected" : ""), NMEA_USB);
-
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 
   /* Common part 4 */
-  snprintf_P ( offset, size,
+  Web_printf_P (
     PSTR("\
 </select>\
 </td>\
@@ -529,40 +615,28 @@ void handleSettings() {
   (settings->gdl90 == GDL90_UART ? "selected" : ""), GDL90_UART,
   (settings->gdl90 == GDL90_UDP  ? "selected" : ""), GDL90_UDP);
 
-  len = strlen(offset);
-  offset += len;
-  size -= len;
-
 #if !defined(EXCLUDE_BLUETOOTH)
   /* SoC specific part 3 */
   if (SoC->id == SOC_ESP32   || SoC->id == SOC_ESP32S3 ||
       SoC->id == SOC_ESP32C2 || SoC->id == SOC_ESP32C3 ||
       SoC->id == SOC_ESP32C6 || SoC->id == SOC_RP2040  ||
       SoC->id == SOC_RA4M1) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("<option %s value='%d'>Bluetooth</option>"),
       (settings->gdl90 == GDL90_BLUETOOTH ? "selected" : ""), GDL90_BLUETOOTH);
-
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 #endif /* EXCLUDE_BLUETOOTH */
 
   if (SoC->id == SOC_ESP32S2 || SoC->id == SOC_ESP32S3 ||
       SoC->id == SOC_ESP32C3 || SoC->id == SOC_ESP32C6 ||
       SoC->id == SOC_RP2040) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("<option %s value='%d'>USB</option>"),
       (settings->gdl90 == GDL90_USB       ? "selected" : ""), GDL90_USB);
-
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 
   /* Common part 5 */
-  snprintf_P ( offset, size,
+  Web_printf_P (
     PSTR("\
 </select>\
 </td>\
@@ -576,40 +650,28 @@ void handleSettings() {
   (settings->d1090 == D1090_OFF  ? "selected" : ""), D1090_OFF,
   (settings->d1090 == D1090_UART ? "selected" : ""), D1090_UART);
 
-  len = strlen(offset);
-  offset += len;
-  size -= len;
-
 #if !defined(EXCLUDE_BLUETOOTH)
   /* SoC specific part 4 */
   if (SoC->id == SOC_ESP32   || SoC->id == SOC_ESP32S3 ||
       SoC->id == SOC_ESP32C2 || SoC->id == SOC_ESP32C3 ||
       SoC->id == SOC_ESP32C6 || SoC->id == SOC_RP2040  ||
       SoC->id == SOC_RA4M1) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("<option %s value='%d'>Bluetooth</option>"),
       (settings->d1090 == D1090_BLUETOOTH ? "selected" : ""), D1090_BLUETOOTH);
-
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 #endif /* EXCLUDE_BLUETOOTH */
 
   if (SoC->id == SOC_ESP32S2 || SoC->id == SOC_ESP32S3 ||
       SoC->id == SOC_ESP32C3 || SoC->id == SOC_ESP32C6 ||
       SoC->id == SOC_RP2040) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("<option %s value='%d'>USB</option>"),
       (settings->d1090 == D1090_USB       ? "selected" : ""), D1090_USB);
-
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 
   /* Common part 6 */
-  snprintf_P ( offset, size,
+  Web_printf_P (
     PSTR("\
 </select>\
 </td>\
@@ -626,22 +688,14 @@ void handleSettings() {
   (settings->power_save == POWER_SAVE_GNSS ? "selected" : ""), POWER_SAVE_GNSS
   );
 
-  len = strlen(offset);
-  offset += len;
-  size -= len;
-
   /* Radio specific part 2 */
   if (rf_chip && rf_chip->type == RF_IC_SA8X8) {
-    snprintf_P(offset, size, PSTR("<option %s value='%d'>No receive</option>"),
+    Web_printf_P(PSTR("<option %s value='%d'>No receive</option>"),
     (settings->power_save == POWER_SAVE_NORECEIVE ? "selected" : ""), POWER_SAVE_NORECEIVE);
-
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 
   /* Common part 7 */
-  snprintf_P ( offset, size,
+  Web_printf_P (
     PSTR("\
 </select>\
 </td>\
@@ -664,13 +718,9 @@ void handleSettings() {
   (!settings->no_track ? "checked" : "") , (settings->no_track ? "checked" : "")
   );
 
-  len = strlen(offset);
-  offset += len;
-  size -= len;
-
   /* Radio specific part 3 */
   if (rf_chip && rf_chip->type == RF_IC_SX1276) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
       PSTR("\
 <tr>\
 <th align=left>Radio CF correction (&#177;, kHz)</th>\
@@ -679,14 +729,10 @@ void handleSettings() {
 </td>\
 </tr>"),
     settings->freq_corr);
-
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 
 #if defined(USE_OGN_ENCRYPTION)
-  snprintf_P ( offset, size,
+  Web_printf_P (
     PSTR("\
 <tr>\
 <th align=left>IGC key</th>\
@@ -695,14 +741,10 @@ void handleSettings() {
 </td>\
 </tr>"),
   settings->igc_key[0], settings->igc_key[1], settings->igc_key[2], settings->igc_key[3]);
-
-  len = strlen(offset);
-  offset += len;
-  size -= len;
 #endif
 
   /* Common part 8 */
-  snprintf_P ( offset, size,
+  Web_printf_P (
     PSTR("\
 </table>\
 <p align=center><INPUT type='submit' value='Save and restart'></p>\
@@ -711,33 +753,8 @@ void handleSettings() {
 </html>")
   );
 
-  SoC->swSer_enableRx(false);
-  server.sendHeader(String(F("Cache-Control")), String(F("no-cache, no-store, must-revalidate")));
-  server.sendHeader(String(F("Pragma")), String(F("no-cache")));
-  server.sendHeader(String(F("Expires")), String(F("-1")));
-#if !defined(USE_ARDUINO_WIFI) || defined(USING_WIFI101_GENERIC)
-  server.send ( 200, "text/html", Settings_temp );
-#else
-
-#define HTML_MAX_CHUNK_SIZE (JS_MAX_CHUNK_SIZE / 2)
-
-  char *content = Settings_temp;
-  size_t bytes_left = strlen(Settings_temp);
-  size_t chunk_size;
-
-  server.setContentLength(bytes_left);
-  server.send(200, String(F("text/html")), "");
-
-  do {
-    chunk_size = bytes_left > HTML_MAX_CHUNK_SIZE ?
-                 HTML_MAX_CHUNK_SIZE : bytes_left;
-    server.sendContent(content, chunk_size);
-    content += chunk_size;
-    bytes_left -= chunk_size;
-  } while (bytes_left > 0) ;
-#endif /* USE_ARDUINO_WIFI */
+  Web_end();
   SoC->swSer_enableRx(true);
-  free(Settings_temp);
 }
 
 void handleRoot() {
@@ -753,22 +770,15 @@ void handleRoot() {
   char str_alt[16];
   char str_Vcc[8];
 
-  size_t size = 2420;
-  char *offset;
-  size_t len = 0;
-
-  char *Root_temp = (char *) malloc(size);
-  if (Root_temp == NULL) {
-    return;
-  }
-  offset = Root_temp;
-
   dtostrf(ThisAircraft.latitude,  8, 4, str_lat);
   dtostrf(ThisAircraft.longitude, 8, 4, str_lon);
   dtostrf(ThisAircraft.altitude,  7, 1, str_alt);
   dtostrf(vdd, 4, 2, str_Vcc);
 
-  snprintf_P ( offset, size,
+  SoC->swSer_enableRx(false);
+  Web_begin(200, "text/html");
+
+  Web_printf_P (
     PSTR("<html>\
   <head>\
     <meta name='viewport' content='width=device-width, initial-scale=1'>\
@@ -806,22 +816,12 @@ void handleRoot() {
    <tr><th align=left>Packets</th>\
     <td align=right><table><tr>\
      <th align=left>Tx&nbsp;&nbsp;</th><td align=right>%u</td>\
-     <th align=left>&nbsp;&nbsp;&nbsp;&nbsp;Rx&nbsp;&nbsp;</th><td align=right>%u</td>\
-   </tr></table></td></tr>\
- </table>\
- <h2 align=center>Most recent GNSS fix</h2>\
- <table width=100%%>\
-  <tr><th align=left>Time</th><td align=right>%u</td></tr>\
-  <tr><th align=left>Satellites</th><td align=right>%d</td></tr>\
-  <tr><th align=left>Latitude</th><td align=right>%s</td></tr>\
-  <tr><th align=left>Longitude</th><td align=right>%s</td></tr>\
-  <tr><td align=left><b>Altitude</b>&nbsp;&nbsp;(above MSL)</td><td align=right>%s</td></tr>\
- </table>\
- <hr>\
- <table width=100%%>\
-  <tr>\
-    <td align=left><input type=button onClick=\"location.href='/settings'\" value='Settings'></td>\
-    <td align=center><input type=button onClick=\"location.href='/about'\" value='About'></td>"),
+     <th align=left>&nbsp;&nbsp;&nbsp;&nbsp;Rx&nbsp;&nbsp;</th><td align=right>%u</td>"
+#if defined(ENABLE_RF_TASK)
+    "<th align=left>&nbsp;&nbsp;&nbsp;&nbsp;Lost&nbsp;&nbsp;</th><td align=right>%u</td>"
+#endif /* ENABLE_RF_TASK */
+   "</tr></table></td></tr>\
+ </table>"),
     ThisAircraft.addr, SOFTRF_FIRMWARE_VERSION
 #if defined(USE_USB_HOST)
     "H"
@@ -843,58 +843,152 @@ void handleRoot() {
     ESP32_USB_Serial.connected ? supported_USB_devices[ESP32_USB_Serial.index].first_name : "",
     ESP32_USB_Serial.connected ? supported_USB_devices[ESP32_USB_Serial.index].last_name  : "N/A",
 #endif /* USE_USB_HOST */
-    tx_packets_counter, rx_packets_counter,
-    timestamp, sats, str_lat, str_lon, str_alt
+    tx_packets_counter, rx_packets_counter
+#if defined(ENABLE_RF_TASK)
+    , RF_Task_Stats.dropped
+#endif /* ENABLE_RF_TASK */
   );
 
-  len = strlen(offset);
-  offset += len;
-  size -= len;
+  if (settings->rf_protocol == RF_PROTOCOL_FANET) {
+    Web_printf_P (
+    PSTR("<table width=100%%>\
+   <tr><th align=left>FANET</th>\
+    <td align=right><table><tr>\
+     <th align=left>Relayed&nbsp;&nbsp;</th><td align=right>%u</td>\
+     <th align=left>&nbsp;&nbsp;&nbsp;&nbsp;Duplicates&nbsp;&nbsp;</th><td align=right>%u</td>\
+     <th align=left>&nbsp;&nbsp;&nbsp;&nbsp;Cancelled&nbsp;&nbsp;</th><td align=right>%u</td>\
+     <th align=left>&nbsp;&nbsp;&nbsp;&nbsp;Deferred&nbsp;&nbsp;</th><td align=right>%u</td>\
+    </tr></table></td></tr>\
+ </table>"),
+    fanet_stats.forwarded, fanet_stats.duplicates,
+    fanet_stats.cancelled, fanet_stats.deferred);
+
+    if (fanet_service.addr) {
+      char str_temp[8];
+      char str_wind[8];
+      char str_gust[8];
+      char str_dir[8];
+
+      dtostrf(fanet_service.temperature, 5, 1, str_temp);
+      dtostrf(fanet_service.wind_speed,  5, 1, str_wind);
+      dtostrf(fanet_service.wind_gust,   5, 1, str_gust);
+      dtostrf(fanet_service.wind_dir,    3, 0, str_dir);
+
+      Web_printf_P (
+      PSTR("<h2 align=center>Weather station</h2>\
+ <table width=100%%>\
+  <tr><th align=left>Station Id</th><td align=right>%06X</td></tr>\
+  <tr><th align=left>Time</th><td align=right>%u</td></tr>\
+  <tr><th align=left>Temperature</th><td align=right>%s &deg;C</td></tr>\
+  <tr><th align=left>Wind</th><td align=right>%s&deg; %s km/h</td></tr>\
+  <tr><th align=left>Gusts</th><td align=right>%s km/h</td></tr>\
+ </table>"),
+      fanet_service.addr, (unsigned int) fanet_service.timestamp,
+      (fanet_service.header & FANET_SRV_TEMPERATURE) ? str_temp : "N/A",
+      (fanet_service.header & FANET_SRV_WIND) ? str_dir  : "",
+      (fanet_service.header & FANET_SRV_WIND) ? str_wind : "N/A",
+      (fanet_service.header & FANET_SRV_WIND) ? str_gust : "N/A");
+    }
+  }
+
+  Web_printf_P (
+    PSTR("<h2 align=center>Most recent GNSS fix</h2>\
+ <table width=100%%>\
+  <tr><th align=left>Time</th><td align=right>%u</td></tr>\
+  <tr><th align=left>Satellites</th><td align=right>%d</td></tr>\
+  <tr><th align=left>Latitude</th><td align=right>%s</td></tr>\
+  <tr><th align=left>Longitude</th><td align=right>%s</td></tr>\
+  <tr><td align=left><b>Altitude</b>&nbsp;&nbsp;(above MSL)</td><td align=right>%s</td></tr>\
+ </table>\
+ <hr>\
+ <table width=100%%>\
+  <tr>\
+    <td align=left><input type=button onClick=\"location.href='/settings'\" value='Settings'></td>\
+    <td align=center><input type=button onClick=\"location.href='/about'\" value='About'></td>"),
+    timestamp, sats, str_lat, str_lon, str_alt
+  );
 
 #if defined(ENABLE_RECORDER)
   if (FR_is_active) {
-    snprintf_P ( offset, size,
+    Web_printf_P (
     PSTR("<td align=center>&nbsp;&nbsp;&nbsp;<input type=button onClick=\"location.href='/flights'\" value='Flights'></td>"));
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 #endif /* ENABLE_RECORDER */
 
   /* SoC specific part 1 */
   if (SoC->id != SOC_RP2040 && SoC->id != SOC_RA4M1) {
-    snprintf_P ( offset, size, PSTR("\
+    Web_printf_P ( PSTR("\
     <td align=right><input type=button onClick=\"location.href='/firmware'\" value='Firmware update'></td>"));
-    len = strlen(offset);
-    offset += len;
-    size -= len;
   }
 
-  snprintf_P ( offset, size, PSTR("\
+  Web_printf_P ( PSTR("\
   </tr>\
  </table>\
 </body>\
 </html>")
   );
 
-  SoC->swSer_enableRx(false);
-  server.sendHeader(String(F("Cache-Control")), String(F("no-cache, no-store, must-revalidate")));
-  server.sendHeader(String(F("Pragma")), String(F("no-cache")));
-  server.sendHeader(String(F("Expires")), String(F("-1")));
-  server.send ( 200, "text/html", Root_temp );
+  Web_end();
   SoC->swSer_enableRx(true);
-  free(Root_temp);
 }
 
-void handleInput() {
+#if defined(ENABLE_PROFILER)
+void handlePerf() {
+
+  profiler_stats_t stats;
+
+  if (server.hasArg("reset")) {
+    Profiler_reset();
+  }
 
-  size_t size = 1700;
+  SoC->swSer_enableRx(false);
+  Web_begin(200, "text/html");
 
-  char *Input_temp = (char *) malloc(size);
-  if (Input_temp == NULL) {
-    return;
+  Web_printf_P (
+    PSTR("<html>\
+  <head>\
+    <meta http-equiv='refresh' content='10'>\
+    <meta name='viewport' content='width=device-width, initial-scale=1'>\
+    <title>SoftRF timing</title>\
+  </head>\
+<body>\
+ <h1 align=center>Timing (us)</h1>\
+ <table width=100%%>\
+  <tr><th align=left>Probe</th><th align=right>Count</th><th align=right>Min</th>\
+  <th align=right>Avg</th><th align=right>Max</th><th align=right>P99</th></tr>"));
+
+  for (uint8_t i=0; i < PROBE_COUNT; i++) {
+    if (!Profiler_stats(i, &stats)) {
+      continue;
+    }
+
+    Web_printf_P (
+      PSTR("<tr><td align=left>%s</td><td align=right>%lu</td><td align=right>%lu</td>\
+<td align=right>%lu</td><td align=right>%lu</td><td align=right>%lu</td></tr>"),
+      Probe_Name[i], (unsigned long) stats.count, (unsigned long) stats.min,
+      (unsigned long) stats.avg, (unsigned long) stats.max, (unsigned long) stats.p99);
   }
 
+  Web_printf_P ( PSTR("\
+ </table>\
+ <hr>\
+ <table width=100%%>\
+  <tr>\
+    <td align=left><input type=button onClick=\"location.href='/'\" value='Status'></td>\
+    <td align=right><input type=button onClick=\"location.href='/perf?reset=1'\" value='Reset'></td>\
+  </tr>\
+ </table>\
+</body>\
+</html>")
+  );
+
+  Web_end();
+  SoC->swSer_enableRx(true);
+}
+#endif /* ENABLE_PROFILER */
+
+void handleInput() {
+
   for ( uint8_t i = 0; i < server.args(); i++ ) {
     if (server.argName(i).equals("mode")) {
       settings->mode = server.arg(i).toInt();
@@ -956,7 +1050,9 @@ void handleInput() {
 #endif
     }
   }
-  snprintf_P ( Input_temp, size,
+  SoC->swSer_enableRx(false);
+  Web_begin(200, "text/html");
+  Web_printf_P (
 PSTR("<html>\
 <head>\
 <meta http-equiv='refresh' content='15; url=/'>\
@@ -1003,11 +1099,9 @@ PSTR("<html>\
   settings->power_save, settings->freq_corr,
   settings->igc_key[0], settings->igc_key[1], settings->igc_key[2], settings->igc_key[3]
   );
-  SoC->swSer_enableRx(false);
-  server.send ( 200, "text/html", Input_temp );
+  Web_end();
 //  SoC->swSer_enableRx(true);
   delay(1000);
-  free(Input_temp);
   EEPROM_store();
   Sound_fini();
   RF_Shutdown();
@@ -1021,108 +1115,84 @@ PSTR("<html>\
 extern SdFat uSD;
 
 #define FILESYSTEM       uSD
-#define FLIGHTS_DIR      "/Flights"
-#define MAX_IGC_FILE_NUM 200
 
-typedef struct
+static void Web_FileSize(char *buf, size_t size, uint32_t bytes)
 {
-  String filename;
-  String fsize;
-  uint16_t date;
-  uint16_t time;
-  uint16_t s_ndx; /* reserved */
-} fileinfo;
-
-String   webpage;
-fileinfo Filenames[MAX_IGC_FILE_NUM];
-static int numfiles;
-
-String ConvBinUnits(int bytes, int resolution) {
-  if      (bytes < 1024)                 {
-    return String(bytes) + " B";
-  }
-  else if (bytes < 1024 * 1024)          {
-    return String((bytes / 1024.0), resolution) + " KB";
-  }
-  else if (bytes < (1024 * 1024 * 1024)) {
-    return String((bytes / 1024.0 / 1024.0), resolution) + " MB";
+  if (bytes < 1024) {
+    snprintf(buf, size, "%lu B", (unsigned long) bytes);
+  } else if (bytes < 1024UL * 1024) {
+    snprintf(buf, size, "%lu.%lu KB", (unsigned long) (bytes / 1024),
+             (unsigned long) ((bytes % 1024) * 10 / 1024));
+  } else {
+    snprintf(buf, size, "%lu.%lu MB", (unsigned long) (bytes >> 20),
+             (unsigned long) ((bytes & 0xFFFFF) * 10 >> 20));
   }
-  else return "";
 }
 
-void Flights() {
-  char buf[48];
-  String filename;
-  numfiles = 0;
-
-  File32 root = FILESYSTEM.open(FLIGHTS_DIR);
-  if (root) {
-    root.rewindDirectory();
-    File32 file = root.openNextFile();
-    while (file) {
-      if (!file.isDirectory()) {
-        file.getName(buf, sizeof(buf));
-        filename = String(buf);
-        if (filename.endsWith(".igc") || filename.endsWith(".IGC")) {
-          Filenames[numfiles].filename = (filename.startsWith("/") ? filename.substring(1) : filename);
-          Filenames[numfiles].fsize    = ConvBinUnits(file.size(), 1);
-          file.getModifyDateTime(&Filenames[numfiles].date, &Filenames[numfiles].time);
-          numfiles++;
-
-          if (numfiles >= MAX_IGC_FILE_NUM) break;
-        }
-      }
-      file = root.openNextFile();
-    }
-    root.close();
+void Handle_Flight_Download() {
+
+  recorder_index_t page[RECORDER_INDEX_PAGE];
+  uint32_t total = Recorder_Index_count();
+  uint32_t pages = (total + RECORDER_INDEX_PAGE - 1) / RECORDER_INDEX_PAGE;
+  uint32_t pg    = server.hasArg("page") ? server.arg("page").toInt() : 0;
+
+  if (pg >= pages) {
+    pg = pages > 0 ? pages - 1 : 0;
   }
-}
 
-void Handle_Flight_Download() {
-  String filename;
-  int index = 0;
-
-  Flights();
-
-  webpage  = "<html>";
-  webpage += "<head>";
-  webpage += "<meta name='viewport' content='width=device-width, initial-scale=1'>";
-  webpage += "<title>Flights</title>";
-  webpage += "</head>";
-  webpage += "<body>";
-
-  if (numfiles > 0) {
-    webpage += "<table width=100%%><tr>";
-    webpage += "<td align=center><h2>Select a flight to download</h2></td>";
-    webpage += "</tr></table>";
-    webpage += "<table width=100%%>";
-    webpage += "<tr><th align=left>File Name</th><th align=right>Size</th></tr>";
-    webpage += "<tr><td><hr></td><td><hr></td></tr>";
-
-    index = numfiles - 1;
-    while (index >= 0) {
-      filename = Filenames[index].filename;
-      webpage += "<tr><td align=left><a href='" FLIGHTS_DIR "/" + filename +
-                 "'>" + filename + "</a><td align=right>" +
-                 Filenames[index].fsize + "</td></tr>";
-      index--;
+  size_t count = Recorder_Index_page(pg * RECORDER_INDEX_PAGE, page,
+                                     RECORDER_INDEX_PAGE);
+
+  Web_begin(200, "text/html");
+
+  Web_printf_P(PSTR("<html>\
+<head>\
+<meta name='viewport' content='width=device-width, initial-scale=1'>\
+<title>Flights</title>\
+</head>\
+<body>"));
+
+  if (count > 0) {
+    Web_printf_P(PSTR("<table width=100%%><tr>\
+<td align=center><h2>Select a flight to download</h2></td>\
+</tr></table>\
+<table width=100%%>\
+<tr><th align=left>File Name</th><th align=right>Date</th><th align=right>Size</th></tr>\
+<tr><td><hr></td><td><hr></td><td><hr></td></tr>"));
+
+    for (size_t i=0; i < count; i++) {
+      recorder_index_t *rec = &page[i];
+      char fsize[16];
+
+      Web_FileSize(fsize, sizeof(fsize), rec->size);
+
+      Web_printf_P(PSTR("<tr><td align=left><a href='" RECORDER_FLIGHTS_DIR "/%s'>%s</a></td>\
+<td align=right>%04u-%02u-%02u %02u:%02u</td><td align=right>%s</td></tr>"),
+        rec->name, rec->name,
+        FS_YEAR(rec->date), FS_MONTH(rec->date), FS_DAY(rec->date),
+        FS_HOUR(rec->time), FS_MINUTE(rec->time), fsize);
+    }
+
+    Web_printf_P(PSTR("<tr><td><hr></td><td><hr></td><td><hr></td></tr>\
+<tr><td align=left>%lu file(s) total</td><td align=right>"), (unsigned long) total);
+
+    if (pg > 0) {
+      Web_printf_P(PSTR("<a href='/flights?page=%lu'>&lt; Newer</a>"),
+                   (unsigned long) (pg - 1));
     }
-    webpage += "<tr><td><hr></td><td><hr></td></tr>";
-    if (numfiles >= MAX_IGC_FILE_NUM) {
-      webpage += "<tr><td align=left>view is limited to " +
-                 String(MAX_IGC_FILE_NUM) + " files only</td></tr>";
-    } else {
-      webpage += "<tr><td align=left>" + String(numfiles) + " file(s) total</td></tr>";
+    Web_printf_P(PSTR("&nbsp;%lu / %lu&nbsp;"), (unsigned long) (pg + 1),
+                 (unsigned long) pages);
+    if (pg + 1 < pages) {
+      Web_printf_P(PSTR("<a href='/flights?page=%lu'>Older &gt;</a>"),
+                   (unsigned long) (pg + 1));
     }
-    webpage += "</table>";
+    Web_printf_P(PSTR("</td><td></td></tr></table>"));
   } else {
-    webpage += "<h2>No flights found</h2>";
+    Web_printf_P(PSTR("<h2>No flights found</h2>"));
   }
 
-  webpage += "</body>";
-  webpage += "</html>";
-
-  server.send(200, "text/html", webpage);
+  Web_printf_P(PSTR("</body></html>"));
+  Web_end();
 }
 
 String getContentType(String filename) {
@@ -1199,20 +1269,17 @@ void handleNotFound() {
   if (!handleFileRead(server.uri()))
 #endif /* ENABLE_RECORDER */
   {
-    String message = "File Not Found\n\n";
-    message += "URI: ";
-    message += server.uri();
-    message += "\nMethod: ";
-    message += ( server.method() == HTTP_GET ) ? "GET" : "POST";
-    message += "\nArguments: ";
-    message += server.args();
-    message += "\n";
+    Web_begin(404, "text/plain");
+    Web_printf_P(PSTR("File Not Found\n\nURI: %s\nMethod: %s\nArguments: %d\n"),
+                 server.uri().c_str(),
+                 ( server.method() == HTTP_GET ) ? "GET" : "POST",
+                 server.args());
 
     for ( uint8_t i = 0; i < server.args(); i++ ) {
-      message += " " + server.argName ( i ) + ": " + server.arg ( i ) + "\n";
+      Web_printf_P(PSTR(" %s: %s\n"),
+                   server.argName ( i ).c_str(), server.arg ( i ).c_str());
     }
-
-    server.send ( 404, "text/plain", message );
+    Web_end();
   }
 }
 
@@ -1230,6 +1297,17 @@ void Web_setup()
   } );
 
   server.on ( "/input", handleInput );
+
+#if defined(ENABLE_PROFILER)
+  server.on ( "/perf", handlePerf );
+  server.on ( "/perf.json", []() {
+    char buf[PROFILER_JSON_SIZE];
+
+    Profiler_JSON(buf, sizeof(buf));
+    server.sendHeader(String(F("Cache-Control")), String(F("no-cache, no-store, must-revalidate")));
+    server.send ( 200, "application/json", buf );
+  } );
+#endif /* ENABLE_PROFILER */
   server.on ( "/inline", []() {
     server.send ( 200, "text/plain", "this works as well" );
   } );
@@ -30,6 +30,7 @@
 
 #define BOOL_STR(x) (x ? "true":"false")
 #define JS_MAX_CHUNK_SIZE 4096
+#define WEB_CHUNK_SIZE    512
 
 void Web_setup(void);
 void Web_loop(void);
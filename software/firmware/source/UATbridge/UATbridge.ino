@@ -171,17 +171,36 @@ static bool UAT_Receive_Sync()
   }
 }
 
-static bool UAT_receive_complete  = false;
-static bool UAT_receive_active    = false;
+/*
+ * Frames are queued by the Rx callback and the receiver is re-armed
+ * right away, so that FEC and decode in loop() do not cost lost frames.
+ */
+#define UAT_RX_RING_SIZE  4 /* power of 2 */
+
+static EasyLink_RxPacket UAT_Rx_Ring[UAT_RX_RING_SIZE];
+static volatile uint8_t  UAT_Rx_Head     = 0;
+static volatile uint8_t  UAT_Rx_Tail     = 0;
+static volatile uint32_t UAT_Rx_Overruns = 0;
+
+static volatile bool UAT_receive_active = false;
 
 void UAT_Receive_callback(EasyLink_RxPacket *rxPacket_ptr, EasyLink_Status status)
 {
-  UAT_receive_active = false;
-
   if (status == EasyLink_Status_Success) {
-    memcpy(&rxPacket, rxPacket_ptr, sizeof(rxPacket));
-    UAT_receive_complete  = true;
+    uint8_t head = UAT_Rx_Head;
+
+    if ((uint8_t) (head - UAT_Rx_Tail) < UAT_RX_RING_SIZE) {
+      memcpy(&UAT_Rx_Ring[head & (UAT_RX_RING_SIZE - 1)],
+             rxPacket_ptr, sizeof(EasyLink_RxPacket));
+      UAT_Rx_Head = head + 1;
+    } else {
+      UAT_Rx_Overruns++;
+    }
   }
+
+  /* EasyLink releases the radio before the callback. Keep on listening */
+  UAT_receive_active = (status != EasyLink_Status_Aborted &&
+                        myLink.receive(&UAT_Receive_callback) == EasyLink_Status_Success);
 }
 
 static bool UAT_Receive_Async()
@@ -205,14 +224,27 @@ static bool UAT_Receive_Async()
     }
   }
 
-  if (UAT_receive_complete == true) {
+  uint8_t tail = UAT_Rx_Tail;
+
+  if (tail != UAT_Rx_Head) {
+    memcpy(&rxPacket, &UAT_Rx_Ring[tail & (UAT_RX_RING_SIZE - 1)], sizeof(rxPacket));
+    UAT_Rx_Tail = tail + 1;
 
     success = true;
-    UAT_receive_complete = false;
 
     rx_packets_counter++;
   }
 
+#if defined(DEBUG_UAT)
+  static uint32_t overruns = 0;
+
+  if (UAT_Rx_Overruns != overruns) {
+    overruns = UAT_Rx_Overruns;
+    Serial.print(F("Rx ring overruns: "));
+    Serial.println(overruns);
+  }
+#endif
+
   return success;
 }
 
@@ -236,9 +236,11 @@ bool BLEUart_HM10::flushTXD(uint16_t conn_hdl)
   BLEConnection* conn = Bluefruit.Connection(conn_hdl);
   VERIFY(conn);
 
-  uint8_t chunk[BLE_MAX_WRITE_CHUNK_SIZE];
-  size_t size = (_tx_fifo->count() < BLE_MAX_WRITE_CHUNK_SIZE ?
-                 _tx_fifo->count() : BLE_MAX_WRITE_CHUNK_SIZE);
+  // one notification, as large as negotiated MTU allows
+  uint8_t chunk[BLE_MAX_NOTIFY_SIZE];
+  size_t max_size = conn->getMtu() - 3;
+  max_size = (max_size < BLE_MAX_NOTIFY_SIZE ? max_size : BLE_MAX_NOTIFY_SIZE);
+  size_t size = (_tx_fifo->count() < max_size ? _tx_fifo->count() : max_size);
 
   uint16_t len = _tx_fifo->read(chunk, size);
   bool result = true;
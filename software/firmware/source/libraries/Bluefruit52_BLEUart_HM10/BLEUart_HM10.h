@@ -47,6 +47,7 @@
 #define BLE_UART_HM10_DEFAULT_TX_FIFO_DEPTH   1024
 
 #define BLE_MAX_WRITE_CHUNK_SIZE              20
+#define BLE_MAX_NOTIFY_SIZE                   244 /* ATT MTU 247 - 3 */
 
 class BLEUart_HM10 : public BLEService, public Stream
 {
@@ -70,6 +71,7 @@ class BLEUart_HM10 : public BLEService, public Stream
 
     bool flushTXD (void);
     bool flushTXD (uint16_t conn_hdl);
+    int  pendingTXD (void) { return _tx_fifo ? _tx_fifo->count() : 0; }
 
     // Read helper
     uint8_t  read8 (void);
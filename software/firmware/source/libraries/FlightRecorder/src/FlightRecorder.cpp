@@ -764,6 +764,12 @@ void enableIGCWrite(bool enable)
   bIGCFileWrite = enable;
 }
 
+// path of the log being written, NULL until its header is on the card
+const char *currentIGC()
+{
+  return bIGCFileWrite && bIGCHeaderWritten ? igc_full_path : NULL;
+}
+
 } // IGC namespace
 
 //------------------------------------------------------------------------------
@@ -1001,3 +1007,7 @@ void FlightRecorder::loop(TinyGPSPlus *gnss_ptr, float press_alt) {
 void FlightRecorder::end() {
     IGC::closeIGC();
 }
+
+const char *FlightRecorder::file() {
+    return IGC::currentIGC();
+}
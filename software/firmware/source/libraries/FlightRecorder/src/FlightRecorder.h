@@ -131,6 +131,7 @@ namespace IGC
     void writeGRecord(const MD5::MD5_CTX &ctx);
     int  writeHRecord(const char *format, ...);
     void closeIGC();
+    const char *currentIGC();
 }
 
 class FlightRecorder {
@@ -140,6 +141,7 @@ public:
   bool begin(SdFat *, uint32_t, const char *);
   void loop(TinyGPSPlus *, float);
   void end();
+  const char *file();
 
 protected:
   SdFat *_SD_ptr;
@@ -385,18 +385,53 @@ class ADSL_Packet
        crc<<=1; }
      return crc; }
 
+   static uint32_t TablePass(uint32_t crc, uint8_t Byte)    // pass a single byte through the CRC, table driven, non-augmented
+   { static const uint32_t Table[256] = {
+ 0x000000, 0xFFF409, 0x001C1B, 0xFFE812, 0x003836, 0xFFCC3F, 0x00242D, 0xFFD024,
+ 0x00706C, 0xFF8465, 0x006C77, 0xFF987E, 0x00485A, 0xFFBC53, 0x005441, 0xFFA048,
+ 0x00E0D8, 0xFF14D1, 0x00FCC3, 0xFF08CA, 0x00D8EE, 0xFF2CE7, 0x00C4F5, 0xFF30FC,
+ 0x0090B4, 0xFF64BD, 0x008CAF, 0xFF78A6, 0x00A882, 0xFF5C8B, 0x00B499, 0xFF4090,
+ 0x01C1B0, 0xFE35B9, 0x01DDAB, 0xFE29A2, 0x01F986, 0xFE0D8F, 0x01E59D, 0xFE1194,
+ 0x01B1DC, 0xFE45D5, 0x01ADC7, 0xFE59CE, 0x0189EA, 0xFE7DE3, 0x0195F1, 0xFE61F8,
+ 0x012168, 0xFED561, 0x013D73, 0xFEC97A, 0x01195E, 0xFEED57, 0x010545, 0xFEF14C,
+ 0x015104, 0xFEA50D, 0x014D1F, 0xFEB916, 0x016932, 0xFE9D3B, 0x017529, 0xFE8120,
+ 0x038360, 0xFC7769, 0x039F7B, 0xFC6B72, 0x03BB56, 0xFC4F5F, 0x03A74D, 0xFC5344,
+ 0x03F30C, 0xFC0705, 0x03EF17, 0xFC1B1E, 0x03CB3A, 0xFC3F33, 0x03D721, 0xFC2328,
+ 0x0363B8, 0xFC97B1, 0x037FA3, 0xFC8BAA, 0x035B8E, 0xFCAF87, 0x034795, 0xFCB39C,
+ 0x0313D4, 0xFCE7DD, 0x030FCF, 0xFCFBC6, 0x032BE2, 0xFCDFEB, 0x0337F9, 0xFCC3F0,
+ 0x0242D0, 0xFDB6D9, 0x025ECB, 0xFDAAC2, 0x027AE6, 0xFD8EEF, 0x0266FD, 0xFD92F4,
+ 0x0232BC, 0xFDC6B5, 0x022EA7, 0xFDDAAE, 0x020A8A, 0xFDFE83, 0x021691, 0xFDE298,
+ 0x02A208, 0xFD5601, 0x02BE13, 0xFD4A1A, 0x029A3E, 0xFD6E37, 0x028625, 0xFD722C,
+ 0x02D264, 0xFD266D, 0x02CE7F, 0xFD3A76, 0x02EA52, 0xFD1E5B, 0x02F649, 0xFD0240,
+ 0x0706C0, 0xF8F2C9, 0x071ADB, 0xF8EED2, 0x073EF6, 0xF8CAFF, 0x0722ED, 0xF8D6E4,
+ 0x0776AC, 0xF882A5, 0x076AB7, 0xF89EBE, 0x074E9A, 0xF8BA93, 0x075281, 0xF8A688,
+ 0x07E618, 0xF81211, 0x07FA03, 0xF80E0A, 0x07DE2E, 0xF82A27, 0x07C235, 0xF8363C,
+ 0x079674, 0xF8627D, 0x078A6F, 0xF87E66, 0x07AE42, 0xF85A4B, 0x07B259, 0xF84650,
+ 0x06C770, 0xF93379, 0x06DB6B, 0xF92F62, 0x06FF46, 0xF90B4F, 0x06E35D, 0xF91754,
+ 0x06B71C, 0xF94315, 0x06AB07, 0xF95F0E, 0x068F2A, 0xF97B23, 0x069331, 0xF96738,
+ 0x0627A8, 0xF9D3A1, 0x063BB3, 0xF9CFBA, 0x061F9E, 0xF9EB97, 0x060385, 0xF9F78C,
+ 0x0657C4, 0xF9A3CD, 0x064BDF, 0xF9BFD6, 0x066FF2, 0xF99BFB, 0x0673E9, 0xF987E0,
+ 0x0485A0, 0xFB71A9, 0x0499BB, 0xFB6DB2, 0x04BD96, 0xFB499F, 0x04A18D, 0xFB5584,
+ 0x04F5CC, 0xFB01C5, 0x04E9D7, 0xFB1DDE, 0x04CDFA, 0xFB39F3, 0x04D1E1, 0xFB25E8,
+ 0x046578, 0xFB9171, 0x047963, 0xFB8D6A, 0x045D4E, 0xFBA947, 0x044155, 0xFBB55C,
+ 0x041514, 0xFBE11D, 0x04090F, 0xFBFD06, 0x042D22, 0xFBD92B, 0x043139, 0xFBC530,
+ 0x054410, 0xFAB019, 0x05580B, 0xFAAC02, 0x057C26, 0xFA882F, 0x05603D, 0xFA9434,
+ 0x05347C, 0xFAC075, 0x052867, 0xFADC6E, 0x050C4A, 0xFAF843, 0x051051, 0xFAE458,
+ 0x05A4C8, 0xFA50C1, 0x05B8D3, 0xFA4CDA, 0x059CFE, 0xFA68F7, 0x0580E5, 0xFA74EC,
+ 0x05D4A4, 0xFA20AD, 0x05C8BF, 0xFA3CB6, 0x05EC92, 0xFA189B, 0x05F089, 0xFA0480 } ;
+     return ((crc<<8)&0xFFFFFF) ^ Table[((crc>>16)^Byte)&0xFF]; }
+
    static uint32_t checkPI(const uint8_t *Byte, uint8_t Bytes) // run over data bytes and the three CRC bytes
-   { uint32_t crc = 0;
-     for(uint8_t Idx=0; Idx<Bytes; Idx++)
-     { crc = PolyPass(crc, Byte[Idx]); }
-     return crc>>8; }                                          // should be all zero for a correct packet
+   { if(Bytes<3) return 0xFFFFFF;
+     uint32_t crc = calcPI(Byte, Bytes-3);
+     Byte+=Bytes-3;
+     return crc ^ ((uint32_t)Byte[0]<<16) ^ ((uint32_t)Byte[1]<<8) ^ Byte[2]; } // should be all zero for a correct packet
 
    static uint32_t calcPI(const uint8_t *Byte, uint8_t Bytes)  // calculate PI for the given packet data excluding the three CRC bytes
    { uint32_t crc = 0;
      for(uint8_t Idx=0; Idx<Bytes; Idx++)
-     { crc = PolyPass(crc, Byte[Idx]); }
-     crc=PolyPass(crc, 0); crc=PolyPass(crc, 0); crc=PolyPass(crc, 0);
-     return crc>>8; }                                          //
+     { crc = TablePass(crc, Byte[Idx]); }
+     return crc; }                                             //
 
     void setCRC(void)
     { uint32_t Word = calcPI((const uint8_t *)&Version, TxBytes-6);
@@ -447,6 +482,18 @@ class ADSL_Packet
 
       return -1; }
 
+    static int Repair(uint8_t *PktData, uint8_t Bytes)         // fix up to two bit errors with the CRC syndrome alone
+    { if(Bytes!=TxBytes-3) return checkPI(PktData, Bytes)?-1:0;
+      uint32_t crc = checkPI(PktData, Bytes); if(crc==0) return 0;
+      uint8_t ErrBit=FindCRCsyndrome(crc);
+      if(ErrBit!=0xFF) { FlipBit(PktData, ErrBit); return 1; }
+      const uint16_t PacketBits = Bytes*8;
+      for(uint16_t Bit=0; Bit<PacketBits; Bit++)                       // for every bit assumed to be wrong
+      { ErrBit=FindCRCsyndrome(crc^CRCsyndrome(Bit));                  // look for the other one
+        if(ErrBit==0xFF || ErrBit<=Bit) continue;
+        FlipBit(PktData, Bit); FlipBit(PktData, ErrBit); return 2; }
+      return -1; }
+
     static void FlipBit(uint8_t *Byte, int BitIdx)
     { int ByteIdx=BitIdx>>3;
       BitIdx&=7; BitIdx=7-BitIdx;
@@ -456,7 +503,7 @@ class ADSL_Packet
     static uint32_t CRCsyndrome(uint8_t Bit)
     { const uint16_t PacketBytes = TxBytes-3;
       const uint16_t PacketBits = PacketBytes*8;
-      const uint32_t Syndrome[PacketBits] = {
+      static const uint32_t Syndrome[PacketBits] = {
  0x7ABEE1, 0xC2A574, 0x6152BA, 0x30A95D, 0xE7AEAA, 0x73D755, 0xC611AE, 0x6308D7,
  0xCE7E6F, 0x98C533, 0xB3989D, 0xA6364A, 0x531B25, 0xD67796, 0x6B3BCB, 0xCA67E1,
  0x9AC9F4, 0x4D64FA, 0x26B27D, 0xECA33A, 0x76519D, 0xC4D2CA, 0x626965, 0xCECEB6,
@@ -486,7 +533,7 @@ class ADSL_Packet
     static uint8_t FindCRCsyndrome(uint32_t Syndr)              // quick search for a single-bit CRC syndrome
     { const uint16_t PacketBytes = TxBytes-3;
       const uint16_t PacketBits = PacketBytes*8;
-      const uint32_t Syndrome[PacketBits] = {
+      static const uint32_t Syndrome[PacketBits] = {
  0x000001BF, 0x000002BE, 0x000004BD, 0x000008BC, 0x000010BB, 0x000020BA, 0x000040B9, 0x000080B8,
  0x000100B7, 0x000200B6, 0x000400B5, 0x000800B4, 0x001000B3, 0x001C1BA6, 0x002000B2, 0x003836A5,
  0x004000B1, 0x00706CA4, 0x008000B0, 0x00E0D8A3, 0x010000AF, 0x01856788, 0x01C1B0A2, 0x020000AE,
@@ -24,6 +24,8 @@
 
 #include "uat.h"
 #include "fec/rs.h"
+#include "fec/char.h"
+#include "fec/rs-common.h"
 
 static void *rs_uplink;
 static void *rs_adsb_short;
@@ -32,34 +34,84 @@ static void *rs_adsb_long;
 #define UPLINK_POLY 0x187
 #define ADSB_POLY 0x187
 
+#if !defined(ESP8266) && !defined(ENERGIA_ARCH_CC13XX) && !defined(ENERGIA_ARCH_CC13X2) && \
+    !defined(__ASR6501__) && !defined(ARDUINO_ARCH_STM32) && !defined(ARDUINO_ARCH_ASR650X)
+static uint16_t uplink_deinterleave[UPLINK_FRAME_BYTES];
+#endif
+
 void init_fec(void)
 {
+    // UAT radio drivers and the FIS-B hex input may both get here
+    if (rs_adsb_short)
+        return;
+
     rs_adsb_short = init_rs_char(8, /* gfpoly */ ADSB_POLY, /* fcr */ 120, /* prim */ 1, /* nroots */ 12, /* pad */ 225);
     rs_adsb_long  = init_rs_char(8, /* gfpoly */ ADSB_POLY, /* fcr */ 120, /* prim */ 1, /* nroots */ 14, /* pad */ 207);
 #if !defined(ESP8266) && !defined(ENERGIA_ARCH_CC13XX) && !defined(ENERGIA_ARCH_CC13X2) && \
     !defined(__ASR6501__) && !defined(ARDUINO_ARCH_STM32) && !defined(ARDUINO_ARCH_ASR650X)
     rs_uplink     = init_rs_char(8, /* gfpoly */ UPLINK_POLY, /* fcr */ 120, /* prim */ 1, /* nroots */ 20, /* pad */ 163);
+
+    // byte k of the interleaved frame is symbol k/6 of block k%6
+    for (int k = 0; k < UPLINK_FRAME_BYTES; ++k)
+        uplink_deinterleave[k] = (k % UPLINK_FRAME_BLOCKS) * UPLINK_BLOCK_BYTES + k / UPLINK_FRAME_BLOCKS;
 #endif
 }
 
+// Syndrome-only check: true if 'data' is a codeword as is.
+// Roots are evaluated one at a time, so a damaged block usually
+// bails out after the first one.
+static int is_codeword(void *p, const uint8_t *data)
+{
+    struct rs *rs = (struct rs *)p;
+    int i, j;
+
+    for (i = 0; i < NROOTS; ++i) {
+        int root = MODNN((FCR + i) * PRIM);
+        data_t s = data[0];
+
+        for (j = 1; j < NN - PAD; ++j)
+            s = data[j] ^ (s == 0 ? 0 : ALPHA_TO[MODNN(INDEX_OF[s] + root)]);
+
+        if (s != 0)
+            return 0;
+    }
+
+    return 1;
+}
+
 int correct_adsb_frame(uint8_t *to, int *rs_errors)
 {
-    // Try decoding as a Long UAT.
-    // We rely on decode_rs_char not modifying the data if there were
-    // uncorrectable errors.
-    int n_corrected = decode_rs_char(rs_adsb_long, to, NULL, 0);
-    if (n_corrected >= 0 && n_corrected <= 7 && (to[0]>>3) != 0) {
-        // Valid long frame.
-        *rs_errors = n_corrected;
-        return 2;
+    // The radio always delivers LONG_FRAME_BYTES, so the payload
+    // type bits are the only hint on the code (0 is Basic UAT).
+    int basic_first = (to[0]>>3) == 0;
+    int n_corrected;
+    int pass;
+
+    // Clean frames are the common case - try the syndromes alone first.
+    if (is_codeword(basic_first ? rs_adsb_short : rs_adsb_long, to)) {
+        *rs_errors = 0;
+        return basic_first ? 1 : 2;
     }
 
-    // Retry as Basic UAT
-    n_corrected = decode_rs_char(rs_adsb_short, to, NULL, 0);
-    if (n_corrected >= 0 && n_corrected <= 6 && (to[0]>>3) == 0) {
-        // Valid short frame
-        *rs_errors = n_corrected;
-        return 1;
+    // Full decode, the more likely code first.
+    // We rely on decode_rs_char not modifying the data if there were
+    // uncorrectable errors.
+    for (pass = 0; pass < 2; ++pass) {
+        if (basic_first == (pass == 0)) {
+            n_corrected = decode_rs_char(rs_adsb_short, to, NULL, 0);
+            if (n_corrected >= 0 && n_corrected <= 6 && (to[0]>>3) == 0) {
+                // Valid short frame
+                *rs_errors = n_corrected;
+                return 1;
+            }
+        } else {
+            n_corrected = decode_rs_char(rs_adsb_long, to, NULL, 0);
+            if (n_corrected >= 0 && n_corrected <= 7 && (to[0]>>3) != 0) {
+                // Valid long frame.
+                *rs_errors = n_corrected;
+                return 2;
+            }
+        }
     }
 
     // Failed.
@@ -71,15 +123,16 @@ int correct_adsb_frame(uint8_t *to, int *rs_errors)
     !defined(__ASR6501__) && !defined(ARDUINO_ARCH_STM32) && !defined(ARDUINO_ARCH_ASR650X)
 int correct_uplink_frame(uint8_t *from, uint8_t *to, int *rs_errors)
 {
-    int block;
+    int block, k;
     int total_corrected = 0;
 
-    for (block = 0; block < UPLINK_FRAME_BLOCKS; ++block) {
-        int i, n_corrected;
-        uint8_t *blockdata = &to[block * UPLINK_BLOCK_DATA_BYTES];
+    // de-interleave all the blocks in one sequential pass over 'from'
+    for (k = 0; k < UPLINK_FRAME_BYTES; ++k)
+        to[uplink_deinterleave[k]] = from[k];
 
-        for (i = 0; i < UPLINK_BLOCK_BYTES; ++i)
-            blockdata[i] = from[i * UPLINK_FRAME_BLOCKS + block];
+    for (block = 0; block < UPLINK_FRAME_BLOCKS; ++block) {
+        int n_corrected;
+        uint8_t *blockdata = &to[block * UPLINK_BLOCK_BYTES];
 
         // error-correct in place
         n_corrected = decode_rs_char(rs_uplink, blockdata, NULL, 0);
@@ -90,7 +143,10 @@ int correct_uplink_frame(uint8_t *from, uint8_t *to, int *rs_errors)
         }
 
         total_corrected += n_corrected;
-        // next block (if there is one) will overwrite the ECC bytes.
+
+        // pack data parts together, dropping the ECC bytes
+        if (block > 0)
+            memmove(&to[block * UPLINK_BLOCK_DATA_BYTES], blockdata, UPLINK_BLOCK_DATA_BYTES);
     }
 
     *rs_errors = total_corrected;
@@ -31,10 +31,29 @@ static X86Info *x86_info()
 
 #endif
 
+#if !defined(CPU_FEATURES_ARCH_X86) && defined(__GNUC__) && \
+    (defined(__x86_64__) || defined(__i386__))
+// no cpu_features - ask libgcc, which also checks that the OS saves YMM state
+#define CPU_BUILTIN_X86(_feature) (__builtin_cpu_init(), __builtin_cpu_supports(_feature))
+#endif
+
+int cpu_supports_sse41(void)
+{
+#ifdef CPU_FEATURES_ARCH_X86
+    return x86_info()->features.sse4_1;
+#elif defined(CPU_BUILTIN_X86)
+    return CPU_BUILTIN_X86("sse4.1");
+#else
+    return 0;
+#endif
+}
+
 int cpu_supports_avx(void)
 {
 #ifdef CPU_FEATURES_ARCH_X86
     return x86_info()->features.avx;
+#elif defined(CPU_BUILTIN_X86)
+    return CPU_BUILTIN_X86("avx");
 #else
     return 0;
 #endif
@@ -44,6 +63,8 @@ int cpu_supports_avx2(void)
 {
 #ifdef CPU_FEATURES_ARCH_X86
     return x86_info()->features.avx2;
+#elif defined(CPU_BUILTIN_X86)
+    return CPU_BUILTIN_X86("avx2");
 #else
     return 0;
 #endif
@@ -2,6 +2,7 @@
 #define DUMP1090_CPU_H
 
 // x86
+int cpu_supports_sse41(void);
 int cpu_supports_avx(void);
 int cpu_supports_avx2(void);
 
@@ -91,8 +91,11 @@ starch_count_above_u16_regentry starch_count_above_u16_registry[] = {
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "generic_x86_avx2", "x86_avx2", starch_count_above_u16_generic_x86_avx2, cpu_supports_avx2 },
-    { 1, "generic_generic", "generic", starch_count_above_u16_generic_generic, NULL },
+    { 0, "avx2_x86_avx2", "x86_avx2", starch_count_above_u16_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41", "x86_sse41", starch_count_above_u16_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "generic_x86_avx2", "x86_avx2", starch_count_above_u16_generic_x86_avx2, cpu_supports_avx2 },
+    { 3, "generic_x86_sse41", "x86_sse41", starch_count_above_u16_generic_x86_sse41, cpu_supports_sse41 },
+    { 4, "generic_generic", "generic", starch_count_above_u16_generic_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -172,9 +175,15 @@ starch_count_above_u16_aligned_regentry starch_count_above_u16_aligned_registry[
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "generic_x86_avx2_aligned", "x86_avx2", starch_count_above_u16_aligned_generic_x86_avx2, cpu_supports_avx2 },
-    { 1, "generic_generic", "generic", starch_count_above_u16_generic_generic, NULL },
-    { 2, "generic_x86_avx2", "x86_avx2", starch_count_above_u16_generic_x86_avx2, cpu_supports_avx2 },
+    { 0, "avx2_x86_avx2_aligned", "x86_avx2", starch_count_above_u16_aligned_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41_aligned", "x86_sse41", starch_count_above_u16_aligned_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "generic_x86_avx2_aligned", "x86_avx2", starch_count_above_u16_aligned_generic_x86_avx2, cpu_supports_avx2 },
+    { 3, "generic_generic", "generic", starch_count_above_u16_generic_generic, NULL },
+    { 4, "generic_x86_avx2", "x86_avx2", starch_count_above_u16_generic_x86_avx2, cpu_supports_avx2 },
+    { 5, "avx2_x86_avx2", "x86_avx2", starch_count_above_u16_avx2_x86_avx2, cpu_supports_avx2 },
+    { 6, "generic_x86_sse41_aligned", "x86_sse41", starch_count_above_u16_aligned_generic_x86_sse41, cpu_supports_sse41 },
+    { 7, "generic_x86_sse41", "x86_sse41", starch_count_above_u16_generic_x86_sse41, cpu_supports_sse41 },
+    { 8, "sse41_x86_sse41", "x86_sse41", starch_count_above_u16_sse41_x86_sse41, cpu_supports_sse41 },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -260,12 +269,17 @@ starch_magnitude_power_uc8_regentry starch_magnitude_power_uc8_registry[] = {
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "twopass_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_twopass_x86_avx2, cpu_supports_avx2 },
-    { 1, "twopass_generic", "generic", starch_magnitude_power_uc8_twopass_generic, NULL },
-    { 2, "lookup_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_lookup_x86_avx2, cpu_supports_avx2 },
-    { 3, "lookup_unroll_4_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
-    { 4, "lookup_generic", "generic", starch_magnitude_power_uc8_lookup_generic, NULL },
-    { 5, "lookup_unroll_4_generic", "generic", starch_magnitude_power_uc8_lookup_unroll_4_generic, NULL },
+    { 0, "avx2_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41", "x86_sse41", starch_magnitude_power_uc8_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "twopass_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_twopass_x86_avx2, cpu_supports_avx2 },
+    { 3, "twopass_generic", "generic", starch_magnitude_power_uc8_twopass_generic, NULL },
+    { 4, "lookup_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_lookup_x86_avx2, cpu_supports_avx2 },
+    { 5, "lookup_unroll_4_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
+    { 6, "twopass_x86_sse41", "x86_sse41", starch_magnitude_power_uc8_twopass_x86_sse41, cpu_supports_sse41 },
+    { 7, "lookup_x86_sse41", "x86_sse41", starch_magnitude_power_uc8_lookup_x86_sse41, cpu_supports_sse41 },
+    { 8, "lookup_unroll_4_x86_sse41", "x86_sse41", starch_magnitude_power_uc8_lookup_unroll_4_x86_sse41, cpu_supports_sse41 },
+    { 9, "lookup_generic", "generic", starch_magnitude_power_uc8_lookup_generic, NULL },
+    { 10, "lookup_unroll_4_generic", "generic", starch_magnitude_power_uc8_lookup_unroll_4_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -359,15 +373,25 @@ starch_magnitude_power_uc8_aligned_regentry starch_magnitude_power_uc8_aligned_r
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "twopass_x86_avx2_aligned", "x86_avx2", starch_magnitude_power_uc8_aligned_twopass_x86_avx2, cpu_supports_avx2 },
-    { 1, "twopass_generic", "generic", starch_magnitude_power_uc8_twopass_generic, NULL },
-    { 2, "lookup_x86_avx2_aligned", "x86_avx2", starch_magnitude_power_uc8_aligned_lookup_x86_avx2, cpu_supports_avx2 },
-    { 3, "lookup_unroll_4_x86_avx2_aligned", "x86_avx2", starch_magnitude_power_uc8_aligned_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
-    { 4, "twopass_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_twopass_x86_avx2, cpu_supports_avx2 },
-    { 5, "lookup_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_lookup_x86_avx2, cpu_supports_avx2 },
-    { 6, "lookup_unroll_4_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
-    { 7, "lookup_generic", "generic", starch_magnitude_power_uc8_lookup_generic, NULL },
-    { 8, "lookup_unroll_4_generic", "generic", starch_magnitude_power_uc8_lookup_unroll_4_generic, NULL },
+    { 0, "avx2_x86_avx2_aligned", "x86_avx2", starch_magnitude_power_uc8_aligned_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41_aligned", "x86_sse41", starch_magnitude_power_uc8_aligned_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "twopass_x86_avx2_aligned", "x86_avx2", starch_magnitude_power_uc8_aligned_twopass_x86_avx2, cpu_supports_avx2 },
+    { 3, "twopass_generic", "generic", starch_magnitude_power_uc8_twopass_generic, NULL },
+    { 4, "lookup_x86_avx2_aligned", "x86_avx2", starch_magnitude_power_uc8_aligned_lookup_x86_avx2, cpu_supports_avx2 },
+    { 5, "lookup_unroll_4_x86_avx2_aligned", "x86_avx2", starch_magnitude_power_uc8_aligned_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
+    { 6, "twopass_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_twopass_x86_avx2, cpu_supports_avx2 },
+    { 7, "lookup_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_lookup_x86_avx2, cpu_supports_avx2 },
+    { 8, "lookup_unroll_4_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
+    { 9, "avx2_x86_avx2", "x86_avx2", starch_magnitude_power_uc8_avx2_x86_avx2, cpu_supports_avx2 },
+    { 10, "twopass_x86_sse41_aligned", "x86_sse41", starch_magnitude_power_uc8_aligned_twopass_x86_sse41, cpu_supports_sse41 },
+    { 11, "lookup_x86_sse41_aligned", "x86_sse41", starch_magnitude_power_uc8_aligned_lookup_x86_sse41, cpu_supports_sse41 },
+    { 12, "lookup_unroll_4_x86_sse41_aligned", "x86_sse41", starch_magnitude_power_uc8_aligned_lookup_unroll_4_x86_sse41, cpu_supports_sse41 },
+    { 13, "twopass_x86_sse41", "x86_sse41", starch_magnitude_power_uc8_twopass_x86_sse41, cpu_supports_sse41 },
+    { 14, "lookup_x86_sse41", "x86_sse41", starch_magnitude_power_uc8_lookup_x86_sse41, cpu_supports_sse41 },
+    { 15, "lookup_unroll_4_x86_sse41", "x86_sse41", starch_magnitude_power_uc8_lookup_unroll_4_x86_sse41, cpu_supports_sse41 },
+    { 16, "sse41_x86_sse41", "x86_sse41", starch_magnitude_power_uc8_sse41_x86_sse41, cpu_supports_sse41 },
+    { 17, "lookup_generic", "generic", starch_magnitude_power_uc8_lookup_generic, NULL },
+    { 18, "lookup_unroll_4_generic", "generic", starch_magnitude_power_uc8_lookup_unroll_4_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -448,10 +472,14 @@ starch_magnitude_sc16_regentry starch_magnitude_sc16_registry[] = {
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "exact_float_x86_avx2", "x86_avx2", starch_magnitude_sc16_exact_float_x86_avx2, cpu_supports_avx2 },
-    { 1, "exact_float_generic", "generic", starch_magnitude_sc16_exact_float_generic, NULL },
-    { 2, "exact_u32_x86_avx2", "x86_avx2", starch_magnitude_sc16_exact_u32_x86_avx2, cpu_supports_avx2 },
-    { 3, "exact_u32_generic", "generic", starch_magnitude_sc16_exact_u32_generic, NULL },
+    { 0, "avx2_x86_avx2", "x86_avx2", starch_magnitude_sc16_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41", "x86_sse41", starch_magnitude_sc16_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "exact_float_x86_avx2", "x86_avx2", starch_magnitude_sc16_exact_float_x86_avx2, cpu_supports_avx2 },
+    { 3, "exact_float_generic", "generic", starch_magnitude_sc16_exact_float_generic, NULL },
+    { 4, "exact_u32_x86_avx2", "x86_avx2", starch_magnitude_sc16_exact_u32_x86_avx2, cpu_supports_avx2 },
+    { 5, "exact_u32_x86_sse41", "x86_sse41", starch_magnitude_sc16_exact_u32_x86_sse41, cpu_supports_sse41 },
+    { 6, "exact_float_x86_sse41", "x86_sse41", starch_magnitude_sc16_exact_float_x86_sse41, cpu_supports_sse41 },
+    { 7, "exact_u32_generic", "generic", starch_magnitude_sc16_exact_u32_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -538,12 +566,20 @@ starch_magnitude_sc16_aligned_regentry starch_magnitude_sc16_aligned_registry[]
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "exact_float_x86_avx2_aligned", "x86_avx2", starch_magnitude_sc16_aligned_exact_float_x86_avx2, cpu_supports_avx2 },
-    { 1, "exact_float_generic", "generic", starch_magnitude_sc16_exact_float_generic, NULL },
-    { 2, "exact_u32_x86_avx2_aligned", "x86_avx2", starch_magnitude_sc16_aligned_exact_u32_x86_avx2, cpu_supports_avx2 },
-    { 3, "exact_u32_x86_avx2", "x86_avx2", starch_magnitude_sc16_exact_u32_x86_avx2, cpu_supports_avx2 },
-    { 4, "exact_float_x86_avx2", "x86_avx2", starch_magnitude_sc16_exact_float_x86_avx2, cpu_supports_avx2 },
-    { 5, "exact_u32_generic", "generic", starch_magnitude_sc16_exact_u32_generic, NULL },
+    { 0, "avx2_x86_avx2_aligned", "x86_avx2", starch_magnitude_sc16_aligned_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41_aligned", "x86_sse41", starch_magnitude_sc16_aligned_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "exact_float_x86_avx2_aligned", "x86_avx2", starch_magnitude_sc16_aligned_exact_float_x86_avx2, cpu_supports_avx2 },
+    { 3, "exact_float_generic", "generic", starch_magnitude_sc16_exact_float_generic, NULL },
+    { 4, "exact_u32_x86_avx2_aligned", "x86_avx2", starch_magnitude_sc16_aligned_exact_u32_x86_avx2, cpu_supports_avx2 },
+    { 5, "exact_u32_x86_avx2", "x86_avx2", starch_magnitude_sc16_exact_u32_x86_avx2, cpu_supports_avx2 },
+    { 6, "exact_float_x86_avx2", "x86_avx2", starch_magnitude_sc16_exact_float_x86_avx2, cpu_supports_avx2 },
+    { 7, "avx2_x86_avx2", "x86_avx2", starch_magnitude_sc16_avx2_x86_avx2, cpu_supports_avx2 },
+    { 8, "exact_u32_x86_sse41_aligned", "x86_sse41", starch_magnitude_sc16_aligned_exact_u32_x86_sse41, cpu_supports_sse41 },
+    { 9, "exact_float_x86_sse41_aligned", "x86_sse41", starch_magnitude_sc16_aligned_exact_float_x86_sse41, cpu_supports_sse41 },
+    { 10, "exact_u32_x86_sse41", "x86_sse41", starch_magnitude_sc16_exact_u32_x86_sse41, cpu_supports_sse41 },
+    { 11, "exact_float_x86_sse41", "x86_sse41", starch_magnitude_sc16_exact_float_x86_sse41, cpu_supports_sse41 },
+    { 12, "sse41_x86_sse41", "x86_sse41", starch_magnitude_sc16_sse41_x86_sse41, cpu_supports_sse41 },
+    { 13, "exact_u32_generic", "generic", starch_magnitude_sc16_exact_u32_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -639,9 +675,13 @@ starch_magnitude_sc16q11_regentry starch_magnitude_sc16q11_registry[] = {
     { 2, "exact_u32_x86_avx2", "x86_avx2", starch_magnitude_sc16q11_exact_u32_x86_avx2, cpu_supports_avx2 },
     { 3, "11bit_table_x86_avx2", "x86_avx2", starch_magnitude_sc16q11_11bit_table_x86_avx2, cpu_supports_avx2 },
     { 4, "12bit_table_x86_avx2", "x86_avx2", starch_magnitude_sc16q11_12bit_table_x86_avx2, cpu_supports_avx2 },
-    { 5, "exact_u32_generic", "generic", starch_magnitude_sc16q11_exact_u32_generic, NULL },
-    { 6, "11bit_table_generic", "generic", starch_magnitude_sc16q11_11bit_table_generic, NULL },
-    { 7, "12bit_table_generic", "generic", starch_magnitude_sc16q11_12bit_table_generic, NULL },
+    { 5, "exact_u32_x86_sse41", "x86_sse41", starch_magnitude_sc16q11_exact_u32_x86_sse41, cpu_supports_sse41 },
+    { 6, "exact_float_x86_sse41", "x86_sse41", starch_magnitude_sc16q11_exact_float_x86_sse41, cpu_supports_sse41 },
+    { 7, "11bit_table_x86_sse41", "x86_sse41", starch_magnitude_sc16q11_11bit_table_x86_sse41, cpu_supports_sse41 },
+    { 8, "12bit_table_x86_sse41", "x86_sse41", starch_magnitude_sc16q11_12bit_table_x86_sse41, cpu_supports_sse41 },
+    { 9, "exact_u32_generic", "generic", starch_magnitude_sc16q11_exact_u32_generic, NULL },
+    { 10, "11bit_table_generic", "generic", starch_magnitude_sc16q11_11bit_table_generic, NULL },
+    { 11, "12bit_table_generic", "generic", starch_magnitude_sc16q11_12bit_table_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -751,9 +791,17 @@ starch_magnitude_sc16q11_aligned_regentry starch_magnitude_sc16q11_aligned_regis
     { 6, "exact_float_x86_avx2", "x86_avx2", starch_magnitude_sc16q11_exact_float_x86_avx2, cpu_supports_avx2 },
     { 7, "11bit_table_x86_avx2", "x86_avx2", starch_magnitude_sc16q11_11bit_table_x86_avx2, cpu_supports_avx2 },
     { 8, "12bit_table_x86_avx2", "x86_avx2", starch_magnitude_sc16q11_12bit_table_x86_avx2, cpu_supports_avx2 },
-    { 9, "exact_u32_generic", "generic", starch_magnitude_sc16q11_exact_u32_generic, NULL },
-    { 10, "11bit_table_generic", "generic", starch_magnitude_sc16q11_11bit_table_generic, NULL },
-    { 11, "12bit_table_generic", "generic", starch_magnitude_sc16q11_12bit_table_generic, NULL },
+    { 9, "exact_u32_x86_sse41_aligned", "x86_sse41", starch_magnitude_sc16q11_aligned_exact_u32_x86_sse41, cpu_supports_sse41 },
+    { 10, "exact_float_x86_sse41_aligned", "x86_sse41", starch_magnitude_sc16q11_aligned_exact_float_x86_sse41, cpu_supports_sse41 },
+    { 11, "11bit_table_x86_sse41_aligned", "x86_sse41", starch_magnitude_sc16q11_aligned_11bit_table_x86_sse41, cpu_supports_sse41 },
+    { 12, "12bit_table_x86_sse41_aligned", "x86_sse41", starch_magnitude_sc16q11_aligned_12bit_table_x86_sse41, cpu_supports_sse41 },
+    { 13, "exact_u32_x86_sse41", "x86_sse41", starch_magnitude_sc16q11_exact_u32_x86_sse41, cpu_supports_sse41 },
+    { 14, "exact_float_x86_sse41", "x86_sse41", starch_magnitude_sc16q11_exact_float_x86_sse41, cpu_supports_sse41 },
+    { 15, "11bit_table_x86_sse41", "x86_sse41", starch_magnitude_sc16q11_11bit_table_x86_sse41, cpu_supports_sse41 },
+    { 16, "12bit_table_x86_sse41", "x86_sse41", starch_magnitude_sc16q11_12bit_table_x86_sse41, cpu_supports_sse41 },
+    { 17, "exact_u32_generic", "generic", starch_magnitude_sc16q11_exact_u32_generic, NULL },
+    { 18, "11bit_table_generic", "generic", starch_magnitude_sc16q11_11bit_table_generic, NULL },
+    { 19, "12bit_table_generic", "generic", starch_magnitude_sc16q11_12bit_table_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -839,12 +887,17 @@ starch_magnitude_uc8_regentry starch_magnitude_uc8_registry[] = {
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "lookup_unroll_4_x86_avx2", "x86_avx2", starch_magnitude_uc8_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
-    { 1, "lookup_unroll_4_generic", "generic", starch_magnitude_uc8_lookup_unroll_4_generic, NULL },
-    { 2, "lookup_x86_avx2", "x86_avx2", starch_magnitude_uc8_lookup_x86_avx2, cpu_supports_avx2 },
-    { 3, "exact_x86_avx2", "x86_avx2", starch_magnitude_uc8_exact_x86_avx2, cpu_supports_avx2 },
-    { 4, "lookup_generic", "generic", starch_magnitude_uc8_lookup_generic, NULL },
-    { 5, "exact_generic", "generic", starch_magnitude_uc8_exact_generic, NULL },
+    { 0, "avx2_x86_avx2", "x86_avx2", starch_magnitude_uc8_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41", "x86_sse41", starch_magnitude_uc8_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "lookup_unroll_4_x86_avx2", "x86_avx2", starch_magnitude_uc8_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
+    { 3, "lookup_unroll_4_generic", "generic", starch_magnitude_uc8_lookup_unroll_4_generic, NULL },
+    { 4, "lookup_x86_avx2", "x86_avx2", starch_magnitude_uc8_lookup_x86_avx2, cpu_supports_avx2 },
+    { 5, "exact_x86_avx2", "x86_avx2", starch_magnitude_uc8_exact_x86_avx2, cpu_supports_avx2 },
+    { 6, "lookup_x86_sse41", "x86_sse41", starch_magnitude_uc8_lookup_x86_sse41, cpu_supports_sse41 },
+    { 7, "lookup_unroll_4_x86_sse41", "x86_sse41", starch_magnitude_uc8_lookup_unroll_4_x86_sse41, cpu_supports_sse41 },
+    { 8, "exact_x86_sse41", "x86_sse41", starch_magnitude_uc8_exact_x86_sse41, cpu_supports_sse41 },
+    { 9, "lookup_generic", "generic", starch_magnitude_uc8_lookup_generic, NULL },
+    { 10, "exact_generic", "generic", starch_magnitude_uc8_exact_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -938,15 +991,25 @@ starch_magnitude_uc8_aligned_regentry starch_magnitude_uc8_aligned_registry[] =
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "lookup_unroll_4_x86_avx2", "x86_avx2", starch_magnitude_uc8_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
-    { 1, "lookup_unroll_4_generic", "generic", starch_magnitude_uc8_lookup_unroll_4_generic, NULL },
-    { 2, "lookup_x86_avx2_aligned", "x86_avx2", starch_magnitude_uc8_aligned_lookup_x86_avx2, cpu_supports_avx2 },
-    { 3, "lookup_unroll_4_x86_avx2_aligned", "x86_avx2", starch_magnitude_uc8_aligned_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
-    { 4, "exact_x86_avx2_aligned", "x86_avx2", starch_magnitude_uc8_aligned_exact_x86_avx2, cpu_supports_avx2 },
-    { 5, "lookup_x86_avx2", "x86_avx2", starch_magnitude_uc8_lookup_x86_avx2, cpu_supports_avx2 },
-    { 6, "exact_x86_avx2", "x86_avx2", starch_magnitude_uc8_exact_x86_avx2, cpu_supports_avx2 },
-    { 7, "lookup_generic", "generic", starch_magnitude_uc8_lookup_generic, NULL },
-    { 8, "exact_generic", "generic", starch_magnitude_uc8_exact_generic, NULL },
+    { 0, "avx2_x86_avx2_aligned", "x86_avx2", starch_magnitude_uc8_aligned_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41_aligned", "x86_sse41", starch_magnitude_uc8_aligned_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "lookup_unroll_4_x86_avx2", "x86_avx2", starch_magnitude_uc8_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
+    { 3, "lookup_unroll_4_generic", "generic", starch_magnitude_uc8_lookup_unroll_4_generic, NULL },
+    { 4, "lookup_x86_avx2_aligned", "x86_avx2", starch_magnitude_uc8_aligned_lookup_x86_avx2, cpu_supports_avx2 },
+    { 5, "lookup_unroll_4_x86_avx2_aligned", "x86_avx2", starch_magnitude_uc8_aligned_lookup_unroll_4_x86_avx2, cpu_supports_avx2 },
+    { 6, "exact_x86_avx2_aligned", "x86_avx2", starch_magnitude_uc8_aligned_exact_x86_avx2, cpu_supports_avx2 },
+    { 7, "lookup_x86_avx2", "x86_avx2", starch_magnitude_uc8_lookup_x86_avx2, cpu_supports_avx2 },
+    { 8, "exact_x86_avx2", "x86_avx2", starch_magnitude_uc8_exact_x86_avx2, cpu_supports_avx2 },
+    { 9, "avx2_x86_avx2", "x86_avx2", starch_magnitude_uc8_avx2_x86_avx2, cpu_supports_avx2 },
+    { 10, "lookup_x86_sse41_aligned", "x86_sse41", starch_magnitude_uc8_aligned_lookup_x86_sse41, cpu_supports_sse41 },
+    { 11, "lookup_unroll_4_x86_sse41_aligned", "x86_sse41", starch_magnitude_uc8_aligned_lookup_unroll_4_x86_sse41, cpu_supports_sse41 },
+    { 12, "exact_x86_sse41_aligned", "x86_sse41", starch_magnitude_uc8_aligned_exact_x86_sse41, cpu_supports_sse41 },
+    { 13, "lookup_x86_sse41", "x86_sse41", starch_magnitude_uc8_lookup_x86_sse41, cpu_supports_sse41 },
+    { 14, "lookup_unroll_4_x86_sse41", "x86_sse41", starch_magnitude_uc8_lookup_unroll_4_x86_sse41, cpu_supports_sse41 },
+    { 15, "exact_x86_sse41", "x86_sse41", starch_magnitude_uc8_exact_x86_sse41, cpu_supports_sse41 },
+    { 16, "sse41_x86_sse41", "x86_sse41", starch_magnitude_uc8_sse41_x86_sse41, cpu_supports_sse41 },
+    { 17, "lookup_generic", "generic", starch_magnitude_uc8_lookup_generic, NULL },
+    { 18, "exact_generic", "generic", starch_magnitude_uc8_exact_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -1032,12 +1095,17 @@ starch_mean_power_u16_regentry starch_mean_power_u16_registry[] = {
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "u32_x86_avx2", "x86_avx2", starch_mean_power_u16_u32_x86_avx2, cpu_supports_avx2 },
-    { 1, "u32_generic", "generic", starch_mean_power_u16_u32_generic, NULL },
-    { 2, "float_x86_avx2", "x86_avx2", starch_mean_power_u16_float_x86_avx2, cpu_supports_avx2 },
-    { 3, "u64_x86_avx2", "x86_avx2", starch_mean_power_u16_u64_x86_avx2, cpu_supports_avx2 },
-    { 4, "float_generic", "generic", starch_mean_power_u16_float_generic, NULL },
-    { 5, "u64_generic", "generic", starch_mean_power_u16_u64_generic, NULL },
+    { 0, "avx2_x86_avx2", "x86_avx2", starch_mean_power_u16_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41", "x86_sse41", starch_mean_power_u16_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "u32_x86_avx2", "x86_avx2", starch_mean_power_u16_u32_x86_avx2, cpu_supports_avx2 },
+    { 3, "u32_generic", "generic", starch_mean_power_u16_u32_generic, NULL },
+    { 4, "float_x86_avx2", "x86_avx2", starch_mean_power_u16_float_x86_avx2, cpu_supports_avx2 },
+    { 5, "u64_x86_avx2", "x86_avx2", starch_mean_power_u16_u64_x86_avx2, cpu_supports_avx2 },
+    { 6, "float_x86_sse41", "x86_sse41", starch_mean_power_u16_float_x86_sse41, cpu_supports_sse41 },
+    { 7, "u32_x86_sse41", "x86_sse41", starch_mean_power_u16_u32_x86_sse41, cpu_supports_sse41 },
+    { 8, "u64_x86_sse41", "x86_sse41", starch_mean_power_u16_u64_x86_sse41, cpu_supports_sse41 },
+    { 9, "float_generic", "generic", starch_mean_power_u16_float_generic, NULL },
+    { 10, "u64_generic", "generic", starch_mean_power_u16_u64_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -1131,15 +1199,25 @@ starch_mean_power_u16_aligned_regentry starch_mean_power_u16_aligned_registry[]
 #endif /* STARCH_MIX_GENERIC */
   
 #ifdef STARCH_MIX_X86
-    { 0, "u32_x86_avx2_aligned", "x86_avx2", starch_mean_power_u16_aligned_u32_x86_avx2, cpu_supports_avx2 },
-    { 1, "u32_generic", "generic", starch_mean_power_u16_u32_generic, NULL },
-    { 2, "float_x86_avx2_aligned", "x86_avx2", starch_mean_power_u16_aligned_float_x86_avx2, cpu_supports_avx2 },
-    { 3, "u64_x86_avx2_aligned", "x86_avx2", starch_mean_power_u16_aligned_u64_x86_avx2, cpu_supports_avx2 },
-    { 4, "float_x86_avx2", "x86_avx2", starch_mean_power_u16_float_x86_avx2, cpu_supports_avx2 },
-    { 5, "u32_x86_avx2", "x86_avx2", starch_mean_power_u16_u32_x86_avx2, cpu_supports_avx2 },
-    { 6, "u64_x86_avx2", "x86_avx2", starch_mean_power_u16_u64_x86_avx2, cpu_supports_avx2 },
-    { 7, "float_generic", "generic", starch_mean_power_u16_float_generic, NULL },
-    { 8, "u64_generic", "generic", starch_mean_power_u16_u64_generic, NULL },
+    { 0, "avx2_x86_avx2_aligned", "x86_avx2", starch_mean_power_u16_aligned_avx2_x86_avx2, cpu_supports_avx2 },
+    { 1, "sse41_x86_sse41_aligned", "x86_sse41", starch_mean_power_u16_aligned_sse41_x86_sse41, cpu_supports_sse41 },
+    { 2, "u32_x86_avx2_aligned", "x86_avx2", starch_mean_power_u16_aligned_u32_x86_avx2, cpu_supports_avx2 },
+    { 3, "u32_generic", "generic", starch_mean_power_u16_u32_generic, NULL },
+    { 4, "float_x86_avx2_aligned", "x86_avx2", starch_mean_power_u16_aligned_float_x86_avx2, cpu_supports_avx2 },
+    { 5, "u64_x86_avx2_aligned", "x86_avx2", starch_mean_power_u16_aligned_u64_x86_avx2, cpu_supports_avx2 },
+    { 6, "float_x86_avx2", "x86_avx2", starch_mean_power_u16_float_x86_avx2, cpu_supports_avx2 },
+    { 7, "u32_x86_avx2", "x86_avx2", starch_mean_power_u16_u32_x86_avx2, cpu_supports_avx2 },
+    { 8, "u64_x86_avx2", "x86_avx2", starch_mean_power_u16_u64_x86_avx2, cpu_supports_avx2 },
+    { 9, "avx2_x86_avx2", "x86_avx2", starch_mean_power_u16_avx2_x86_avx2, cpu_supports_avx2 },
+    { 10, "float_x86_sse41_aligned", "x86_sse41", starch_mean_power_u16_aligned_float_x86_sse41, cpu_supports_sse41 },
+    { 11, "u32_x86_sse41_aligned", "x86_sse41", starch_mean_power_u16_aligned_u32_x86_sse41, cpu_supports_sse41 },
+    { 12, "u64_x86_sse41_aligned", "x86_sse41", starch_mean_power_u16_aligned_u64_x86_sse41, cpu_supports_sse41 },
+    { 13, "float_x86_sse41", "x86_sse41", starch_mean_power_u16_float_x86_sse41, cpu_supports_sse41 },
+    { 14, "u32_x86_sse41", "x86_sse41", starch_mean_power_u16_u32_x86_sse41, cpu_supports_sse41 },
+    { 15, "u64_x86_sse41", "x86_sse41", starch_mean_power_u16_u64_x86_sse41, cpu_supports_sse41 },
+    { 16, "sse41_x86_sse41", "x86_sse41", starch_mean_power_u16_sse41_x86_sse41, cpu_supports_sse41 },
+    { 17, "float_generic", "generic", starch_mean_power_u16_float_generic, NULL },
+    { 18, "u64_generic", "generic", starch_mean_power_u16_u64_generic, NULL },
 #endif /* STARCH_MIX_X86 */
     { 0, NULL, NULL, NULL, NULL }
 };
@@ -0,0 +1,45 @@
+#if defined(RASPBERRY_PI)
+
+/* starch generated code. Do not edit. */
+
+#define STARCH_FLAVOR_X86_AVX2
+#define STARCH_FEATURE_AVX2
+
+#include "starch.h"
+
+#undef STARCH_ALIGNMENT
+
+#define STARCH_ALIGNMENT 1
+#define STARCH_ALIGNED(_ptr) (_ptr)
+#define STARCH_SYMBOL(_name) starch_ ## _name ## _ ## x86_avx2
+#define STARCH_IMPL(_function,_impl) starch_ ## _function ## _ ## _impl ## _ ## x86_avx2
+#define STARCH_IMPL_REQUIRES(_function,_impl,_feature) STARCH_IMPL(_function,_impl)
+
+#include "impl/count_above_u16.c"
+#include "impl/magnitude_power_uc8.c"
+#include "impl/magnitude_sc16.c"
+#include "impl/magnitude_sc16q11.c"
+#include "impl/magnitude_uc8.c"
+#include "impl/mean_power_u16.c"
+
+
+#undef STARCH_ALIGNMENT
+#undef STARCH_ALIGNED
+#undef STARCH_SYMBOL
+#undef STARCH_IMPL
+#undef STARCH_IMPL_REQUIRES
+
+#define STARCH_ALIGNMENT STARCH_MIX_ALIGNMENT
+#define STARCH_ALIGNED(_ptr) (__builtin_assume_aligned((_ptr), STARCH_MIX_ALIGNMENT))
+#define STARCH_SYMBOL(_name) starch_ ## _name ## _aligned_ ## x86_avx2
+#define STARCH_IMPL(_function,_impl) starch_ ## _function ## _aligned_ ## _impl ## _ ## x86_avx2
+#define STARCH_IMPL_REQUIRES(_function,_impl,_feature) STARCH_IMPL(_function,_impl)
+
+#include "impl/count_above_u16.c"
+#include "impl/magnitude_power_uc8.c"
+#include "impl/magnitude_sc16.c"
+#include "impl/magnitude_sc16q11.c"
+#include "impl/magnitude_uc8.c"
+#include "impl/mean_power_u16.c"
+
+#endif /* RASPBERRY_PI */
@@ -59,4 +59,100 @@ void STARCH_IMPL_REQUIRES(count_above_u16, neon, STARCH_FEATURE_NEON) (const uin
 
 #endif
 
+#ifdef STARCH_FEATURE_SSE41
+
+#include <smmintrin.h>
+
+void STARCH_IMPL_REQUIRES(count_above_u16, sse41, STARCH_FEATURE_SSE41) (const uint16_t *in, unsigned len, uint16_t threshold, unsigned *out_count)
+{
+    const uint16_t * restrict in_align = STARCH_ALIGNED(in);
+    const __m128i threshold_x8 = _mm_set1_epi16(threshold);
+    const __m128i ones = _mm_set1_epi16(1);
+
+    __m128i accumulator = _mm_setzero_si128();
+
+    unsigned len8 = len >> 3;
+    while (len8) {
+        // 16-bit lane counters are folded into 32 bits before they can overflow
+        unsigned block = (len8 > 32767 ? 32767 : len8);
+        len8 -= block;
+
+        __m128i count16 = _mm_setzero_si128();
+        while (block--) {
+            __m128i mag = _mm_loadu_si128((const __m128i *) in_align);
+            // unsigned mag >= threshold <=> max(mag, threshold) == mag
+            __m128i compare = _mm_cmpeq_epi16(_mm_max_epu16(mag, threshold_x8), mag);
+            count16 = _mm_sub_epi16(count16, compare);
+
+            in_align += 8;
+        }
+
+        accumulator = _mm_add_epi32(accumulator, _mm_madd_epi16(count16, ones));
+    }
+
+    // sum accumulator across all lanes
+    accumulator = _mm_add_epi32(accumulator, _mm_srli_si128(accumulator, 8));
+    accumulator = _mm_add_epi32(accumulator, _mm_srli_si128(accumulator, 4));
+    unsigned count = _mm_cvtsi128_si32(accumulator);
+
+    unsigned len1 = len & 7;
+    while (len1--) {
+        if (in_align[0] >= threshold)
+            ++count;
+        ++in_align;
+    }
+
+    *out_count = count;
+}
+
+#endif /* STARCH_FEATURE_SSE41 */
+
+#ifdef STARCH_FEATURE_AVX2
+
+#include <immintrin.h>
+
+void STARCH_IMPL_REQUIRES(count_above_u16, avx2, STARCH_FEATURE_AVX2) (const uint16_t *in, unsigned len, uint16_t threshold, unsigned *out_count)
+{
+    const uint16_t * restrict in_align = STARCH_ALIGNED(in);
+    const __m256i threshold_x16 = _mm256_set1_epi16(threshold);
+    const __m256i ones = _mm256_set1_epi16(1);
+
+    __m256i accumulator = _mm256_setzero_si256();
+
+    unsigned len16 = len >> 4;
+    while (len16) {
+        // 16-bit lane counters are folded into 32 bits before they can overflow
+        unsigned block = (len16 > 32767 ? 32767 : len16);
+        len16 -= block;
+
+        __m256i count16 = _mm256_setzero_si256();
+        while (block--) {
+            __m256i mag = _mm256_loadu_si256((const __m256i *) in_align);
+            __m256i compare = _mm256_cmpeq_epi16(_mm256_max_epu16(mag, threshold_x16), mag);
+            count16 = _mm256_sub_epi16(count16, compare);
+
+            in_align += 16;
+        }
+
+        accumulator = _mm256_add_epi32(accumulator, _mm256_madd_epi16(count16, ones));
+    }
+
+    // sum accumulator across all lanes
+    __m128i sum = _mm_add_epi32(_mm256_castsi256_si128(accumulator), _mm256_extracti128_si256(accumulator, 1));
+    sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 8));
+    sum = _mm_add_epi32(sum, _mm_srli_si128(sum, 4));
+    unsigned count = _mm_cvtsi128_si32(sum);
+
+    unsigned len1 = len & 15;
+    while (len1--) {
+        if (in_align[0] >= threshold)
+            ++count;
+        ++in_align;
+    }
+
+    *out_count = count;
+}
+
+#endif /* STARCH_FEATURE_AVX2 */
+
 #endif /* RASPBERRY_PI */
@@ -102,4 +102,113 @@ void STARCH_IMPL_REQUIRES(magnitude_sc16, neon_vrsqrte, STARCH_FEATURE_NEON) (co
 
 #endif /* STARCH_FEATURE_NEON */
 
+#ifdef STARCH_FEATURE_SSE41
+
+#include <smmintrin.h>
+
+void STARCH_IMPL_REQUIRES(magnitude_sc16, sse41, STARCH_FEATURE_SSE41) (const sc16_t *in, uint16_t *out, unsigned len)
+{
+    const int16_t * restrict in_align = (const int16_t *) STARCH_ALIGNED(in);
+    uint16_t * restrict out_align = STARCH_ALIGNED(out);
+
+    const __m128i low_word = _mm_set1_epi32(0x0000FFFF);
+    const __m128 limit = _mm_set1_ps(65535.0f);
+
+    unsigned len8 = len >> 3;
+    while (len8--) {
+        // |I| and |Q| fit 16 bits unsigned, including |-32768|
+        __m128i iq_0 = _mm_abs_epi16(_mm_loadu_si128((const __m128i *) in_align));
+        __m128i iq_1 = _mm_abs_epi16(_mm_loadu_si128((const __m128i *) (in_align + 8)));
+
+        // samples 0..3
+        __m128 i_0 = _mm_cvtepi32_ps(_mm_slli_epi32(_mm_and_si128(iq_0, low_word), 1));
+        __m128 q_0 = _mm_cvtepi32_ps(_mm_slli_epi32(_mm_srli_epi32(iq_0, 16), 1));
+        __m128 mag_0 = _mm_min_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(i_0, i_0), _mm_mul_ps(q_0, q_0))), limit);
+
+        // samples 4..7
+        __m128 i_1 = _mm_cvtepi32_ps(_mm_slli_epi32(_mm_and_si128(iq_1, low_word), 1));
+        __m128 q_1 = _mm_cvtepi32_ps(_mm_slli_epi32(_mm_srli_epi32(iq_1, 16), 1));
+        __m128 mag_1 = _mm_min_ps(_mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(i_1, i_1), _mm_mul_ps(q_1, q_1))), limit);
+
+        // truncate, narrow and store
+        __m128i result = _mm_packus_epi32(_mm_cvttps_epi32(mag_0), _mm_cvttps_epi32(mag_1));
+        _mm_storeu_si128((__m128i *) out_align, result);
+
+        in_align += 16;
+        out_align += 8;
+    }
+
+    unsigned len1 = len & 7;
+    while (len1--) {
+        float I = abs((int16_t) le16toh(in_align[0])) * 2;
+        float Q = abs((int16_t) le16toh(in_align[1])) * 2;
+
+        float magsq = I * I + Q * Q;
+        float mag = sqrtf(magsq);
+        if (mag > 65535.0)
+            mag = 65535.0;
+        out_align[0] = (uint16_t)mag;
+
+        out_align += 1;
+        in_align += 2;
+    }
+}
+
+#endif /* STARCH_FEATURE_SSE41 */
+
+#ifdef STARCH_FEATURE_AVX2
+
+#include <immintrin.h>
+
+void STARCH_IMPL_REQUIRES(magnitude_sc16, avx2, STARCH_FEATURE_AVX2) (const sc16_t *in, uint16_t *out, unsigned len)
+{
+    const int16_t * restrict in_align = (const int16_t *) STARCH_ALIGNED(in);
+    uint16_t * restrict out_align = STARCH_ALIGNED(out);
+
+    const __m256i low_word = _mm256_set1_epi32(0x0000FFFF);
+    const __m256 limit = _mm256_set1_ps(65535.0f);
+
+    unsigned len16 = len >> 4;
+    while (len16--) {
+        // |I| and |Q| fit 16 bits unsigned, including |-32768|
+        __m256i iq_0 = _mm256_abs_epi16(_mm256_loadu_si256((const __m256i *) in_align));
+        __m256i iq_1 = _mm256_abs_epi16(_mm256_loadu_si256((const __m256i *) (in_align + 16)));
+
+        // samples 0..7
+        __m256 i_0 = _mm256_cvtepi32_ps(_mm256_slli_epi32(_mm256_and_si256(iq_0, low_word), 1));
+        __m256 q_0 = _mm256_cvtepi32_ps(_mm256_slli_epi32(_mm256_srli_epi32(iq_0, 16), 1));
+        __m256 mag_0 = _mm256_min_ps(_mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(i_0, i_0), _mm256_mul_ps(q_0, q_0))), limit);
+
+        // samples 8..15
+        __m256 i_1 = _mm256_cvtepi32_ps(_mm256_slli_epi32(_mm256_and_si256(iq_1, low_word), 1));
+        __m256 q_1 = _mm256_cvtepi32_ps(_mm256_slli_epi32(_mm256_srli_epi32(iq_1, 16), 1));
+        __m256 mag_1 = _mm256_min_ps(_mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(i_1, i_1), _mm256_mul_ps(q_1, q_1))), limit);
+
+        // truncate and narrow; packus works per 128-bit lane, so restore sample order afterwards
+        __m256i result = _mm256_packus_epi32(_mm256_cvttps_epi32(mag_0), _mm256_cvttps_epi32(mag_1));
+        result = _mm256_permute4x64_epi64(result, 0xD8);
+        _mm256_storeu_si256((__m256i *) out_align, result);
+
+        in_align += 32;
+        out_align += 16;
+    }
+
+    unsigned len1 = len & 15;
+    while (len1--) {
+        float I = abs((int16_t) le16toh(in_align[0])) * 2;
+        float Q = abs((int16_t) le16toh(in_align[1])) * 2;
+
+        float magsq = I * I + Q * Q;
+        float mag = sqrtf(magsq);
+        if (mag > 65535.0)
+            mag = 65535.0;
+        out_align[0] = (uint16_t)mag;
+
+        out_align += 1;
+        in_align += 2;
+    }
+}
+
+#endif /* STARCH_FEATURE_AVX2 */
+
 #endif /* RASPBERRY_PI */
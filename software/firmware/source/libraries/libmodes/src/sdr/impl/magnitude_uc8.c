@@ -166,4 +166,127 @@ void STARCH_IMPL_REQUIRES(magnitude_uc8, neon_vrsqrte, STARCH_FEATURE_NEON) (con
 
 #endif /* STARCH_FEATURE_NEON */
 
+#ifdef STARCH_FEATURE_SSE41
+
+#include <smmintrin.h>
+
+void STARCH_IMPL_REQUIRES(magnitude_uc8, sse41, STARCH_FEATURE_SSE41) (const uc8_t *in, uint16_t *out, unsigned len)
+{
+    const uint8_t * restrict in_align = (const uint8_t *) STARCH_ALIGNED(in);
+    uint16_t * restrict out_align = STARCH_ALIGNED(out);
+
+    const __m128i low_byte = _mm_set1_epi16(0x00FF);
+    const __m128 offset = _mm_set1_ps(127.4f);
+    const __m128 scale = _mm_set1_ps(65536.0f / 128.0f);
+    const __m128 limit = _mm_set1_ps(65535.0f);
+
+    unsigned len8 = len >> 3;
+    while (len8--) {
+        __m128i iq = _mm_loadu_si128((const __m128i *) in_align);
+
+        // deinterleave, I is the low byte and Q is the high byte of each 16-bit lane
+        __m128i i_u16 = _mm_and_si128(iq, low_byte);
+        __m128i q_u16 = _mm_srli_epi16(iq, 8);
+
+        // low half
+        __m128 i_low = _mm_sub_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(i_u16)), offset);
+        __m128 q_low = _mm_sub_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(q_u16)), offset);
+        __m128 magsq_low = _mm_add_ps(_mm_mul_ps(i_low, i_low), _mm_mul_ps(q_low, q_low));
+        __m128 mag_low = _mm_min_ps(_mm_mul_ps(_mm_sqrt_ps(magsq_low), scale), limit);
+
+        // high half
+        __m128 i_high = _mm_sub_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_srli_si128(i_u16, 8))), offset);
+        __m128 q_high = _mm_sub_ps(_mm_cvtepi32_ps(_mm_cvtepu16_epi32(_mm_srli_si128(q_u16, 8))), offset);
+        __m128 magsq_high = _mm_add_ps(_mm_mul_ps(i_high, i_high), _mm_mul_ps(q_high, q_high));
+        __m128 mag_high = _mm_min_ps(_mm_mul_ps(_mm_sqrt_ps(magsq_high), scale), limit);
+
+        // truncate, narrow and store
+        __m128i result = _mm_packus_epi32(_mm_cvttps_epi32(mag_low), _mm_cvttps_epi32(mag_high));
+        _mm_storeu_si128((__m128i *) out_align, result);
+
+        in_align += 16;
+        out_align += 8;
+    }
+
+    unsigned len1 = len & 7;
+    while (len1--) {
+        float I = (in_align[0] - 127.4);
+        float Q = (in_align[1] - 127.4);
+
+        float magsq = I * I + Q * Q;
+        float mag = sqrtf(magsq) * 65536.0 / 128.0;
+        if (mag > 65535.0)
+            mag = 65535.0;
+
+        out_align[0] = (uint16_t)mag;
+
+        in_align += 2;
+        out_align += 1;
+    }
+}
+
+#endif /* STARCH_FEATURE_SSE41 */
+
+#ifdef STARCH_FEATURE_AVX2
+
+#include <immintrin.h>
+
+void STARCH_IMPL_REQUIRES(magnitude_uc8, avx2, STARCH_FEATURE_AVX2) (const uc8_t *in, uint16_t *out, unsigned len)
+{
+    const uint8_t * restrict in_align = (const uint8_t *) STARCH_ALIGNED(in);
+    uint16_t * restrict out_align = STARCH_ALIGNED(out);
+
+    const __m256i low_byte = _mm256_set1_epi16(0x00FF);
+    const __m256 offset = _mm256_set1_ps(127.4f);
+    const __m256 scale = _mm256_set1_ps(65536.0f / 128.0f);
+    const __m256 limit = _mm256_set1_ps(65535.0f);
+
+    unsigned len16 = len >> 4;
+    while (len16--) {
+        __m256i iq = _mm256_loadu_si256((const __m256i *) in_align);
+
+        // deinterleave, I is the low byte and Q is the high byte of each 16-bit lane
+        __m256i i_u16 = _mm256_and_si256(iq, low_byte);
+        __m256i q_u16 = _mm256_srli_epi16(iq, 8);
+
+        // samples 0..7
+        __m256 i_low = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(i_u16))), offset);
+        __m256 q_low = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_castsi256_si128(q_u16))), offset);
+        __m256 magsq_low = _mm256_add_ps(_mm256_mul_ps(i_low, i_low), _mm256_mul_ps(q_low, q_low));
+        __m256 mag_low = _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(magsq_low), scale), limit);
+
+        // samples 8..15
+        __m256 i_high = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(i_u16, 1))), offset);
+        __m256 q_high = _mm256_sub_ps(_mm256_cvtepi32_ps(_mm256_cvtepu16_epi32(_mm256_extracti128_si256(q_u16, 1))), offset);
+        __m256 magsq_high = _mm256_add_ps(_mm256_mul_ps(i_high, i_high), _mm256_mul_ps(q_high, q_high));
+        __m256 mag_high = _mm256_min_ps(_mm256_mul_ps(_mm256_sqrt_ps(magsq_high), scale), limit);
+
+        // truncate and narrow; packus works per 128-bit lane, so restore sample order afterwards
+        __m256i result = _mm256_packus_epi32(_mm256_cvttps_epi32(mag_low), _mm256_cvttps_epi32(mag_high));
+        result = _mm256_permute4x64_epi64(result, 0xD8);
+        _mm256_storeu_si256((__m256i *) out_align, result);
+
+        in_align += 32;
+        out_align += 16;
+    }
+
+    unsigned len1 = len & 15;
+    while (len1--) {
+        float I = (in_align[0] - 127.4);
+        float Q = (in_align[1] - 127.4);
+
+        float magsq = I * I + Q * Q;
+        float mag = sqrtf(magsq) * 65536.0 / 128.0;
+        if (mag > 65535.0)
+            mag = 65535.0;
+
+        out_align[0] = (uint16_t)mag;
+
+        in_align += 2;
+        out_align += 1;
+    }
+}
+
+#endif /* STARCH_FEATURE_AVX2 */
+
 #endif /* RASPBERRY_PI */
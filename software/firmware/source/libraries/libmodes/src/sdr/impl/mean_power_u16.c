@@ -123,4 +123,122 @@ void STARCH_IMPL_REQUIRES(mean_power_u16, neon_float, STARCH_FEATURE_NEON) (cons
 
 #endif /* STARCH_FEATURE_NEON */
 
+#ifdef STARCH_FEATURE_SSE41
+
+#include <smmintrin.h>
+
+void STARCH_IMPL_REQUIRES(mean_power_u16, sse41, STARCH_FEATURE_SSE41) (const uint16_t *in, unsigned len, double *out_mean_mag, double *out_mean_magsq)
+{
+    const uint16_t * restrict in_align = STARCH_ALIGNED(in);
+
+    __m128i mag_sum_64 = _mm_setzero_si128();
+    __m128i magsq_sum_64 = _mm_setzero_si128();
+
+    unsigned len8 = len >> 3;
+    while (len8) {
+        // 32-bit lane sums are folded into 64 bits before they can overflow
+        unsigned block = (len8 > 16384 ? 16384 : len8);
+        len8 -= block;
+
+        __m128i mag_sum_32 = _mm_setzero_si128();
+        while (block--) {
+            __m128i mag_u16 = _mm_loadu_si128((const __m128i *) in_align);
+            __m128i mag_0 = _mm_cvtepu16_epi32(mag_u16);
+            __m128i mag_1 = _mm_cvtepu16_epi32(_mm_srli_si128(mag_u16, 8));
+
+            mag_sum_32 = _mm_add_epi32(mag_sum_32, _mm_add_epi32(mag_0, mag_1));
+
+            // squares are up to 32 bits wide, accumulate even and odd lanes as 64 bits
+            magsq_sum_64 = _mm_add_epi64(magsq_sum_64, _mm_mul_epu32(mag_0, mag_0));
+            magsq_sum_64 = _mm_add_epi64(magsq_sum_64, _mm_mul_epu32(mag_1, mag_1));
+            mag_0 = _mm_srli_epi64(mag_0, 32);
+            mag_1 = _mm_srli_epi64(mag_1, 32);
+            magsq_sum_64 = _mm_add_epi64(magsq_sum_64, _mm_mul_epu32(mag_0, mag_0));
+            magsq_sum_64 = _mm_add_epi64(magsq_sum_64, _mm_mul_epu32(mag_1, mag_1));
+
+            in_align += 8;
+        }
+
+        mag_sum_64 = _mm_add_epi64(mag_sum_64, _mm_cvtepu32_epi64(mag_sum_32));
+        mag_sum_64 = _mm_add_epi64(mag_sum_64, _mm_cvtepu32_epi64(_mm_srli_si128(mag_sum_32, 8)));
+    }
+
+    uint64_t sum = (uint64_t) _mm_cvtsi128_si64(mag_sum_64) + (uint64_t) _mm_extract_epi64(mag_sum_64, 1);
+    uint64_t sumsq = (uint64_t) _mm_cvtsi128_si64(magsq_sum_64) + (uint64_t) _mm_extract_epi64(magsq_sum_64, 1);
+
+    unsigned len1 = len & 7;
+    while (len1--) {
+        uint16_t mag = in_align[0];
+        sum += mag;
+        sumsq += (uint32_t)mag * mag;
+        in_align += 1;
+    }
+
+    *out_mean_mag = (double)sum / len / 65536.0;
+    *out_mean_magsq = (double)sumsq / len / 65536.0 / 65536.0;
+}
+
+#endif /* STARCH_FEATURE_SSE41 */
+
+#ifdef STARCH_FEATURE_AVX2
+
+#include <immintrin.h>
+
+void STARCH_IMPL_REQUIRES(mean_power_u16, avx2, STARCH_FEATURE_AVX2) (const uint16_t *in, unsigned len, double *out_mean_mag, double *out_mean_magsq)
+{
+    const uint16_t * restrict in_align = STARCH_ALIGNED(in);
+
+    __m256i mag_sum_64 = _mm256_setzero_si256();
+    __m256i magsq_sum_64 = _mm256_setzero_si256();
+
+    unsigned len16 = len >> 4;
+    while (len16) {
+        // 32-bit lane sums are folded into 64 bits before they can overflow
+        unsigned block = (len16 > 16384 ? 16384 : len16);
+        len16 -= block;
+
+        __m256i mag_sum_32 = _mm256_setzero_si256();
+        while (block--) {
+            __m256i mag_u16 = _mm256_loadu_si256((const __m256i *) in_align);
+            __m256i mag_0 = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(mag_u16));
+            __m256i mag_1 = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(mag_u16, 1));
+
+            mag_sum_32 = _mm256_add_epi32(mag_sum_32, _mm256_add_epi32(mag_0, mag_1));
+
+            // squares are up to 32 bits wide, accumulate even and odd lanes as 64 bits
+            magsq_sum_64 = _mm256_add_epi64(magsq_sum_64, _mm256_mul_epu32(mag_0, mag_0));
+            magsq_sum_64 = _mm256_add_epi64(magsq_sum_64, _mm256_mul_epu32(mag_1, mag_1));
+            mag_0 = _mm256_srli_epi64(mag_0, 32);
+            mag_1 = _mm256_srli_epi64(mag_1, 32);
+            magsq_sum_64 = _mm256_add_epi64(magsq_sum_64, _mm256_mul_epu32(mag_0, mag_0));
+            magsq_sum_64 = _mm256_add_epi64(magsq_sum_64, _mm256_mul_epu32(mag_1, mag_1));
+
+            in_align += 16;
+        }
+
+        mag_sum_64 = _mm256_add_epi64(mag_sum_64, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(mag_sum_32)));
+        mag_sum_64 = _mm256_add_epi64(mag_sum_64, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(mag_sum_32, 1)));
+    }
+
+    // reduce sums to a single lane
+    __m128i mag_sum = _mm_add_epi64(_mm256_castsi256_si128(mag_sum_64), _mm256_extracti128_si256(mag_sum_64, 1));
+    __m128i magsq_sum = _mm_add_epi64(_mm256_castsi256_si128(magsq_sum_64), _mm256_extracti128_si256(magsq_sum_64, 1));
+
+    uint64_t sum = (uint64_t) _mm_cvtsi128_si64(mag_sum) + (uint64_t) _mm_extract_epi64(mag_sum, 1);
+    uint64_t sumsq = (uint64_t) _mm_cvtsi128_si64(magsq_sum) + (uint64_t) _mm_extract_epi64(magsq_sum, 1);
+
+    unsigned len1 = len & 15;
+    while (len1--) {
+        uint16_t mag = in_align[0];
+        sum += mag;
+        sumsq += (uint32_t)mag * mag;
+        in_align += 1;
+    }
+
+    *out_mean_mag = (double)sum / len / 65536.0;
+    *out_mean_magsq = (double)sumsq / len / 65536.0 / 65536.0;
+}
+
+#endif /* STARCH_FEATURE_AVX2 */
+
 #endif /* RASPBERRY_PI */
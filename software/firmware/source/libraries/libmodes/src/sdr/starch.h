@@ -29,6 +29,7 @@
 /* x64 */
 #ifdef STARCH_MIX_X86
 #define STARCH_FLAVOR_X86_AVX2
+#define STARCH_FLAVOR_X86_SSE41
 #define STARCH_FLAVOR_GENERIC
 #define STARCH_MIX_ALIGNMENT 32
 #endif /* STARCH_MIX_X86 */
@@ -356,18 +357,24 @@ void starch_mean_power_u16_u32_x86_avx2 ( const uint16_t * arg0, unsigned arg1,
 void starch_mean_power_u16_aligned_u32_x86_avx2 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
 void starch_mean_power_u16_u64_x86_avx2 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
 void starch_mean_power_u16_aligned_u64_x86_avx2 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_mean_power_u16_avx2_x86_avx2 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_mean_power_u16_aligned_avx2_x86_avx2 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
 void starch_magnitude_power_uc8_twopass_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
 void starch_magnitude_power_uc8_aligned_twopass_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
 void starch_magnitude_power_uc8_lookup_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
 void starch_magnitude_power_uc8_aligned_lookup_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
 void starch_magnitude_power_uc8_lookup_unroll_4_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
 void starch_magnitude_power_uc8_aligned_lookup_unroll_4_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_power_uc8_avx2_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_power_uc8_aligned_avx2_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
 void starch_magnitude_uc8_lookup_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_uc8_aligned_lookup_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_uc8_lookup_unroll_4_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_uc8_aligned_lookup_unroll_4_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_uc8_exact_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_uc8_aligned_exact_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_uc8_avx2_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_uc8_aligned_avx2_x86_avx2 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_sc16q11_exact_u32_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_sc16q11_aligned_exact_u32_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_sc16q11_exact_float_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
@@ -378,11 +385,63 @@ void starch_magnitude_sc16q11_12bit_table_x86_avx2 ( const sc16_t * arg0, uint16
 void starch_magnitude_sc16q11_aligned_12bit_table_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_count_above_u16_generic_x86_avx2 ( const uint16_t * arg0, unsigned arg1, uint16_t arg2, unsigned * arg3 );
 void starch_count_above_u16_aligned_generic_x86_avx2 ( const uint16_t * arg0, unsigned arg1, uint16_t arg2, unsigned * arg3 );
+void starch_count_above_u16_avx2_x86_avx2 ( const uint16_t * arg0, unsigned arg1, uint16_t arg2, unsigned * arg3 );
+void starch_count_above_u16_aligned_avx2_x86_avx2 ( const uint16_t * arg0, unsigned arg1, uint16_t arg2, unsigned * arg3 );
 void starch_magnitude_sc16_exact_u32_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_sc16_aligned_exact_u32_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_sc16_exact_float_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
 void starch_magnitude_sc16_aligned_exact_float_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16_avx2_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16_aligned_avx2_x86_avx2 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
 #endif /* STARCH_FLAVOR_X86_AVX2 */
 
 int starch_read_wisdom (const char * path);
 
+#ifdef STARCH_FLAVOR_X86_SSE41
+int cpu_supports_sse41 (void);
+void starch_mean_power_u16_float_x86_sse41 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_mean_power_u16_aligned_float_x86_sse41 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_mean_power_u16_u32_x86_sse41 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_mean_power_u16_aligned_u32_x86_sse41 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_mean_power_u16_u64_x86_sse41 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_mean_power_u16_aligned_u64_x86_sse41 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_mean_power_u16_sse41_x86_sse41 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_mean_power_u16_aligned_sse41_x86_sse41 ( const uint16_t * arg0, unsigned arg1, double * arg2, double * arg3 );
+void starch_magnitude_power_uc8_twopass_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_power_uc8_aligned_twopass_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_power_uc8_lookup_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_power_uc8_aligned_lookup_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_power_uc8_lookup_unroll_4_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_power_uc8_aligned_lookup_unroll_4_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_power_uc8_sse41_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_power_uc8_aligned_sse41_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2, double * arg3, double * arg4 );
+void starch_magnitude_uc8_lookup_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_uc8_aligned_lookup_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_uc8_lookup_unroll_4_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_uc8_aligned_lookup_unroll_4_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_uc8_exact_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_uc8_aligned_exact_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_uc8_sse41_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_uc8_aligned_sse41_x86_sse41 ( const uc8_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16q11_exact_u32_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16q11_aligned_exact_u32_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16q11_exact_float_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16q11_aligned_exact_float_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16q11_11bit_table_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16q11_aligned_11bit_table_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16q11_12bit_table_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16q11_aligned_12bit_table_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_count_above_u16_generic_x86_sse41 ( const uint16_t * arg0, unsigned arg1, uint16_t arg2, unsigned * arg3 );
+void starch_count_above_u16_aligned_generic_x86_sse41 ( const uint16_t * arg0, unsigned arg1, uint16_t arg2, unsigned * arg3 );
+void starch_count_above_u16_sse41_x86_sse41 ( const uint16_t * arg0, unsigned arg1, uint16_t arg2, unsigned * arg3 );
+void starch_count_above_u16_aligned_sse41_x86_sse41 ( const uint16_t * arg0, unsigned arg1, uint16_t arg2, unsigned * arg3 );
+void starch_magnitude_sc16_exact_u32_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16_aligned_exact_u32_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16_exact_float_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16_aligned_exact_float_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16_sse41_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+void starch_magnitude_sc16_aligned_sse41_x86_sse41 ( const sc16_t * arg0, uint16_t * arg1, unsigned arg2 );
+#endif /* STARCH_FLAVOR_X86_SSE41 */
+
+int starch_read_wisdom (const char * path);
+